@@ -0,0 +1,293 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <format>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <arpa/inet.h>
+
+#include <jhoyt/asl/address.hpp>
+#include <jhoyt/asl/address_filter.hpp>
+#include <jhoyt/asl/address_map.hpp>
+#include <jhoyt/asl/raw_address.hpp>
+
+#include "benchmarks.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    struct address_case
+    {
+        const char* name;
+        address addr;
+    };
+
+    /// Typical addresses of each type. The hosts use most of the text form, so inet_pton and inet_ntop do a realistic
+    /// amount of work (and the strings do not fit in the small string buffer).
+    const auto k_address_cases = std::array<address_case, 3>{{
+        {"ipv4", ipv4_address{.host = "192.168.100.200", .port = 5555}},
+        {"ipv6", ipv6_address{.host = "2001:db8:85a3::8a2e:370:7334", .port = 5555}},
+        {"file", file_address{.path = "/var/run/asl/benchmark.sock"}},
+    }};
+
+    std::string make_name(const char* operation, const address_case& c)
+    {
+        return std::string{operation} + ", " + c.name;
+    }
+
+    /// Number of hosts in the lists that the parsing benchmarks cycle through, like the entries of an allowlist.
+    constexpr auto k_host_list_size = std::size_t{1024};
+
+    /// A list of random hosts, so field lengths vary from host to host as they do in real lists.
+    template <typename Host>
+    std::vector<std::string> make_host_list()
+    {
+        auto rng = std::mt19937{1};
+        auto result = std::vector<std::string>{};
+        for (auto ix = std::size_t{0}; ix < k_host_list_size; ++ix)
+        {
+            auto bytes = typename Host::bytes_type{};
+            for (auto& b : bytes)
+            {
+                b = static_cast<std::uint8_t>(rng() % 4 == 0 ? 0 : rng());
+            }
+
+            result.push_back(std::format("{}", Host{bytes}));
+        }
+
+        return result;
+    }
+
+    void run_parsing_benchmarks(ankerl::nanobench::Bench& bench)
+    {
+        bench::begin_group(bench, "address: parsing").unit("host");
+
+        const auto ipv4_list = make_host_list<ipv4_host>();
+        const auto ipv6_list = make_host_list<ipv6_host>();
+        auto ix = std::size_t{0};
+
+        // The text has to be NUL-terminated for inet_pton, which these strings already are.
+        bench.run("inet_pton, ipv4", [&] {
+            const auto& text = ipv4_list[ix++ % k_host_list_size];
+            auto bytes = ipv4_host::bytes_type{};
+            ankerl::nanobench::doNotOptimizeAway(inet_pton(AF_INET, text.c_str(), &bytes));
+            ankerl::nanobench::doNotOptimizeAway(bytes);
+        });
+
+        bench.run("ipv4_host(string_view)", [&] {
+            ankerl::nanobench::doNotOptimizeAway(ipv4_host{std::string_view{ipv4_list[ix++ % k_host_list_size]}});
+        });
+
+        // A whole list per iteration, through the vector path.
+        const auto views = std::vector<std::string_view>{ipv4_list.begin(), ipv4_list.end()};
+        auto hosts = std::vector<ipv4_host>(views.size());
+        bench.batch(k_host_list_size).run("parse_ipv4_hosts", [&] {
+            ankerl::nanobench::doNotOptimizeAway(parse_ipv4_hosts(views, hosts));
+        });
+        bench.batch(1);
+
+        bench.run("inet_pton, ipv6", [&] {
+            const auto& text = ipv6_list[ix++ % k_host_list_size];
+            auto bytes = ipv6_host::bytes_type{};
+            ankerl::nanobench::doNotOptimizeAway(inet_pton(AF_INET6, text.c_str(), &bytes));
+            ankerl::nanobench::doNotOptimizeAway(bytes);
+        });
+
+        bench.run("ipv6_host(string_view)", [&] {
+            ankerl::nanobench::doNotOptimizeAway(ipv6_host{std::string_view{ipv6_list[ix++ % k_host_list_size]}});
+        });
+    }
+
+    /// Number of distinct peers in the peer map benchmarks, about what a busy server sees within a rate limit window.
+    constexpr auto k_peer_count = std::size_t{10000};
+
+    void run_peer_map_benchmarks(ankerl::nanobench::Bench& bench)
+    {
+        bench::begin_group(bench, "address: peer map").unit("lookup");
+
+        // Peers as they come out of accept, visited in a random order so lookups do not follow the table layout.
+        auto rng = std::mt19937{2};
+        auto peers = std::vector<raw_address>{};
+        for (auto ix = std::size_t{0}; ix < k_peer_count; ++ix)
+        {
+            const auto host = static_cast<std::uint32_t>(rng());
+            const auto bytes = ipv4_host::bytes_type{
+                10, static_cast<std::uint8_t>(host >> 16), static_cast<std::uint8_t>(host >> 8),
+                static_cast<std::uint8_t>(host)};
+            peers.emplace_back(ipv4_address{.host = ipv4_host{bytes}, .port = static_cast<std::uint16_t>(host >> 24)});
+        }
+
+        auto order = std::vector<std::size_t>(k_peer_count);
+        for (auto ix = std::size_t{0}; ix < order.size(); ++ix)
+        {
+            order[ix] = static_cast<std::size_t>(rng()) % k_peer_count;
+        }
+
+        // Each case counts requests per peer, the core of a rate limiter.
+        auto ix = std::size_t{0};
+
+        auto string_map = std::unordered_map<std::string, std::uint64_t>{};
+        for (const auto& peer : peers)
+        {
+            string_map[to_string(peer)] = 0;
+        }
+
+        bench.run("unordered_map<string>, to_string key", [&] {
+            ++string_map[to_string(peers[order[ix++ % k_peer_count]])];
+        });
+
+        auto raw_map = std::unordered_map<raw_address, std::uint64_t>{};
+        for (const auto& peer : peers)
+        {
+            raw_map[peer] = 0;
+        }
+
+        bench.run("unordered_map<raw_address>", [&] { ++raw_map[peers[order[ix++ % k_peer_count]]]; });
+
+        auto flat_map = address_map<std::uint64_t>{k_peer_count};
+        for (const auto& peer : peers)
+        {
+            flat_map[peer] = 0;
+        }
+
+        bench.run("address_map", [&] { ++flat_map[peers[order[ix++ % k_peer_count]]]; });
+
+        ankerl::nanobench::doNotOptimizeAway(string_map);
+        ankerl::nanobench::doNotOptimizeAway(raw_map);
+        ankerl::nanobench::doNotOptimizeAway(flat_map);
+    }
+
+    /// Number of rules in the accept filter benchmarks, about the size of a blocklist fed from threat intelligence.
+    constexpr auto k_rule_count = std::size_t{10000};
+
+    void run_accept_filter_benchmarks(ankerl::nanobench::Bench& bench)
+    {
+        bench::begin_group(bench, "address: accept filter").unit("peer");
+
+        // Networks of /16 to /32 spread over the whole IPv4 space, and peers of which about half are in one of them.
+        auto rng = std::mt19937{3};
+        auto rules = std::vector<cidr_rule>{};
+        auto blocked = std::unordered_set<std::string>{};
+        for (auto ix = std::size_t{0}; ix < k_rule_count; ++ix)
+        {
+            const auto host = static_cast<std::uint32_t>(rng());
+            const auto bytes = ipv4_host::bytes_type{static_cast<std::uint8_t>(host >> 24),
+                                                     static_cast<std::uint8_t>(host >> 16),
+                                                     static_cast<std::uint8_t>(host >> 8),
+                                                     static_cast<std::uint8_t>(host)};
+            rules.push_back({ipv4_host{bytes}, static_cast<std::uint8_t>(16 + rng() % 17), filter_action::deny});
+
+            const auto text = to_string(raw_address{ipv4_address{.host = ipv4_host{bytes}, .port = 0}});
+            blocked.emplace(text.substr(7, text.rfind(':') - 7));
+        }
+
+        auto peers = std::vector<raw_address>{};
+        for (auto ix = std::size_t{0}; ix < k_peer_count; ++ix)
+        {
+            auto bytes = ipv4_host::bytes_type{};
+            if (ix % 2 == 0)
+            {
+                bytes = std::get<ipv4_host>(rules[rng() % rules.size()].network).get_bytes();
+                bytes[3] = static_cast<std::uint8_t>(rng());
+            }
+            else
+            {
+                const auto host = static_cast<std::uint32_t>(rng());
+                bytes = {static_cast<std::uint8_t>(host >> 24), static_cast<std::uint8_t>(host >> 16),
+                         static_cast<std::uint8_t>(host >> 8), static_cast<std::uint8_t>(host)};
+            }
+
+            peers.emplace_back(ipv4_address{.host = ipv4_host{bytes}, .port = 40000});
+        }
+
+        auto ix = std::size_t{0};
+
+        // The old way: format the peer and look its host text up in a set, which only handles single hosts.
+        bench.run("to_string + unordered_set<string>", [&] {
+            const auto text = to_string(peers[ix++ % k_peer_count]);
+            ankerl::nanobench::doNotOptimizeAway(blocked.contains(text.substr(7, text.rfind(':') - 7)));
+        });
+
+        const auto table = cidr_table{rules};
+        bench.run("cidr_table::lookup", [&] {
+            ankerl::nanobench::doNotOptimizeAway(table.lookup(peers[ix++ % k_peer_count]));
+        });
+
+        // The same through the swappable filter, which adds the reader registration.
+        const auto filter = address_filter{table};
+        bench.run("address_filter::is_allowed", [&] {
+            ankerl::nanobench::doNotOptimizeAway(filter.is_allowed(peers[ix++ % k_peer_count]));
+        });
+    }
+
+} // namespace
+
+namespace jhoyt::asl::bench
+{
+
+    void run_address_benchmarks(ankerl::nanobench::Bench& bench)
+    {
+        begin_group(bench, "address: conversions").unit("address");
+
+        for (const auto& c : k_address_cases)
+        {
+            // The path taken for every bind and connect.
+            bench.run(make_name("raw_address(address)", c), [&] {
+                auto raw = raw_address{c.addr};
+                ankerl::nanobench::doNotOptimizeAway(raw);
+            });
+        }
+
+        for (const auto& c : k_address_cases)
+        {
+            // The path taken for every accept, which validates the bytes filled in by the OS.
+            const auto source = raw_address{c.addr};
+            bench.run(make_name("raw_address(span)", c), [&] {
+                auto raw = raw_address{source.get_data()};
+                ankerl::nanobench::doNotOptimizeAway(raw);
+            });
+        }
+
+        for (const auto& c : k_address_cases)
+        {
+            const auto raw = raw_address{c.addr};
+            bench.run(make_name("get_address", c), [&] { ankerl::nanobench::doNotOptimizeAway(raw.get_address()); });
+        }
+
+        for (const auto& c : k_address_cases)
+        {
+            bench.run(make_name("to_string(address)", c),
+                      [&] { ankerl::nanobench::doNotOptimizeAway(to_string(c.addr)); });
+        }
+
+        for (const auto& c : k_address_cases)
+        {
+            // What logging an accepted connection costs: get_address followed by formatting.
+            const auto raw = raw_address{c.addr};
+            bench.run(make_name("to_string(raw_address)", c),
+                      [&] { ankerl::nanobench::doNotOptimizeAway(to_string(raw)); });
+        }
+
+        for (const auto& c : k_address_cases)
+        {
+            // The same without allocating, through the formatter into a fixed buffer.
+            const auto raw = raw_address{c.addr};
+            auto buf = std::array<char, raw_address::k_max_string_size>{};
+            bench.run(make_name("format_to_n(raw_address)", c), [&] {
+                ankerl::nanobench::doNotOptimizeAway(std::format_to_n(buf.data(), buf.size(), "{}", raw).size);
+            });
+        }
+
+        run_parsing_benchmarks(bench);
+        run_peer_map_benchmarks(bench);
+        run_accept_filter_benchmarks(bench);
+    }
+
+} // namespace jhoyt::asl::bench
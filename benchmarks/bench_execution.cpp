@@ -0,0 +1,115 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+
+#include <jhoyt/asl/event_loop.hpp>
+#include <jhoyt/asl/execution.hpp>
+#include <jhoyt/asl/poller.hpp>
+
+#include "bench_util.hpp"
+#include "benchmarks.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    constexpr auto k_port = std::uint16_t{bench::k_base_port + 30};
+
+    /// Receiver that records completion of a sender; any error aborts the benchmark.
+    struct flag_receiver
+    {
+        using receiver_concept = stdexec::receiver_t;
+
+        bool* done;
+
+        void set_value(auto&&...) && noexcept
+        {
+            *done = true;
+        }
+
+        void set_error(std::exception_ptr) && noexcept
+        {
+            std::terminate();
+        }
+
+        void set_stopped() && noexcept
+        {
+            std::terminate();
+        }
+    };
+
+    template <typename Sender>
+    void run_sender(event_loop& loop, Sender&& sender)
+    {
+        auto done = false;
+        auto op = stdexec::connect(std::forward<Sender>(sender), flag_receiver{&done});
+        stdexec::start(op);
+        while (!done)
+        {
+            loop.run_once(std::chrono::seconds{1});
+        }
+    }
+
+    /// One byte round trip driven by a poller and the plain non-blocking socket functions.
+    void run_poller_ping_pong(ankerl::nanobench::Bench& bench)
+    {
+        auto client = jhoyt::asl::socket{};
+        auto server = jhoyt::asl::socket{};
+        bench::make_connected_pair(k_port, client, server);
+        auto p = poller{};
+        p.add_socket(client.get_id(), poller::poll_type::read);
+        p.add_socket(server.get_id(), poller::poll_type::read);
+
+        auto byte = std::array<char, 1>{'x'};
+        const auto wait_and_recv = [&](jhoyt::asl::socket& sock) {
+            while (sock.recv(byte).first == jhoyt::asl::socket::transfer_status::blocked)
+            {
+                p.poll(std::chrono::seconds{1});
+            }
+        };
+
+        bench.run("poller", [&] {
+            client.send(byte);
+            wait_and_recv(server);
+            server.send(byte);
+            wait_and_recv(client);
+        });
+    }
+
+    /// The same round trip expressed as senders on a loop_scheduler.
+    void run_sender_ping_pong(ankerl::nanobench::Bench& bench)
+    {
+        auto client = jhoyt::asl::socket{};
+        auto server = jhoyt::asl::socket{};
+        bench::make_connected_pair(k_port + 1, client, server);
+        auto loop = event_loop{};
+        const auto scheduler = loop_scheduler{loop};
+
+        auto byte = std::array<char, 1>{'x'};
+        bench.run("loop_scheduler senders", [&] {
+            run_sender(loop, scheduler.send(client, byte));
+            run_sender(loop, scheduler.recv(server, byte));
+            run_sender(loop, scheduler.send(server, byte));
+            run_sender(loop, scheduler.recv(client, byte));
+        });
+    }
+
+} // namespace
+
+namespace jhoyt::asl::bench
+{
+
+    void run_execution_benchmarks(ankerl::nanobench::Bench& bench)
+    {
+        begin_group(bench, "execution: 1 byte loopback round trip").unit("round trip").batch(1);
+
+        run_poller_ping_pong(bench);
+        run_sender_ping_pong(bench);
+    }
+
+} // namespace jhoyt::asl::bench
@@ -0,0 +1,70 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cstring>
+#include <string_view>
+
+#include <jhoyt/asl/framer.hpp>
+#include <jhoyt/asl/recv_buffer.hpp>
+
+#include "benchmarks.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    constexpr auto k_frames_per_batch = std::size_t{1024};
+    constexpr auto k_payload = std::string_view{"small message payload (32 bytes)"};
+
+    /// Fill a receive buffer with a batch of identical small frames, as if they had arrived in one recv call.
+    template <typename Header>
+    recv_buffer make_batch()
+    {
+        auto buf = recv_buffer{k_frames_per_batch * (Header::k_max_size + k_payload.size())};
+        for (auto ix = std::size_t{0}; ix < k_frames_per_batch; ++ix)
+        {
+            auto out = buf.get_writable(Header::k_max_size + k_payload.size());
+            const auto header_size = framer<Header>::encode_header(k_payload.size(), out);
+            memcpy(out.data() + header_size, k_payload.data(), k_payload.size());
+            buf.commit(header_size + k_payload.size());
+        }
+
+        return buf;
+    }
+
+    template <typename Header>
+    void run_framer_benchmark(ankerl::nanobench::Bench& bench, const char* name)
+    {
+        const auto batch = make_batch<Header>();
+        const auto framer = jhoyt::asl::framer<Header>{};
+
+        bench.batch(k_frames_per_batch).unit("frame").run(name, [&] {
+            auto data = batch.get_readable();
+            auto total = std::size_t{0};
+            for (auto result = framer.next(data); result.status == frame_status::complete; result = framer.next(data))
+            {
+                total += result.payload.size();
+                data = data.subspan(result.size);
+            }
+
+            ankerl::nanobench::doNotOptimizeAway(total);
+        });
+    }
+
+} // namespace
+
+namespace jhoyt::asl::bench
+{
+
+    void run_framer_benchmarks(ankerl::nanobench::Bench& bench)
+    {
+        begin_group(bench, "framer: small messages");
+
+        run_framer_benchmark<varint_header>(bench, "varint");
+        run_framer_benchmark<u16_be_header>(bench, "u16 big endian");
+        run_framer_benchmark<u16_le_header>(bench, "u16 little endian");
+        run_framer_benchmark<u32_be_header>(bench, "u32 big endian");
+        run_framer_benchmark<u32_le_header>(bench, "u32 little endian");
+    }
+
+} // namespace jhoyt::asl::bench
@@ -0,0 +1,68 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "benchmarks.hpp"
+
+/// Runs every benchmark and prints a table per benchmark group. With `--json <file>` the results of all groups are
+/// also written to the file in nanobench's JSON format, for comparing runs with other tools; the run fails if a group
+/// that was started has no results in it.
+int main(const int argc, char** argv)
+{
+    const char* json_path = nullptr;
+    for (auto ix = 1; ix < argc; ++ix)
+    {
+        if (std::strcmp(argv[ix], "--json") == 0 && ix + 1 < argc)
+        {
+            json_path = argv[++ix];
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--json <file>]\n";
+            return 1;
+        }
+    }
+
+    auto bench = ankerl::nanobench::Bench{};
+    bench.warmup(100).minEpochIterations(1000);
+
+    jhoyt::asl::bench::run_address_benchmarks(bench);
+    jhoyt::asl::bench::run_framer_benchmarks(bench);
+    jhoyt::asl::bench::run_runtime_benchmarks(bench);
+    jhoyt::asl::bench::run_network_benchmarks(bench);
+#if defined(ASL_BENCH_EXECUTION)
+    jhoyt::asl::bench::run_execution_benchmarks(bench);
+#endif
+
+    jhoyt::asl::bench::end_group(bench);
+
+    if (json_path)
+    {
+        const auto& kept = jhoyt::asl::bench::get_group_results();
+        for (const auto& title : kept.titles)
+        {
+            const auto has_results = std::any_of(kept.results.begin(), kept.results.end(), [&](const auto& result) {
+                return result.config().mBenchmarkTitle == title;
+            });
+            if (!has_results)
+            {
+                std::cerr << "no results for benchmark group \"" << title << "\"\n";
+                return 1;
+            }
+        }
+
+        auto out = std::ofstream{json_path};
+        ankerl::nanobench::render(ankerl::nanobench::templates::json(), kept.results, out);
+        if (!out)
+        {
+            std::cerr << "failed to write " << json_path << "\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,367 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <netdb.h>
+#endif
+
+#include <jhoyt/asl/connection_pool.hpp>
+#include <jhoyt/asl/event_loop.hpp>
+#include <jhoyt/asl/poller.hpp>
+#include <jhoyt/asl/resolver.hpp>
+#include <jhoyt/asl/socket.hpp>
+
+#include "bench_util.hpp"
+#include "benchmarks.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    constexpr auto k_echo_port = std::uint16_t{bench::k_base_port + 200};
+    constexpr auto k_latency_port = std::uint16_t{bench::k_base_port + 201};
+    constexpr auto k_connect_port = std::uint16_t{bench::k_base_port + 202};
+    constexpr auto k_idle_port = std::uint16_t{bench::k_base_port + 203};
+    constexpr auto k_nameserver_port = std::uint16_t{bench::k_base_port + 204};
+    constexpr auto k_pool_port = std::uint16_t{bench::k_base_port + 205};
+
+    constexpr auto k_echo_chunk_size = std::size_t{16 * 1024};
+    constexpr auto k_latency_message_size = std::size_t{64};
+
+    /// Idle socket counts for the poll cost benchmark. Each idle connection uses two descriptors, so the largest count
+    /// stays below the common default limit of 1024 open files.
+    constexpr auto k_idle_counts = std::array<std::size_t, 5>{0, 16, 64, 128, 384};
+
+    /// The poll() backend is benchmarked in both threading modes, as a thread-safe poller also polls its notifier.
+    constexpr auto k_threading_modes = std::array<poller::threading_mode, 2>{
+        poller::threading_mode::single_thread,
+        poller::threading_mode::thread_safe,
+    };
+
+    const char* get_mode_name(const poller::threading_mode mode)
+    {
+        return mode == poller::threading_mode::single_thread ? "single_thread" : "thread_safe";
+    }
+
+    /// Send all of the data. The benchmarks send less than a loopback socket buffer holds, so this never waits.
+    void send_all(jhoyt::asl::socket& sock, std::span<const char> data)
+    {
+        while (!data.empty())
+        {
+            const auto [status, count] = sock.send(data);
+            if (status == jhoyt::asl::socket::transfer_status::disconnected)
+            {
+                throw std::runtime_error{"benchmark connection closed while sending"};
+            }
+
+            data = data.subspan(count);
+        }
+    }
+
+    /// Receive exactly enough bytes to fill the buffer, waiting on the poller whenever the socket has nothing to read.
+    void recv_all(poller& p, jhoyt::asl::socket& sock, std::span<char> data)
+    {
+        while (!data.empty())
+        {
+            const auto [status, count] = sock.recv(data);
+            if (status == jhoyt::asl::socket::transfer_status::blocked)
+            {
+                p.poll(std::chrono::seconds{1});
+                continue;
+            }
+
+            if (status == jhoyt::asl::socket::transfer_status::disconnected)
+            {
+                throw std::runtime_error{"benchmark connection closed while receiving"};
+            }
+
+            data = data.subspan(count);
+        }
+    }
+
+    /// A chunk is sent by the client, received and echoed by the server, and received back by the client.
+    void run_echo_throughput(ankerl::nanobench::Bench& bench, const poller::threading_mode mode)
+    {
+        auto client = jhoyt::asl::socket{};
+        auto server = jhoyt::asl::socket{};
+        bench::make_connected_pair(k_echo_port, client, server);
+
+        auto p = poller{mode};
+        p.add_socket(client.get_id(), poller::poll_type::read);
+        p.add_socket(server.get_id(), poller::poll_type::read);
+
+        auto out = std::vector<char>(k_echo_chunk_size, 'x');
+        auto in = std::vector<char>(k_echo_chunk_size);
+        bench.batch(2 * k_echo_chunk_size).run(std::string{"echo throughput, "} + get_mode_name(mode), [&] {
+            send_all(client, out);
+            recv_all(p, server, in);
+            send_all(server, in);
+            recv_all(p, client, in);
+        });
+    }
+
+    /// Round trip of a small message on an established connection.
+    void run_round_trip_latency(ankerl::nanobench::Bench& bench, const poller::threading_mode mode)
+    {
+        auto client = jhoyt::asl::socket{};
+        auto server = jhoyt::asl::socket{};
+        bench::make_connected_pair(k_latency_port, client, server);
+
+        auto p = poller{mode};
+        p.add_socket(client.get_id(), poller::poll_type::read);
+        p.add_socket(server.get_id(), poller::poll_type::read);
+
+        auto msg = std::array<char, k_latency_message_size>{};
+        bench.batch(1).run(std::string{"round trip latency, "} + get_mode_name(mode), [&] {
+            send_all(client, msg);
+            recv_all(p, server, msg);
+            send_all(server, msg);
+            recv_all(p, client, msg);
+        });
+    }
+
+    /// Open a connection, accept it and close both ends. The server end is closed first so that TIME_WAIT is kept on
+    /// the listener's side rather than using up ephemeral ports.
+    void run_connection_rate(ankerl::nanobench::Bench& bench, const poller::threading_mode mode)
+    {
+        auto listener = jhoyt::asl::socket{};
+        bench::make_listener(listener, k_connect_port);
+
+        auto p = poller{mode};
+        p.add_socket(listener.get_id(), poller::poll_type::read);
+
+        const auto address = bench::make_loopback_address(k_connect_port);
+        auto server_address = raw_address{};
+        bench.batch(1).run(std::string{"connections, "} + get_mode_name(mode), [&] {
+            auto client = jhoyt::asl::socket{};
+            client.open(socket_domain::ipv4, socket_type::stream);
+            client.connect(address);
+
+            auto server = jhoyt::asl::socket{};
+            while (!listener.accept(server, server_address))
+            {
+                p.poll(std::chrono::seconds{1});
+            }
+
+            server.close();
+            client.close();
+        });
+    }
+
+    /// Cost of a poll that returns nothing while a number of connected but idle sockets are registered.
+    void run_idle_poll_cost(ankerl::nanobench::Bench& bench, const poller::threading_mode mode)
+    {
+        for (const auto idle_count : k_idle_counts)
+        {
+            auto listener = jhoyt::asl::socket{};
+            bench::make_listener(listener, k_idle_port, static_cast<int>(idle_count) + 1);
+
+            auto clients = std::vector<jhoyt::asl::socket>(idle_count);
+            auto servers = std::vector<jhoyt::asl::socket>(idle_count);
+            auto server_address = raw_address{};
+            for (auto ix = std::size_t{0}; ix < idle_count; ++ix)
+            {
+                clients[ix].open(socket_domain::ipv4, socket_type::stream);
+                clients[ix].connect(bench::make_loopback_address(k_idle_port));
+
+                // Loopback connections are established straight away, so the accept only has to be retried briefly.
+                while (!listener.accept(servers[ix], server_address))
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            auto p = poller{mode};
+            for (const auto& server : servers)
+            {
+                p.add_socket(server.get_id(), poller::poll_type::read);
+            }
+
+            const auto name = std::string{get_mode_name(mode)} + ", " + std::to_string(idle_count) + " idle";
+            bench.batch(1).run(name, [&] { ankerl::nanobench::doNotOptimizeAway(p.poll(std::chrono::seconds{0})); });
+        }
+    }
+
+    /// A nameserver that answers every A query with 192.0.2.1 and a TTL of an hour.
+    struct stub_nameserver
+    {
+        jhoyt::asl::socket sock;
+
+        void on_poll(socket_id, poller::poll_status)
+        {
+            auto buf = std::array<char, 512>{};
+            auto from = raw_address{};
+            for (auto result = sock.recv_from(buf, from); result.first == jhoyt::asl::socket::transfer_status::success;
+                 result = sock.recv_from(buf, from))
+            {
+                auto response = std::string{buf.data(), result.second};
+                response[2] = '\x81';
+                response[3] = '\x80';
+                response[7] = '\x01';
+                response.append("\xc0\x0c\x00\x01\x00\x01\x00\x00\x0e\x10\x00\x04\xc0\x00\x02\x01", 16);
+                sock.send_to(response, from);
+            }
+        }
+    };
+
+    struct counting_request : resolve_request
+    {
+        std::size_t completed = 0;
+    };
+
+    /// Lookups that miss the cache and make a round trip to a nameserver on the same event loop, lookups that hit the
+    /// cache, and, for comparison, a blocking getaddrinfo of a name that is answered from the hosts file.
+    void run_resolver_lookups(ankerl::nanobench::Bench& bench)
+    {
+        auto loop = event_loop{};
+        auto stub = stub_nameserver{};
+        stub.sock.open(socket_domain::ipv4, socket_type::datagram);
+        stub.sock.bind(bench::make_loopback_address(k_nameserver_port));
+        loop.add_socket(stub.sock.get_id(), poller::poll_type::read, stub);
+
+        auto names = resolver{loop,
+                              resolver_options{.nameserver = bench::make_loopback_address(k_nameserver_port),
+                                               .hosts_path = {},
+                                               .query_ipv6 = false}};
+
+        auto request = counting_request{};
+        request.on_resolved = [](resolve_request& self, resolve_status, std::span<const raw_address>) {
+            ++static_cast<counting_request&>(self).completed;
+        };
+
+        bench.run("query to a loopback nameserver", [&] {
+            names.clear_cache();
+            const auto target = request.completed + 1;
+            names.resolve("service.bench", 80, request);
+            while (request.completed < target)
+            {
+                loop.run_once(std::chrono::seconds{1});
+            }
+        });
+
+        bench.run("cached", [&] { names.resolve("service.bench", 80, request); });
+
+#if !defined(_WIN32)
+        bench.run("getaddrinfo from the hosts file", [&] {
+            auto hints = addrinfo{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            auto* result = static_cast<addrinfo*>(nullptr);
+            if (getaddrinfo("localhost", "80", &hints, &result) == 0)
+            {
+                freeaddrinfo(result);
+            }
+        });
+#endif
+
+        loop.remove_socket(stub.sock.get_id());
+    }
+
+    /// A listener that accepts every connection on the event loop and keeps it open.
+    struct accepting_listener
+    {
+        jhoyt::asl::socket sock;
+        std::vector<jhoyt::asl::socket> accepted;
+
+        void on_poll(socket_id, poller::poll_status)
+        {
+            auto incoming = jhoyt::asl::socket{};
+            auto addr = raw_address{};
+            while (sock.accept(incoming, addr))
+            {
+                accepted.push_back(std::move(incoming));
+            }
+        }
+    };
+
+    struct holding_request : checkout_request
+    {
+        pooled_connection connection;
+    };
+
+    /// Checking a warm connection out of a pool and back in, with an iteration of the event loop in between so that
+    /// the idle connection is watched again; compare with the loopback connect, accept and close of a new connection.
+    void run_pool_checkout(ankerl::nanobench::Bench& bench)
+    {
+        auto loop = event_loop{};
+        auto listener = accepting_listener{};
+        bench::make_listener(listener.sock, k_pool_port);
+        loop.add_socket(listener.sock.get_id(), poller::poll_type::read, listener);
+
+        const auto address = bench::make_loopback_address(k_pool_port);
+        auto pool = connection_pool{loop, {.spare_connections = 0}};
+        auto request = holding_request{};
+        request.on_checkout = [](checkout_request& self, pooled_connection connection) {
+            static_cast<holding_request&>(self).connection = std::move(connection);
+        };
+
+        pool.checkout(address, request);
+        while (!request.connection)
+        {
+            loop.run_once(std::chrono::seconds{1});
+        }
+
+        pool.checkin(request.connection);
+        bench.run("warm checkout and checkin", [&] {
+            pool.checkout(address, request);
+            pool.checkin(request.connection);
+            loop.run_once(std::chrono::seconds{0});
+        });
+
+        loop.remove_socket(listener.sock.get_id());
+    }
+
+} // namespace
+
+namespace jhoyt::asl::bench
+{
+
+    void run_network_benchmarks(ankerl::nanobench::Bench& bench)
+    {
+        begin_group(bench, "network: loopback echo throughput").unit("byte").minEpochIterations(100);
+        for (const auto mode : k_threading_modes)
+        {
+            run_echo_throughput(bench, mode);
+        }
+
+        begin_group(bench, "network: 64 byte loopback round trips").unit("round trip").minEpochIterations(1000);
+        for (const auto mode : k_threading_modes)
+        {
+            run_round_trip_latency(bench, mode);
+        }
+
+        // Every connection leaves a socket in TIME_WAIT, so the number of iterations is kept fixed and small.
+        begin_group(bench, "network: loopback connect, accept and close")
+            .unit("connection")
+            .epochs(10)
+            .epochIterations(100);
+        for (const auto mode : k_threading_modes)
+        {
+            run_connection_rate(bench, mode);
+        }
+
+        // Go back to the default (automatic) number of epochs and iterations.
+        begin_group(bench, "poller: poll(0) with idle registered sockets").unit("poll").epochs(11).epochIterations(0);
+        bench.minEpochIterations(1000);
+        for (const auto mode : k_threading_modes)
+        {
+            run_idle_poll_cost(bench, mode);
+        }
+
+        begin_group(bench, "resolver: name lookups").unit("lookup");
+        run_resolver_lookups(bench);
+
+        begin_group(bench, "connection pool: checkouts").unit("checkout");
+        run_pool_checkout(bench);
+    }
+
+} // namespace jhoyt::asl::bench
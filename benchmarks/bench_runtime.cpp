@@ -0,0 +1,109 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <jhoyt/asl/runtime.hpp>
+#include <jhoyt/asl/task.hpp>
+
+#include "bench_util.hpp"
+#include "benchmarks.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    constexpr auto k_port = std::uint16_t{bench::k_base_port + 100};
+    constexpr auto k_round_trips_per_batch = std::size_t{1000};
+
+    /// A connected loopback pair that lives on one worker; both ends are only ever used by that worker's thread.
+    struct echo_pair : posted_task
+    {
+        jhoyt::asl::socket client;
+        jhoyt::asl::socket server;
+        std::atomic<std::size_t>* remaining = nullptr;
+    };
+
+    task<> run_round_trips(event_loop& loop, echo_pair& pair)
+    {
+        auto byte = std::array<char, 1>{'x'};
+        for (auto ix = std::size_t{0}; ix < k_round_trips_per_batch; ++ix)
+        {
+            co_await loop.async_send(pair.client, byte);
+            co_await loop.async_recv(pair.server, byte);
+            co_await loop.async_send(pair.server, byte);
+            co_await loop.async_recv(pair.client, byte);
+        }
+
+        pair.remaining->fetch_sub(1, std::memory_order_release);
+    }
+
+    void start_round_trips(posted_task& self)
+    {
+        auto& pair = static_cast<echo_pair&>(self);
+        spawn(run_round_trips(worker::get_current()->get_loop(), pair));
+    }
+
+    /// Every worker ping-pongs one byte over its own loopback pair, so the aggregate rate should scale with the number
+    /// of workers until the cores (or the loopback device) are saturated.
+    void run_scaling_benchmark(ankerl::nanobench::Bench& bench, const std::size_t worker_count)
+    {
+        auto rt = runtime{{.worker_count = worker_count}};
+
+        auto pairs = std::vector<std::unique_ptr<echo_pair>>{};
+        for (auto ix = std::size_t{0}; ix < worker_count; ++ix)
+        {
+            auto& pair = *pairs.emplace_back(std::make_unique<echo_pair>());
+            pair.run = &start_round_trips;
+            bench::make_connected_pair(static_cast<std::uint16_t>(k_port + ix), pair.client, pair.server);
+        }
+
+        rt.start();
+
+        const auto name = std::to_string(worker_count) + (worker_count == 1 ? " worker" : " workers");
+        bench.batch(worker_count * k_round_trips_per_batch).run(name, [&] {
+            auto remaining = std::atomic<std::size_t>{worker_count};
+            for (auto ix = std::size_t{0}; ix < worker_count; ++ix)
+            {
+                pairs[ix]->remaining = &remaining;
+                rt.post(ix, *pairs[ix]);
+            }
+
+            while (remaining.load(std::memory_order_acquire) > 0)
+            {
+                std::this_thread::yield();
+            }
+        });
+
+        rt.stop();
+    }
+
+} // namespace
+
+namespace jhoyt::asl::bench
+{
+
+    void run_runtime_benchmarks(ankerl::nanobench::Bench& bench)
+    {
+        begin_group(bench, "runtime: 1 byte loopback round trips per worker").unit("round trip").minEpochIterations(10);
+
+        const auto max_workers = std::max(std::thread::hardware_concurrency(), 1u);
+        for (auto count = std::size_t{1}; count <= max_workers; count *= 2)
+        {
+            run_scaling_benchmark(bench, count);
+        }
+
+        if ((max_workers & (max_workers - 1)) != 0)
+        {
+            run_scaling_benchmark(bench, max_workers);
+        }
+    }
+
+} // namespace jhoyt::asl::bench
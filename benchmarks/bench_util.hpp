@@ -0,0 +1,60 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+#include <jhoyt/asl/poller.hpp>
+#include <jhoyt/asl/raw_address.hpp>
+#include <jhoyt/asl/socket.hpp>
+
+namespace jhoyt::asl::bench
+{
+
+    /// Base port for benchmark listeners; each benchmark uses its own offset so sockets left in TIME_WAIT by one
+    /// benchmark do not interfere with the next.
+    constexpr auto k_base_port = std::uint16_t{15555};
+
+    inline raw_address make_loopback_address(const std::uint16_t port)
+    {
+        return raw_address{ipv4_address{.host = "127.0.0.1", .port = port}};
+    }
+
+    /// Open a listening socket on the loopback interface.
+    inline void make_listener(socket& listener, const std::uint16_t port, const int backlog = 128)
+    {
+        listener.open(socket_domain::ipv4, socket_type::stream);
+        listener.set_reuse_address_option(true);
+        listener.bind(make_loopback_address(port));
+        listener.listen(backlog);
+    }
+
+    /// Connect a pair of loopback sockets to each other.
+    inline void make_connected_pair(const std::uint16_t port, socket& client, socket& server)
+    {
+        auto listener = socket{};
+        make_listener(listener, port, 1);
+
+        client.open(socket_domain::ipv4, socket_type::stream);
+        client.connect(make_loopback_address(port));
+
+        auto server_address = raw_address{};
+        auto p = poller{};
+        p.add_socket(listener.get_id(), poller::poll_type::read);
+
+        const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!listener.accept(server, server_address))
+        {
+            if (std::chrono::steady_clock::now() > end_time)
+            {
+                throw std::runtime_error{"timed out creating loopback socket pair"};
+            }
+
+            p.poll(std::chrono::milliseconds{100});
+        }
+    }
+
+} // namespace jhoyt::asl::bench
@@ -0,0 +1,52 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <nanobench.h>
+
+namespace jhoyt::asl::bench
+{
+
+    /// The results of every benchmark group run so far. nanobench drops the results of a Bench whenever its title
+    /// changes, so the results of a group are kept here before the next group starts.
+    struct group_results
+    {
+        std::vector<std::string> titles;
+        std::vector<ankerl::nanobench::Result> results;
+    };
+
+    inline group_results& get_group_results()
+    {
+        static auto results = group_results{};
+        return results;
+    }
+
+    /// Keep the results of the group that is running; called before the next group starts and once all have run.
+    inline void end_group(const ankerl::nanobench::Bench& bench)
+    {
+        auto& kept = get_group_results();
+        kept.results.insert(kept.results.end(), bench.results().begin(), bench.results().end());
+    }
+
+    /// Start a benchmark group, keeping the results of the previous one. Use this rather than Bench::title.
+    inline ankerl::nanobench::Bench& begin_group(ankerl::nanobench::Bench& bench, const std::string& title)
+    {
+        end_group(bench);
+        get_group_results().titles.push_back(title);
+        return bench.title(title);
+    }
+
+    void run_address_benchmarks(ankerl::nanobench::Bench& bench);
+    void run_framer_benchmarks(ankerl::nanobench::Bench& bench);
+    void run_runtime_benchmarks(ankerl::nanobench::Bench& bench);
+    void run_network_benchmarks(ankerl::nanobench::Bench& bench);
+
+#if defined(ASL_BENCH_EXECUTION)
+    void run_execution_benchmarks(ankerl::nanobench::Bench& bench);
+#endif
+
+} // namespace jhoyt::asl::bench
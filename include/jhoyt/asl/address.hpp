@@ -3,44 +3,167 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <variant>
 
+#include "address_parser.hpp"
+#include "common.hpp"
+
 namespace jhoyt::asl
 {
 
-    /// @brief Type that represents a host:port pair for an IPv4 address.
-    struct ipv4_address
+    /// @brief Type that holds the four bytes of an IPv4 host address in network byte order.
+    ///
+    /// The type is trivially copyable and ordered by its bytes, which is also the numeric order of the address. Text is
+    /// only parsed when a host is constructed from a string and only produced when it is formatted.
+    class ASL_API ipv4_host final
     {
-        std::string host;
-        uint16_t port;
+    public:
+        using bytes_type = std::array<std::uint8_t, 4>;
+
+        /// @brief The largest number of characters in the text form of a host (without a terminating NUL).
+        static constexpr auto k_max_string_size = std::size_t{15};
+
+        /// @brief Construct the unspecified host, 0.0.0.0.
+        constexpr ipv4_host() = default;
+
+        /// @brief Construct a host from its bytes.
+        /// @param bytes The bytes of the host in network byte order.
+        constexpr explicit ipv4_host(const bytes_type& bytes) : bytes_(bytes)
+        {
+        }
+
+        /// @brief Construct a host by parsing dotted-quad text; throws std::runtime_error if the text is malformed.
+        ///
+        /// Parsing is constexpr, so a host constructed from a literal in a constant expression is checked at compile
+        /// time.
+        ///
+        /// @param text The text to parse, e.g. "127.0.0.1".
+        constexpr ipv4_host(const char* text) : ipv4_host(std::string_view{text})
+        {
+        }
 
-        auto operator==(const ipv4_address& other) const
+        /// @brief Construct a host by parsing dotted-quad text; throws std::runtime_error if the text is malformed.
+        /// @param text The text to parse, e.g. "127.0.0.1".
+        constexpr explicit ipv4_host(const std::string_view text)
         {
-            return host == other.host && port == other.port;
+            if (!detail::parse_ipv4_bytes(text, bytes_))
+            {
+                throw std::runtime_error{"malformed ipv4 address host"};
+            }
         }
 
-        auto operator!=(const ipv4_address& other) const
+        /// @brief Retrieve the bytes of the host in network byte order.
+        [[nodiscard]] constexpr const bytes_type& get_bytes() const
         {
-            return !(*this == other);
+            return bytes_;
         }
+
+        /// @brief Write the dotted-quad text form of the host into a buffer without allocating.
+        /// @param out Buffer that receives the characters.
+        /// @returns The number of characters written to the front of the buffer.
+        std::size_t write_string(std::span<char, k_max_string_size> out) const;
+
+        constexpr bool operator==(const ipv4_host&) const = default;
+        constexpr auto operator<=>(const ipv4_host&) const = default;
+
+    private:
+        bytes_type bytes_{};
     };
 
-    /// @brief Type that represents a host:port pair for an IPv6 address.
-    struct ipv6_address
+    /// @brief Type that holds the sixteen bytes of an IPv6 host address in network byte order.
+    ///
+    /// The type is trivially copyable and ordered by its bytes, which is also the numeric order of the address. Text is
+    /// only parsed when a host is constructed from a string and only produced when it is formatted.
+    class ASL_API ipv6_host final
     {
-        std::string host;
-        uint16_t port;
+    public:
+        using bytes_type = std::array<std::uint8_t, 16>;
+
+        /// @brief The largest number of characters in the text form of a host (without a terminating NUL).
+        static constexpr auto k_max_string_size = std::size_t{45};
 
-        auto operator==(const ipv6_address& other) const
+        /// @brief Construct the unspecified host, ::.
+        constexpr ipv6_host() = default;
+
+        /// @brief Construct a host from its bytes.
+        /// @param bytes The bytes of the host in network byte order.
+        constexpr explicit ipv6_host(const bytes_type& bytes) : bytes_(bytes)
         {
-            return host == other.host && port == other.port;
         }
 
-        auto operator!=(const ipv6_address& other) const
+        /// @brief Construct a host by parsing IPv6 text; throws std::runtime_error if the text is malformed.
+        ///
+        /// Parsing is constexpr, so a host constructed from a literal in a constant expression is checked at compile
+        /// time.
+        ///
+        /// @param text The text to parse, e.g. "::1".
+        constexpr ipv6_host(const char* text) : ipv6_host(std::string_view{text})
         {
-            return !(*this == other);
         }
+
+        /// @brief Construct a host by parsing IPv6 text; throws std::runtime_error if the text is malformed.
+        /// @param text The text to parse, e.g. "::1".
+        constexpr explicit ipv6_host(const std::string_view text)
+        {
+            if (!detail::parse_ipv6_bytes(text, bytes_))
+            {
+                throw std::runtime_error{"malformed ipv6 address host"};
+            }
+        }
+
+        /// @brief Retrieve the bytes of the host in network byte order.
+        [[nodiscard]] constexpr const bytes_type& get_bytes() const
+        {
+            return bytes_;
+        }
+
+        /// @brief Write the text form of the host (as produced by inet_ntop) into a buffer without allocating.
+        /// @param out Buffer that receives the characters.
+        /// @returns The number of characters written to the front of the buffer.
+        std::size_t write_string(std::span<char, k_max_string_size> out) const;
+
+        constexpr bool operator==(const ipv6_host&) const = default;
+        constexpr auto operator<=>(const ipv6_host&) const = default;
+
+    private:
+        bytes_type bytes_{};
+    };
+
+    /// @brief Type that represents a host:port pair for an IPv4 address.
+    struct ipv4_address
+    {
+        ipv4_host host;
+        std::uint16_t port;
+
+        constexpr bool operator==(const ipv4_address&) const = default;
+        constexpr auto operator<=>(const ipv4_address&) const = default;
+    };
+
+    /// @brief Type that represents a host:port pair (and the scope of a link-local host) for an IPv6 address.
+    struct ipv6_address
+    {
+        ipv6_host host;
+        std::uint16_t port;
+
+        /// @brief The interface index that a link-local host is reached through, or zero if it has no scope.
+        std::uint32_t scope_id = 0;
+
+        constexpr bool operator==(const ipv6_address&) const = default;
+        constexpr auto operator<=>(const ipv6_address&) const = default;
     };
 
     /// @brief Type that represents a file path for a UNIX domain address.
@@ -48,15 +171,8 @@ namespace jhoyt::asl
     {
         std::string path;
 
-        auto operator==(const file_address& other) const
-        {
-            return path == other.path;
-        }
-
-        auto operator!=(const file_address& other) const
-        {
-            return !(*this == other);
-        }
+        bool operator==(const file_address&) const = default;
+        auto operator<=>(const file_address&) const = default;
     };
 
     /// @brief Type that represents any of the supported address types.
@@ -85,7 +201,8 @@ namespace jhoyt::asl
 
     /// @brief Helper function to return a string representation of an IPv6 address.
     /// @param addr The IPv6 address value to get the string representation of.
-    /// @returns The string representation (in the form HOST:PORT) of the IPv6 address.
+    /// @returns The string representation (in the form HOST:PORT, or HOST%SCOPE:PORT for a scoped host) of the IPv6
+    /// address.
     std::string to_string(const ipv6_address& addr);
 
     /// @brief Helper function to return a string representation of a file (UNIX domain) address.
@@ -102,4 +219,289 @@ namespace jhoyt::asl
     /// @returns The string representation of the generic address.
     std::string to_string(const address& addr);
 
-} // namespace jhoyt::asl
\ No newline at end of file
+    /// @brief Parse an IPv4 address in the form written by to_string (HOST:PORT).
+    /// @param text The text to parse, e.g. "127.0.0.1:5555".
+    /// @returns The address, or an empty value if the text is malformed.
+    constexpr std::optional<ipv4_address> parse_ipv4_address(const std::string_view text)
+    {
+        const auto colon = text.rfind(':');
+        auto bytes = ipv4_host::bytes_type{};
+        auto port = std::uint32_t{0};
+        if (colon == std::string_view::npos || !detail::parse_ipv4_bytes(text.substr(0, colon), bytes) ||
+            !detail::parse_decimal(text.substr(colon + 1), 65535, port))
+        {
+            return std::nullopt;
+        }
+
+        return ipv4_address{.host = ipv4_host{bytes}, .port = static_cast<std::uint16_t>(port)};
+    }
+
+    /// @brief Parse an IPv6 address in the form written by to_string (HOST:PORT or HOST%SCOPE:PORT) or with the host
+    /// in brackets ([HOST]:PORT or [HOST%SCOPE]:PORT).
+    ///
+    /// The port is always taken from after the last colon, so "::1:5555" is the host ::1 on port 5555. A zone id must
+    /// be the numeric interface index; names such as "eth0" are resolved with if_nametoindex before parsing.
+    ///
+    /// @param text The text to parse, e.g. "[fe80::1%2]:5555".
+    /// @returns The address, or an empty value if the text is malformed.
+    constexpr std::optional<ipv6_address> parse_ipv6_address(const std::string_view text)
+    {
+        const auto colon = text.rfind(':');
+        if (colon == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+
+        auto host = text.substr(0, colon);
+        if (host.starts_with('['))
+        {
+            if (!host.ends_with(']'))
+            {
+                return std::nullopt;
+            }
+
+            host = host.substr(1, host.size() - 2);
+        }
+
+        auto scope_id = std::uint32_t{0};
+        if (const auto percent = host.find('%'); percent != std::string_view::npos)
+        {
+            if (!detail::parse_decimal(host.substr(percent + 1), UINT32_MAX, scope_id))
+            {
+                return std::nullopt;
+            }
+
+            host = host.substr(0, percent);
+        }
+
+        auto bytes = ipv6_host::bytes_type{};
+        auto port = std::uint32_t{0};
+        if (!detail::parse_ipv6_bytes(host, bytes) || !detail::parse_decimal(text.substr(colon + 1), 65535, port))
+        {
+            return std::nullopt;
+        }
+
+        return ipv6_address{.host = ipv6_host{bytes}, .port = static_cast<std::uint16_t>(port), .scope_id = scope_id};
+    }
+
+    /// @brief Parse a list of IPv4 hosts in dotted-quad form, such as the entries of an allowlist.
+    ///
+    /// This accepts exactly what the ipv4_host constructor accepts, but on x86-64 processors with SSSE3 each host is
+    /// parsed with a few vector instructions instead of a character at a time, which makes loading large lists several
+    /// times faster.
+    ///
+    /// @param texts The texts to parse.
+    /// @param hosts The parsed hosts; hosts[i] receives texts[i]. Must be at least as large as texts.
+    /// @returns The number of hosts parsed. This is less than the number of texts if texts[result] is malformed, in
+    /// which case the texts after it are not parsed.
+    std::size_t parse_ipv4_hosts(std::span<const std::string_view> texts, std::span<ipv4_host> hosts);
+
+} // namespace jhoyt::asl
+
+namespace jhoyt::asl::literals
+{
+
+    /// @brief Literal for an IPv4 address that is checked at compile time, e.g. "127.0.0.1:5555"_ipv4.
+    consteval ipv4_address operator""_ipv4(const char* text, const std::size_t size)
+    {
+        const auto addr = parse_ipv4_address({text, size});
+        if (!addr)
+        {
+            throw std::runtime_error{"malformed ipv4 address literal"};
+        }
+
+        return *addr;
+    }
+
+    /// @brief Literal for an IPv6 address that is checked at compile time, e.g. "[::1]:5555"_ipv6.
+    consteval ipv6_address operator""_ipv6(const char* text, const std::size_t size)
+    {
+        const auto addr = parse_ipv6_address({text, size});
+        if (!addr)
+        {
+            throw std::runtime_error{"malformed ipv6 address literal"};
+        }
+
+        return *addr;
+    }
+
+} // namespace jhoyt::asl::literals
+
+namespace jhoyt::asl::detail
+{
+
+    /// @brief Base type of the address formatters, which do not accept a format specification.
+    struct address_formatter_base
+    {
+        constexpr auto parse(std::format_parse_context& ctx)
+        {
+            const auto it = ctx.begin();
+            if (it != ctx.end() && *it != '}')
+            {
+                throw std::format_error{"addresses do not take a format specification"};
+            }
+
+            return it;
+        }
+    };
+
+    /// @brief Scramble the bits of a value so that similar inputs (such as neighbouring addresses) hash far apart.
+    ///
+    /// This is the finalizer of MurmurHash3, which is cheap and good enough for the power-of-two tables of the standard
+    /// library and the address maps.
+    constexpr std::uint64_t mix_hash(std::uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+} // namespace jhoyt::asl::detail
+
+/// @brief Formatter that writes an IPv4 host in dotted-quad form.
+template <>
+struct std::formatter<jhoyt::asl::ipv4_host> : jhoyt::asl::detail::address_formatter_base
+{
+    template <typename FormatContext>
+    auto format(const jhoyt::asl::ipv4_host& host, FormatContext& ctx) const
+    {
+        auto buf = std::array<char, jhoyt::asl::ipv4_host::k_max_string_size>{};
+        return std::copy_n(buf.data(), host.write_string(buf), ctx.out());
+    }
+};
+
+/// @brief Formatter that writes an IPv6 host in the form produced by inet_ntop.
+template <>
+struct std::formatter<jhoyt::asl::ipv6_host> : jhoyt::asl::detail::address_formatter_base
+{
+    template <typename FormatContext>
+    auto format(const jhoyt::asl::ipv6_host& host, FormatContext& ctx) const
+    {
+        auto buf = std::array<char, jhoyt::asl::ipv6_host::k_max_string_size>{};
+        return std::copy_n(buf.data(), host.write_string(buf), ctx.out());
+    }
+};
+
+/// @brief Formatter that writes an IPv4 address in the same form as to_string (HOST:PORT).
+template <>
+struct std::formatter<jhoyt::asl::ipv4_address> : jhoyt::asl::detail::address_formatter_base
+{
+    template <typename FormatContext>
+    auto format(const jhoyt::asl::ipv4_address& addr, FormatContext& ctx) const
+    {
+        return std::format_to(ctx.out(), "{}:{}", addr.host, addr.port);
+    }
+};
+
+/// @brief Formatter that writes an IPv6 address in the same form as to_string (HOST:PORT or HOST%SCOPE:PORT).
+template <>
+struct std::formatter<jhoyt::asl::ipv6_address> : jhoyt::asl::detail::address_formatter_base
+{
+    template <typename FormatContext>
+    auto format(const jhoyt::asl::ipv6_address& addr, FormatContext& ctx) const
+    {
+        if (addr.scope_id != 0)
+        {
+            return std::format_to(ctx.out(), "{}%{}:{}", addr.host, addr.scope_id, addr.port);
+        }
+
+        return std::format_to(ctx.out(), "{}:{}", addr.host, addr.port);
+    }
+};
+
+/// @brief Formatter that writes a file address in the same form as to_string (the path).
+template <>
+struct std::formatter<jhoyt::asl::file_address> : jhoyt::asl::detail::address_formatter_base
+{
+    template <typename FormatContext>
+    auto format(const jhoyt::asl::file_address& addr, FormatContext& ctx) const
+    {
+        return std::ranges::copy(addr.path, ctx.out()).out;
+    }
+};
+
+/// @brief Formatter that writes a generic address in the same form as to_string, with an 'ipv4://', 'ipv6://' or
+/// 'file://' prefix.
+///
+/// Formatting writes straight into the output of the format context, so std::format_to and std::format_to_n with a
+/// fixed buffer do not allocate.
+template <>
+struct std::formatter<jhoyt::asl::address> : jhoyt::asl::detail::address_formatter_base
+{
+    template <typename FormatContext>
+    auto format(const jhoyt::asl::address& addr, FormatContext& ctx) const
+    {
+        switch (jhoyt::asl::get_address_type(addr))
+        {
+
+        case jhoyt::asl::address_type::ipv4:
+            return std::format_to(ctx.out(), "ipv4://{}", *std::get_if<jhoyt::asl::ipv4_address>(&addr));
+
+        case jhoyt::asl::address_type::ipv6:
+            return std::format_to(ctx.out(), "ipv6://{}", *std::get_if<jhoyt::asl::ipv6_address>(&addr));
+
+        case jhoyt::asl::address_type::file:
+            return std::format_to(ctx.out(), "file://{}", *std::get_if<jhoyt::asl::file_address>(&addr));
+
+        default:
+            assert(false);
+            return ctx.out();
+        }
+    }
+};
+
+template <>
+struct std::hash<jhoyt::asl::ipv4_host>
+{
+    std::size_t operator()(const jhoyt::asl::ipv4_host& host) const noexcept
+    {
+        return static_cast<std::size_t>(jhoyt::asl::detail::mix_hash(std::bit_cast<std::uint32_t>(host.get_bytes())));
+    }
+};
+
+template <>
+struct std::hash<jhoyt::asl::ipv6_host>
+{
+    std::size_t operator()(const jhoyt::asl::ipv6_host& host) const noexcept
+    {
+        using jhoyt::asl::detail::mix_hash;
+
+        const auto words = std::bit_cast<std::array<std::uint64_t, 2>>(host.get_bytes());
+        return static_cast<std::size_t>(mix_hash(words[0] ^ mix_hash(words[1])));
+    }
+};
+
+template <>
+struct std::hash<jhoyt::asl::ipv4_address>
+{
+    std::size_t operator()(const jhoyt::asl::ipv4_address& addr) const noexcept
+    {
+        const auto host = std::uint64_t{std::bit_cast<std::uint32_t>(addr.host.get_bytes())};
+        return static_cast<std::size_t>(jhoyt::asl::detail::mix_hash(host << 16 | addr.port));
+    }
+};
+
+template <>
+struct std::hash<jhoyt::asl::ipv6_address>
+{
+    std::size_t operator()(const jhoyt::asl::ipv6_address& addr) const noexcept
+    {
+        using jhoyt::asl::detail::mix_hash;
+
+        const auto words = std::bit_cast<std::array<std::uint64_t, 2>>(addr.host.get_bytes());
+        const auto extra = std::uint64_t{addr.scope_id} << 16 | addr.port;
+        return static_cast<std::size_t>(mix_hash(words[0] ^ mix_hash(words[1] ^ mix_hash(extra))));
+    }
+};
+
+template <>
+struct std::hash<jhoyt::asl::file_address>
+{
+    std::size_t operator()(const jhoyt::asl::file_address& addr) const noexcept
+    {
+        return std::hash<std::string>{}(addr.path);
+    }
+};
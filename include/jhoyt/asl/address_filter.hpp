@@ -0,0 +1,188 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "address.hpp"
+#include "common.hpp"
+#include "raw_address.hpp"
+#include "socket.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Enumeration that defines what happens to a connection from an address matched by a rule.
+    enum class filter_action : std::uint8_t
+    {
+        allow,
+        deny
+    };
+
+    /// @brief Type that represents a CIDR rule, e.g. "10.0.0.0/8", that applies an action to a network.
+    struct cidr_rule
+    {
+        /// @brief The network address; any bits after the prefix are ignored.
+        std::variant<ipv4_host, ipv6_host> network;
+        std::uint8_t prefix_length = 0;
+        filter_action action = filter_action::deny;
+    };
+
+    /// @brief Parse CIDR text into a rule.
+    ///
+    /// A host without a prefix length, e.g. "192.0.2.1" or "2001:db8::1", is a rule for that single host.
+    ///
+    /// @param text The text to parse, e.g. "10.0.0.0/8" or "2001:db8::/32".
+    /// @param action The action of the rule.
+    /// @returns The rule, or std::nullopt if the text is not a well-formed network.
+    std::optional<cidr_rule> parse_cidr_rule(std::string_view text, filter_action action);
+
+    namespace detail
+    {
+
+        /// @brief Type that represents a node of a poptrie: a 64-way node whose children and leaves are found by
+        /// counting the bits set in a bitmap, so only the present ones are stored.
+        struct cidr_node
+        {
+            /// @brief Bit i is set if the six-bit chunk value i leads to a child node.
+            std::uint64_t children = 0;
+
+            /// @brief Bit i is set if a run of chunk values with the same action starts at i.
+            std::uint64_t leaves = 0;
+
+            std::uint32_t child_base = 0;
+            std::uint32_t leaf_base = 0;
+        };
+
+        /// @brief Type that holds the compiled nodes and leaf actions of one address family.
+        struct cidr_trie
+        {
+            std::vector<cidr_node> nodes;
+            std::vector<filter_action> leaves;
+
+            /// @brief For each value of the leading twelve address bits, the node to continue from or the action.
+            std::vector<std::uint32_t> direct;
+        };
+
+    } // namespace detail
+
+    /// @brief Type that holds a compiled, immutable set of CIDR rules for IPv4 and IPv6 addresses.
+    ///
+    /// Rules are compiled into a poptrie per family: a table indexed by the leading twelve bits of the address points
+    /// to a node, and each node covers the next six bits, so an IPv4 lookup takes at most four node visits (and an IPv6
+    /// lookup at most 20, fewer for the usual /64 or shorter prefixes). Lookups read straight from the bytes of a raw
+    /// address without building a string or a generic address. Each node stores only its present children and the
+    /// distinct runs of its leaves, which keeps large rule sets small enough for the cache.
+    ///
+    /// The longest matching prefix decides the action; between rules for the same network, the later one wins. An
+    /// IPv4-mapped IPv6 address (as accepted by a dual-stack listener) is matched against the IPv4 rules. Addresses
+    /// that match no rule, and file addresses, get the default action.
+    class ASL_API cidr_table final
+    {
+    public:
+        /// @brief Construct a table without rules, which allows every address.
+        cidr_table();
+
+        /// @brief Construct a new table by compiling a set of rules.
+        /// @param rules The rules; a prefix length longer than the address throws std::runtime_error.
+        /// @param default_action The action for addresses that match no rule.
+        explicit cidr_table(std::span<const cidr_rule> rules, filter_action default_action = filter_action::allow);
+
+        /// @brief Retrieve the action for an address.
+        [[nodiscard]] filter_action lookup(const raw_address& addr) const;
+
+        [[nodiscard]] filter_action get_default_action() const
+        {
+            return default_action_;
+        }
+
+        /// @brief Retrieve the number of trie nodes of both families, as a measure of the memory used.
+        [[nodiscard]] std::size_t get_node_count() const
+        {
+            return ipv4_.nodes.size() + ipv6_.nodes.size();
+        }
+
+    private:
+        detail::cidr_trie ipv4_;
+        detail::cidr_trie ipv6_;
+        filter_action default_action_ = filter_action::allow;
+    };
+
+    namespace detail
+    {
+        struct accept_operation;
+    } // namespace detail
+
+    /// @brief Type that filters the peers of accepted connections by a CIDR table that can be replaced at any time.
+    ///
+    /// Lookups may run on any number of threads and never block: a lookup registers itself in the reader count of the
+    /// current epoch, reads the table through an atomic pointer and leaves again. An update publishes the new table,
+    /// moves readers on to the next epoch and then only waits for the readers of the previous one before freeing the
+    /// old table, so accepting carries on throughout.
+    class ASL_API address_filter final
+    {
+    public:
+        /// @brief Construct a new filter.
+        /// @param table The initial rules.
+        explicit address_filter(cidr_table table = {});
+
+        ~address_filter();
+
+        address_filter(const address_filter&) = delete;
+        address_filter& operator=(const address_filter&) = delete;
+
+        /// @brief Replace the rules; lookups that started before the call may still use the old rules.
+        ///
+        /// This may be called from any thread; concurrent updates are applied one at a time.
+        ///
+        /// @param table The new rules.
+        void update(cidr_table table);
+
+        /// @brief Check the address of a peer against the rules.
+        /// @returns True if the rules allow the address.
+        [[nodiscard]] bool is_allowed(const raw_address& addr) const;
+
+        /// @brief Accept the next incoming connection whose peer is allowed, closing the denied ones right away.
+        /// @param listener The listening socket.
+        /// @param sock A socket object to update with the new incoming connection.
+        /// @param addr An address object to update with the address of the peer.
+        /// @returns True if an allowed connection was accepted, otherwise false if there was no (further) incoming
+        /// connection to process.
+        bool accept(socket& listener, socket& sock, raw_address& addr) const
+        {
+            while (listener.accept(sock, addr))
+            {
+                if (is_allowed(addr))
+                {
+                    return true;
+                }
+
+                sock.close();
+            }
+
+            return false;
+        }
+
+    private:
+        friend struct detail::accept_operation;
+
+        /// Calls accept(); the event loop accepts through this pointer so that it does not link against the filter.
+        bool (*accept_)(const address_filter& self, socket& listener, socket& sock, raw_address& addr);
+        std::atomic<const cidr_table*> table_;
+        std::atomic<std::uint64_t> epoch_{0};
+        std::mutex update_mutex_;
+
+        /// The readers of even and odd epochs, written by every lookup and therefore on a cache line of their own.
+        alignas(k_cache_line_size) mutable std::array<std::atomic<std::uint64_t>, 2> readers_{};
+    };
+
+} // namespace jhoyt::asl
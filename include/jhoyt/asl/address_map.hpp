@@ -0,0 +1,271 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "raw_address.hpp"
+
+namespace jhoyt::asl::detail
+{
+
+    /// @brief Type that holds the meaningful bytes of an IP address in 24 bytes, the key stored by an address_map.
+    struct address_key
+    {
+        /// @brief The host bytes in network byte order; an IPv4 host only uses the first four.
+        std::array<std::uint8_t, 16> host;
+        std::uint32_t scope_id;
+        std::uint16_t port;
+        std::uint16_t type;
+
+        bool operator==(const address_key&) const = default;
+    };
+
+    /// @brief Build the key of an IPv4 or IPv6 raw address; throws std::runtime_error for any other address.
+    address_key make_address_key(const raw_address& addr);
+
+    inline std::size_t hash_address_key(const address_key& key)
+    {
+        const auto words = std::bit_cast<std::array<std::uint64_t, 2>>(key.host);
+        const auto extra = std::uint64_t{key.scope_id} << 32 | std::uint64_t{key.port} << 16 | key.type;
+        return static_cast<std::size_t>(mix_hash(words[0] ^ mix_hash(words[1] ^ mix_hash(extra))));
+    }
+
+} // namespace jhoyt::asl::detail
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that maps peer (IPv4 or IPv6) addresses to values in a flat, open-addressing hash table.
+    ///
+    /// This is meant for tables keyed by the address of a peer, such as rate limits, deduplication or session
+    /// affinity. Keys are stored as their 24 meaningful bytes rather than as raw addresses or strings, slots live in a
+    /// single array that is probed linearly, and erasing shifts later entries back instead of leaving tombstones, so
+    /// a lookup touches one or two cache lines and never allocates. A map is not thread-safe.
+    ///
+    /// Looking up a file (UNIX domain) address throws std::runtime_error, as its peers have no meaningful address.
+    ///
+    /// @tparam T The mapped type.
+    template <typename T>
+    class address_map final
+    {
+    public:
+        static constexpr auto k_default_capacity = std::size_t{16};
+
+        /// @brief Construct a new map.
+        /// @param capacity The number of entries the map can hold before it grows.
+        explicit address_map(const std::size_t capacity = k_default_capacity)
+            : slots_(get_slot_count(capacity)), mask_(slots_.size() - 1)
+        {
+        }
+
+        /// @brief Retrieve the number of entries in the map.
+        [[nodiscard]] std::size_t get_size() const
+        {
+            return size_;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        /// @brief Retrieve the number of entries the map can hold before it grows.
+        [[nodiscard]] std::size_t get_capacity() const
+        {
+            return slots_.size() / 4 * 3;
+        }
+
+        /// @brief Look up the value of an address.
+        /// @param addr The address to look up.
+        /// @returns Pointer to the value, or nullptr if the address is not in the map.
+        T* find(const raw_address& addr)
+        {
+            const auto ix = find_slot(detail::make_address_key(addr));
+            return slots_[ix].value ? &*slots_[ix].value : nullptr;
+        }
+
+        /// @brief Look up the value of an address.
+        /// @param addr The address to look up.
+        /// @returns Pointer to the value, or nullptr if the address is not in the map.
+        const T* find(const raw_address& addr) const
+        {
+            const auto ix = find_slot(detail::make_address_key(addr));
+            return slots_[ix].value ? &*slots_[ix].value : nullptr;
+        }
+
+        /// @brief Add an entry for an address unless it already has one.
+        /// @param addr The address to add.
+        /// @param args The arguments to construct the value from; they are only used if the entry is added.
+        /// @returns Reference to the value of the address, and true if the entry was added.
+        template <typename... Args>
+        std::pair<T&, bool> try_emplace(const raw_address& addr, Args&&... args)
+        {
+            const auto key = detail::make_address_key(addr);
+            auto ix = find_slot(key);
+            if (slots_[ix].value)
+            {
+                return {*slots_[ix].value, false};
+            }
+
+            if (size_ + 1 > get_capacity())
+            {
+                grow();
+                ix = find_slot(key);
+            }
+
+            auto& s = slots_[ix];
+            s.key = key;
+            s.value.emplace(std::forward<Args>(args)...);
+            ++size_;
+            return {*s.value, true};
+        }
+
+        /// @brief Retrieve the value of an address, adding a value-initialized entry if it has none.
+        T& operator[](const raw_address& addr)
+        {
+            return try_emplace(addr).first;
+        }
+
+        /// @brief Remove the entry of an address.
+        /// @param addr The address to remove.
+        /// @returns True if the address had an entry.
+        bool erase(const raw_address& addr)
+        {
+            const auto ix = find_slot(detail::make_address_key(addr));
+            if (!slots_[ix].value)
+            {
+                return false;
+            }
+
+            erase_slot(ix);
+            return true;
+        }
+
+        /// @brief Remove every entry whose value matches a predicate, e.g. to expire idle peers.
+        /// @param pred Callable taking a value and returning true if its entry should be removed.
+        /// @returns The number of entries removed.
+        template <typename Predicate>
+        std::size_t erase_if(Predicate pred)
+        {
+            const auto before = size_;
+            for (auto ix = std::size_t{0}; ix < slots_.size();)
+            {
+                // Erasing shifts a later entry into this slot, so the slot is checked again.
+                if (slots_[ix].value && pred(*slots_[ix].value))
+                {
+                    erase_slot(ix);
+                }
+                else
+                {
+                    ++ix;
+                }
+            }
+
+            return before - size_;
+        }
+
+        /// @brief Call a function with every value in the map, in no particular order.
+        template <typename Visitor>
+        void for_each(Visitor visit)
+        {
+            for (auto& s : slots_)
+            {
+                if (s.value)
+                {
+                    visit(*s.value);
+                }
+            }
+        }
+
+        /// @brief Remove every entry, keeping the capacity.
+        void clear()
+        {
+            for (auto& s : slots_)
+            {
+                s.value.reset();
+            }
+
+            size_ = 0;
+        }
+
+    private:
+        struct slot
+        {
+            detail::address_key key;
+            std::optional<T> value;
+        };
+
+        std::vector<slot> slots_;
+        std::size_t mask_;
+        std::size_t size_ = 0;
+
+        /// The table is kept at most three quarters full, so probe sequences stay short.
+        static std::size_t get_slot_count(const std::size_t capacity)
+        {
+            return std::bit_ceil(std::max<std::size_t>(capacity / 3 * 4 + 4, 8));
+        }
+
+        std::size_t get_home(const detail::address_key& key) const
+        {
+            return detail::hash_address_key(key) & mask_;
+        }
+
+        /// Find the slot holding a key, or the empty slot where it would be added.
+        std::size_t find_slot(const detail::address_key& key) const
+        {
+            auto ix = get_home(key);
+            while (slots_[ix].value && !(slots_[ix].key == key))
+            {
+                ix = (ix + 1) & mask_;
+            }
+
+            return ix;
+        }
+
+        /// Empty a slot, then move back any later entry of the same probe sequence that could no longer be found.
+        void erase_slot(std::size_t ix)
+        {
+            slots_[ix].value.reset();
+            --size_;
+
+            for (auto next = (ix + 1) & mask_; slots_[next].value; next = (next + 1) & mask_)
+            {
+                // The entry can fill the hole if its home slot is not cyclically between the hole and itself.
+                const auto home = get_home(slots_[next].key);
+                if (((next - home) & mask_) >= ((next - ix) & mask_))
+                {
+                    slots_[ix].key = slots_[next].key;
+                    slots_[ix].value = std::move(slots_[next].value);
+                    slots_[next].value.reset();
+                    ix = next;
+                }
+            }
+        }
+
+        void grow()
+        {
+            auto old = std::exchange(slots_, std::vector<slot>(slots_.size() * 2));
+            mask_ = slots_.size() - 1;
+            for (auto& s : old)
+            {
+                if (s.value)
+                {
+                    auto& target = slots_[find_slot(s.key)];
+                    target.key = s.key;
+                    target.value = std::move(s.value);
+                }
+            }
+        }
+    };
+
+} // namespace jhoyt::asl
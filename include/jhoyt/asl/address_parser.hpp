@@ -0,0 +1,241 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/// The text parsers behind the host constructors, parse_ipv4_address, parse_ipv6_address and the address literals.
+///
+/// They work on a std::string_view (no NUL terminator or copy is needed), are constexpr so that literals are checked
+/// at compile time, and accept exactly what inet_pton accepts: four decimal fields without leading zeros for IPv4, and
+/// for IPv6 up to eight groups of one to four hex digits with at most one :: and an optional dotted-quad tail.
+namespace jhoyt::asl::detail
+{
+
+    constexpr bool is_decimal_digit(const char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    /// @brief Retrieve the value of a hex digit, or -1 if the character is not one.
+    constexpr int get_hex_digit_value(const char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0';
+        }
+
+        if (c >= 'a' && c <= 'f')
+        {
+            return c - 'a' + 10;
+        }
+
+        if (c >= 'A' && c <= 'F')
+        {
+            return c - 'A' + 10;
+        }
+
+        return -1;
+    }
+
+    /// @brief Parse an unsigned decimal number no larger than a maximum, such as a port or a scope id.
+    /// @param text The digits to parse.
+    /// @param max_value The largest value that is accepted.
+    /// @param out The parsed value; it is only written on success.
+    /// @returns True if the text held a number no larger than the maximum.
+    constexpr bool parse_decimal(const std::string_view text, const std::uint32_t max_value, std::uint32_t& out)
+    {
+        if (text.empty())
+        {
+            return false;
+        }
+
+        auto value = std::uint64_t{0};
+        for (const auto c : text)
+        {
+            if (!is_decimal_digit(c))
+            {
+                return false;
+            }
+
+            value = value * 10 + static_cast<std::uint64_t>(c - '0');
+            if (value > max_value)
+            {
+                return false;
+            }
+        }
+
+        out = static_cast<std::uint32_t>(value);
+        return true;
+    }
+
+    /// @brief Parse dotted-quad text, e.g. "127.0.0.1", into the four bytes of an IPv4 host.
+    /// @param text The text to parse.
+    /// @param out The bytes of the host in network byte order; they are only written on success.
+    /// @returns True if the text was a well-formed host.
+    constexpr bool parse_ipv4_bytes(const std::string_view text, std::array<std::uint8_t, 4>& out)
+    {
+        auto bytes = std::array<std::uint8_t, 4>{};
+        auto field = std::size_t{0};
+        auto value = 0u;
+        auto digits = 0u;
+
+        for (const auto c : text)
+        {
+            if (is_decimal_digit(c))
+            {
+                // A field with a leading zero is rejected, as it would be read as octal by inet_aton.
+                if (digits == 1 && value == 0)
+                {
+                    return false;
+                }
+
+                value = value * 10 + static_cast<unsigned>(c - '0');
+                if (value > 255)
+                {
+                    return false;
+                }
+
+                ++digits;
+            }
+            else if (c == '.' && digits != 0 && field < 3)
+            {
+                bytes[field++] = static_cast<std::uint8_t>(value);
+                value = 0;
+                digits = 0;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        if (field != 3 || digits == 0)
+        {
+            return false;
+        }
+
+        bytes[3] = static_cast<std::uint8_t>(value);
+        out = bytes;
+        return true;
+    }
+
+    /// @brief Parse IPv6 text, e.g. "2001:db8::1" or "::ffff:192.0.2.1", into the sixteen bytes of an IPv6 host.
+    /// @param text The text to parse, without brackets or a zone id.
+    /// @param out The bytes of the host in network byte order; they are only written on success.
+    /// @returns True if the text was a well-formed host.
+    constexpr bool parse_ipv6_bytes(const std::string_view text, std::array<std::uint8_t, 16>& out)
+    {
+        auto bytes = std::array<std::uint8_t, 16>{};
+        auto count = std::size_t{0};
+
+        // The byte offset that the :: stands in for, if the text has one.
+        auto has_gap = false;
+        auto gap = std::size_t{0};
+
+        auto ix = std::size_t{0};
+        if (text.starts_with("::"))
+        {
+            has_gap = true;
+            ix = 2;
+        }
+        else if (text.starts_with(':'))
+        {
+            return false;
+        }
+
+        while (ix < text.size())
+        {
+            const auto start = ix;
+            auto value = 0u;
+            for (; ix < text.size() && ix - start < 4 && get_hex_digit_value(text[ix]) >= 0; ++ix)
+            {
+                value = value * 16 + static_cast<unsigned>(get_hex_digit_value(text[ix]));
+            }
+
+            if (ix == start)
+            {
+                return false;
+            }
+
+            // A dotted-quad tail fills the last four bytes and must end the text.
+            if (ix < text.size() && text[ix] == '.')
+            {
+                auto tail = std::array<std::uint8_t, 4>{};
+                if (count > 12 || !parse_ipv4_bytes(text.substr(start), tail))
+                {
+                    return false;
+                }
+
+                for (const auto b : tail)
+                {
+                    bytes[count++] = b;
+                }
+
+                break;
+            }
+
+            if (count == 16)
+            {
+                return false;
+            }
+
+            bytes[count++] = static_cast<std::uint8_t>(value >> 8);
+            bytes[count++] = static_cast<std::uint8_t>(value);
+
+            if (ix == text.size())
+            {
+                break;
+            }
+
+            // Anything but a colon here is a bad character or a fifth hex digit.
+            if (text[ix] != ':' || ++ix == text.size())
+            {
+                return false;
+            }
+
+            if (text[ix] == ':')
+            {
+                if (has_gap)
+                {
+                    return false;
+                }
+
+                has_gap = true;
+                gap = count;
+                ++ix;
+            }
+        }
+
+        if (!has_gap)
+        {
+            if (count != 16)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // The :: stands for at least one group of zeros; the groups after it move to the end.
+            if (count == 16)
+            {
+                return false;
+            }
+
+            const auto shift = 16 - count;
+            for (auto from = count; from > gap; --from)
+            {
+                bytes[from - 1 + shift] = bytes[from - 1];
+                bytes[from - 1] = 0;
+            }
+        }
+
+        out = bytes;
+        return true;
+    }
+
+} // namespace jhoyt::asl::detail
@@ -3,7 +3,29 @@
 
 #pragma once
 
+#include "address_filter.hpp"
+#include "address_map.hpp"
+#include "broadcaster.hpp"
+#include "buffer_pool.hpp"
+#include "connect_race.hpp"
+#include "connection_pool.hpp"
 #include "context.hpp"
+#include "dispatcher.hpp"
+#include "event_fd.hpp"
+#include "event_loop.hpp"
+#include "framer.hpp"
+#include "mpsc_queue.hpp"
+#include "pipe.hpp"
 #include "poller.hpp"
+#include "rebalancer.hpp"
+#include "recv_buffer.hpp"
+#include "resolver.hpp"
+#include "runtime.hpp"
+#include "send_queue.hpp"
+#include "shared_buffer.hpp"
+#include "signal_fd.hpp"
 #include "socket.hpp"
+#include "spsc_queue.hpp"
+#include "task.hpp"
+#include "timer_fd.hpp"
 #include "version.hpp"
\ No newline at end of file
@@ -0,0 +1,57 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <span>
+#include <unordered_map>
+
+#include "common.hpp"
+#include "send_queue.hpp"
+#include "shared_buffer.hpp"
+#include "socket.hpp"
+#include "socket_id.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that sends the same payloads to many sockets while keeping a single copy of each payload.
+    ///
+    /// The broadcaster keeps a send_queue per socket. Broadcasting a buffer queues a reference to it on every target
+    /// socket and then tries to send immediately; whatever a socket cannot accept stays queued (with its own offset)
+    /// until flush() is called for that socket, typically in response to poller::poll_status::ready_to_write.
+    class ASL_API broadcaster final
+    {
+    public:
+        /// @brief Queue a buffer on many sockets and send as much of it as possible without blocking.
+        ///
+        /// The buffer is queued on every socket before any sending is attempted, so an error raised while sending on
+        /// one socket does not prevent the buffer from being queued on the others.
+        ///
+        /// @param sockets The sockets to send the buffer on.
+        /// @param buf The buffer to send.
+        /// @returns The number of sockets that still have queued data and should be polled for writing.
+        std::size_t broadcast(std::span<socket* const> sockets, const shared_buffer& buf);
+
+        /// @brief Send as much of a socket's queued data as possible without blocking.
+        ///
+        /// If the socket is found to be disconnected its queued data is discarded.
+        ///
+        /// @param sock The socket to send queued data on.
+        /// @returns The transfer status, as returned by send_queue::flush.
+        socket::transfer_status flush(socket& sock);
+
+        /// @brief Check if a socket has data queued that has not been sent yet.
+        /// @param id The OS-level identifier of the socket.
+        /// @returns True if there is queued data for the socket, otherwise false.
+        [[nodiscard]] bool has_pending(socket_id id) const;
+
+        /// @brief Discard all data queued for a socket, e.g. before it is closed.
+        /// @param id The OS-level identifier of the socket.
+        void remove(socket_id id);
+
+    private:
+        std::unordered_map<socket_id, send_queue> queues_;
+    };
+
+} // namespace jhoyt::asl
@@ -0,0 +1,69 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "common.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that hands out fixed-size buffers from slabs that are allocated once and then recycled.
+    ///
+    /// Buffers are allocated in slabs of several buffers at a time and returned buffers are kept on a free list, so
+    /// once a program has reached its steady state acquiring a buffer does not allocate. A pool is not thread-safe; it
+    /// is intended to be owned by a single thread (see worker::get_buffer_pool).
+    class ASL_API buffer_pool final
+    {
+    public:
+        static constexpr auto k_default_buffer_size = std::size_t{16 * 1024};
+        static constexpr auto k_default_buffers_per_slab = std::size_t{64};
+
+        /// @brief Construct a new buffer pool.
+        /// @param buffer_size The size of every buffer handed out by the pool.
+        /// @param buffers_per_slab The number of buffers allocated together whenever the free list is empty.
+        explicit buffer_pool(std::size_t buffer_size = k_default_buffer_size,
+                             std::size_t buffers_per_slab = k_default_buffers_per_slab);
+
+        buffer_pool(const buffer_pool&) = delete;
+        buffer_pool& operator=(const buffer_pool&) = delete;
+
+        /// @brief Retrieve the size of every buffer handed out by the pool.
+        [[nodiscard]] auto get_buffer_size() const
+        {
+            return buffer_size_;
+        }
+
+        /// @brief Retrieve the number of buffers the pool has allocated, whether in use or not.
+        [[nodiscard]] std::size_t get_allocated_count() const
+        {
+            return slabs_.size() * buffers_per_slab_;
+        }
+
+        /// @brief Retrieve the number of buffers that can be acquired without allocating.
+        [[nodiscard]] std::size_t get_available_count() const
+        {
+            return free_.size();
+        }
+
+        /// @brief Take a buffer from the pool, allocating a new slab if none are available.
+        /// @returns Span over a buffer of get_buffer_size() bytes.
+        std::span<char> acquire();
+
+        /// @brief Return a buffer to the pool.
+        /// @param buffer A buffer previously returned by acquire on this pool.
+        void release(std::span<char> buffer);
+
+    private:
+        std::size_t buffer_size_;
+        std::size_t buffers_per_slab_;
+        std::vector<std::unique_ptr<char[]>> slabs_;
+        std::vector<char*> free_;
+    };
+
+} // namespace jhoyt::asl
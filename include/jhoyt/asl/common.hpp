@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #if defined(ASL_SHARED_LIB)
 #if defined(_WIN32)
 #if defined(asl_EXPORTS)
@@ -15,4 +17,12 @@
 #endif
 #else
 #define ASL_API
-#endif
\ No newline at end of file
+#endif
+
+namespace jhoyt::asl
+{
+
+    /// @brief Size used to keep atomics written by different threads on separate cache lines.
+    constexpr auto k_cache_line_size = std::size_t{64};
+
+} // namespace jhoyt::asl
\ No newline at end of file
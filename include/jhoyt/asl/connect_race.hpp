@@ -0,0 +1,229 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "common.hpp"
+#include "event_loop.hpp"
+#include "raw_address.hpp"
+#include "socket.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that holds the settings of a connection race.
+    struct connect_race_options
+    {
+        /// @brief How long an attempt may stay pending before the next one is started alongside it (the Connection
+        /// Attempt Delay of RFC 8305).
+        std::chrono::milliseconds attempt_delay{250};
+
+        /// @brief How many addresses of the preferred family are tried before the first one of the other family.
+        std::size_t first_family_count = 1;
+
+        /// @brief How long the whole race may take; zero waits until every attempt has succeeded or failed.
+        std::chrono::milliseconds timeout{0};
+    };
+
+    namespace detail
+    {
+
+        /// @brief Order the candidates of a race by interleaving their families, starting with first_family_count
+        /// addresses of the family of the first candidate; addresses keep their order within a family.
+        std::vector<raw_address> order_connect_candidates(std::span<const raw_address> candidates,
+                                                          std::size_t first_family_count);
+
+    } // namespace detail
+
+    class connect_race;
+
+    /// @brief Type that refers to an object that is notified once a connection race has completed.
+    ///
+    /// Use connect_race::start with a handler object to create one; the stored function pointer calls the handler's
+    /// `on_race_completed(connect_race&)` member directly.
+    struct race_handler
+    {
+        void* object = nullptr;
+        void (*on_completed)(void* object, connect_race& race) = nullptr;
+    };
+
+    class connect_race_awaiter;
+
+    /// @brief Type that connects to the first reachable address of a list by racing staggered connection attempts on
+    /// an event loop, as described by Happy Eyeballs (RFC 8305).
+    ///
+    /// The candidates are interleaved by family (see detail::order_connect_candidates), so a dual-stack client that
+    /// gets IPv6 addresses first from the resolver tries IPv6 first but falls back to IPv4 quickly. Attempts are
+    /// started one at a time: the next one starts once the current one has failed or has been pending for the attempt
+    /// delay, while the earlier ones carry on. The first attempt to connect wins and every other attempt is closed;
+    /// the race fails once every attempt has failed (or the timeout has passed).
+    ///
+    /// A race is reusable once it has completed. It must not be moved while running, and it may be destroyed from
+    /// its completion handler (e.g. by a coroutine that awaited it and then finished).
+    ///
+    /// @note All functions must be called on the thread that runs the loop.
+    class ASL_API connect_race final
+    {
+    public:
+        /// @brief Inner enumeration that represents the state of a race.
+        enum class status
+        {
+            /// @brief The race has not been started, or has been cancelled.
+            idle,
+
+            /// @brief Attempts are in progress.
+            running,
+
+            /// @brief An attempt connected; see take_socket and get_address.
+            connected,
+
+            /// @brief Every attempt failed.
+            failed,
+
+            /// @brief The timeout passed before an attempt connected.
+            timed_out
+        };
+
+        /// @brief Construct a new race.
+        /// @param loop The event loop to run the attempts on; it must outlive the race.
+        /// @param options The settings of the race.
+        explicit connect_race(event_loop& loop, connect_race_options options = {});
+
+        /// @brief Destroy the race, closing any attempts that are still in progress.
+        ~connect_race();
+
+        connect_race(const connect_race&) = delete;
+        connect_race& operator=(const connect_race&) = delete;
+
+        /// @brief Start racing connections to a list of candidates.
+        ///
+        /// The handler is called once the race has completed, which happens before this returns if there are no
+        /// candidates, every attempt fails right away or the first one connects right away.
+        ///
+        /// @param candidates The addresses to connect to, in order of preference; they are copied.
+        /// @param handler The handler to notify.
+        void start(std::span<const raw_address> candidates, race_handler handler);
+
+        /// @brief Start racing connections to a list of candidates, notifying a handler object.
+        ///
+        /// The handler object must have a member `on_race_completed(connect_race&)` and remain valid until it has been
+        /// called or the race has been cancelled.
+        ///
+        /// @param candidates The addresses to connect to, in order of preference; they are copied.
+        /// @param handler The handler object to notify.
+        template <typename Handler>
+        void start(const std::span<const raw_address> candidates, Handler& handler)
+        {
+            start(candidates, race_handler{&handler, [](void* object, connect_race& race) {
+                                               static_cast<Handler*>(object)->on_race_completed(race);
+                                           }});
+        }
+
+        /// @brief Race connections to a list of candidates, suspending until the race has completed.
+        /// @param candidates The addresses to connect to, in order of preference; they are copied.
+        /// @returns Awaitable that produces true if an attempt connected, otherwise false.
+        connect_race_awaiter async_connect(std::span<const raw_address> candidates);
+
+        /// @brief Stop a running race without notifying its handler, closing every attempt.
+        void cancel();
+
+        [[nodiscard]] status get_status() const
+        {
+            return status_;
+        }
+
+        /// @brief Take the connected socket of the winning attempt.
+        /// @returns The connected socket, or an invalid socket if the race did not connect or it was already taken.
+        [[nodiscard]] socket take_socket()
+        {
+            return std::move(socket_);
+        }
+
+        /// @brief Retrieve the address the winning attempt connected to.
+        [[nodiscard]] const raw_address& get_address() const
+        {
+            return address_;
+        }
+
+        /// @brief Retrieve the number of attempts the last race started.
+        [[nodiscard]] std::size_t get_attempt_count() const
+        {
+            return attempts_.size();
+        }
+
+    private:
+        struct attempt;
+
+        struct race_timer : timer
+        {
+            connect_race* owner = nullptr;
+        };
+
+        event_loop& loop_;
+        connect_race_options options_;
+        race_handler handler_;
+        status status_ = status::idle;
+        std::vector<raw_address> candidates_;
+        std::vector<std::unique_ptr<attempt>> attempts_;
+        std::size_t pending_ = 0;
+        race_timer delay_timer_;
+        race_timer deadline_timer_;
+        socket socket_;
+        raw_address address_;
+
+        void start_next();
+        void on_attempt_ready(attempt& current, poller::poll_status poll);
+        void complete(status result, attempt* winner);
+        void close_attempts();
+
+        static void notify(io_waiter& self, poller::poll_status poll);
+        static void on_delay_expired(timer& self);
+        static void on_deadline_expired(timer& self);
+    };
+
+    /// @brief Awaitable that runs a connection race and completes once it has connected or failed.
+    class ASL_API connect_race_awaiter final
+    {
+    public:
+        connect_race_awaiter(connect_race& race, std::span<const raw_address> candidates)
+            : race_(race), candidates_(candidates)
+        {
+        }
+
+        /// @brief Destroy the awaitable, cancelling the race if the coroutine is destroyed before the race completes.
+        ~connect_race_awaiter();
+
+        connect_race_awaiter(const connect_race_awaiter&) = delete;
+        connect_race_awaiter& operator=(const connect_race_awaiter&) = delete;
+
+        bool await_ready()
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        bool await_resume() const
+        {
+            return race_.get_status() == connect_race::status::connected;
+        }
+
+    private:
+        connect_race& race_;
+        std::span<const raw_address> candidates_;
+        std::coroutine_handle<> handle_;
+        bool completed_ = false;
+
+        void on_race_completed(connect_race& race);
+
+        friend class connect_race;
+    };
+
+} // namespace jhoyt::asl
@@ -0,0 +1,241 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "common.hpp"
+#include "event_loop.hpp"
+#include "raw_address.hpp"
+#include "socket.hpp"
+
+namespace jhoyt::asl
+{
+
+    class connection_pool;
+
+    namespace detail
+    {
+        struct pool_destination;
+    } // namespace detail
+
+    /// @brief Type that owns a connection checked out of a connection pool.
+    ///
+    /// Check the connection back in with connection_pool::checkin once the exchange on it has completed; a connection
+    /// that is destroyed (or reset) instead is closed, and counts against the limit of its destination until then.
+    ///
+    /// @note The pool must outlive its connections.
+    class ASL_API pooled_connection final
+    {
+    public:
+        pooled_connection() = default;
+
+        ~pooled_connection();
+
+        pooled_connection(const pooled_connection&) = delete;
+        pooled_connection& operator=(const pooled_connection&) = delete;
+
+        pooled_connection(pooled_connection&& other) noexcept;
+        pooled_connection& operator=(pooled_connection&& other) noexcept;
+
+        /// @brief Check if the connection holds a connected socket; an empty connection is the outcome of a checkout
+        /// that failed to connect.
+        explicit operator bool() const
+        {
+            return destination_ != nullptr;
+        }
+
+        [[nodiscard]] socket& get_socket()
+        {
+            return sock_;
+        }
+
+        /// @brief Retrieve the address of the destination the connection is connected to.
+        [[nodiscard]] const raw_address& get_address() const;
+
+        /// @brief Close the connection without returning it to the pool.
+        void reset();
+
+    private:
+        detail::pool_destination* destination_ = nullptr;
+        socket sock_;
+
+        pooled_connection(detail::pool_destination* destination, socket sock)
+            : destination_(destination), sock_(std::move(sock))
+        {
+        }
+
+        friend class connection_pool;
+    };
+
+    /// @brief Type that represents a request to check out a connection, which is completed by a connection pool.
+    ///
+    /// Requests are intrusive: the pool queues every request that waits for a connection to a destination in one list,
+    /// so the request must remain valid until it has been completed or cancelled. The on_checkout field is set by the
+    /// owner; the remaining fields are managed by the pool.
+    struct checkout_request
+    {
+        /// @brief Called once with the connection, which is empty if connecting to the destination failed.
+        void (*on_checkout)(checkout_request& self, pooled_connection connection) = nullptr;
+
+        detail::pool_destination* destination = nullptr;
+        checkout_request* next = nullptr;
+    };
+
+    /// @brief Type that holds the settings of a connection pool.
+    struct connection_pool_options
+    {
+        /// @brief The most connections to one destination, counting idle, checked out and connecting ones; further
+        /// checkouts wait for a connection to be checked in.
+        std::size_t max_connections = 16;
+
+        /// @brief The most idle connections kept to one destination; connections checked in beyond it are closed.
+        std::size_t max_idle = 8;
+
+        /// @brief How many connections are opened ahead of demand: a checkout that leaves fewer idle or connecting
+        /// connections than this to its destination opens more in the background.
+        std::size_t spare_connections = 1;
+
+        /// @brief How long a connection may stay idle before it is closed.
+        std::chrono::milliseconds idle_timeout{30000};
+
+        /// @brief How long connecting may take before the attempt is abandoned.
+        std::chrono::milliseconds connect_timeout{5000};
+    };
+
+    class checkout_awaiter;
+
+    /// @brief Type that keeps warm connections to IPv4 and IPv6 destinations so that clients do not connect for every
+    /// exchange.
+    ///
+    /// Idle connections are watched by the event loop: an idle connection should never become readable, so one that
+    /// does has been closed (or reset) by its peer, or sent something no exchange asked for, and is closed without
+    /// reading from it. Connections are checked out most recently used first, so the least recently used ones are the
+    /// ones that reach the idle timeout when demand falls. When demand rises, a checkout that finds no idle connection
+    /// waits for a connection that is opened for it and, up to the per-destination limit, opens spare ones for the
+    /// checkouts that follow.
+    ///
+    /// The pool belongs to the thread of its event loop, so checking connections out and in takes no locks, and the
+    /// bookkeeping of a connection is recycled rather than allocated each time it is checked in.
+    ///
+    /// @note All functions must be called on the thread that runs the loop, and the pool must not be destroyed from a
+    /// checkout handler.
+    class ASL_API connection_pool final
+    {
+    public:
+        /// @brief Construct a new pool.
+        /// @param loop The event loop to watch connections on; it must outlive the pool.
+        /// @param options The settings of the pool.
+        explicit connection_pool(event_loop& loop, connection_pool_options options = {});
+
+        /// @brief Destroy the pool, closing its idle and connecting connections; requests that have not been
+        /// completed are dropped without being notified.
+        ~connection_pool();
+
+        connection_pool(const connection_pool&) = delete;
+        connection_pool& operator=(const connection_pool&) = delete;
+
+        /// @brief Inner type that holds statistics about the connections of a pool.
+        struct stats
+        {
+            std::uint64_t checkouts = 0;
+
+            /// @brief Checkouts served by a connection that had been used before.
+            std::uint64_t reused = 0;
+
+            /// @brief Checkouts that had to wait for a connection.
+            std::uint64_t waited = 0;
+
+            std::uint64_t connects = 0;
+            std::uint64_t connect_failures = 0;
+
+            /// @brief Idle connections closed because their peer closed them (or they became readable).
+            std::uint64_t peer_closed = 0;
+            std::uint64_t idle_expired = 0;
+        };
+
+        /// @brief Retrieve the statistics collected since construction.
+        [[nodiscard]] const stats& get_stats() const;
+
+        /// @brief Check out a connection to a destination.
+        ///
+        /// An idle connection completes the request before this returns (as does failing to even start connecting);
+        /// otherwise it is completed from the event loop once a connection has been opened or checked in, or with an
+        /// empty connection if connecting failed or timed out.
+        ///
+        /// @param destination The IPv4 or IPv6 address to connect to; any other address throws std::runtime_error.
+        /// @param request The request to complete; its on_checkout field must be set.
+        void checkout(const raw_address& destination, checkout_request& request);
+
+        /// @brief Cancel a request without notifying it. Cancelling a completed request has no effect.
+        ///
+        /// A connection being opened for the request carries on, and is kept idle once it has connected.
+        ///
+        /// @param request The request to cancel.
+        void cancel(checkout_request& request);
+
+        /// @brief Check out a connection, suspending until one is available.
+        /// @param destination The IPv4 or IPv6 address to connect to.
+        /// @returns Awaitable that produces the connection, which is empty if connecting failed.
+        checkout_awaiter async_checkout(const raw_address& destination);
+
+        /// @brief Return a connection to the pool.
+        ///
+        /// The connection goes to the oldest request waiting for its destination, or is kept idle. Only check in a
+        /// connection whose exchanges have completed and whose received data has been read: it is reused as is.
+        ///
+        /// @param connection The connection to return; it is left empty.
+        /// @param reusable False to close the connection instead, e.g. after an error or a response that ends it.
+        void checkin(pooled_connection& connection, bool reusable = true);
+
+        /// @brief Retrieve the number of idle connections to a destination.
+        [[nodiscard]] std::size_t get_idle_count(const raw_address& destination) const;
+
+        /// @brief Retrieve the number of connections to a destination, counting idle, checked out and connecting ones.
+        [[nodiscard]] std::size_t get_open_count(const raw_address& destination) const;
+
+    private:
+        struct impl;
+        std::unique_ptr<impl> pimpl_;
+    };
+
+    /// @brief Awaitable that checks out a connection and completes once one is available.
+    class ASL_API checkout_awaiter final : private checkout_request
+    {
+    public:
+        checkout_awaiter(connection_pool& pool, const raw_address& destination);
+
+        ~checkout_awaiter();
+
+        checkout_awaiter(const checkout_awaiter&) = delete;
+        checkout_awaiter& operator=(const checkout_awaiter&) = delete;
+
+        bool await_ready()
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        pooled_connection await_resume()
+        {
+            return std::move(result_);
+        }
+
+    private:
+        connection_pool& pool_;
+        raw_address destination_;
+        std::coroutine_handle<> handle_;
+        pooled_connection result_;
+        bool completed_ = false;
+
+        static void notify(checkout_request& self, pooled_connection connection);
+    };
+
+} // namespace jhoyt::asl
@@ -0,0 +1,153 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "common.hpp"
+#include "event_loop.hpp"
+#include "mpsc_queue.hpp"
+#include "raw_address.hpp"
+#include "runtime.hpp"
+#include "socket.hpp"
+#include "spsc_queue.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Enumeration that defines how a dispatcher chooses the worker for a new connection.
+    enum class placement_policy
+    {
+        /// @brief Hand connections to the workers in turn.
+        round_robin,
+
+        /// @brief Hand each connection to the worker with the fewest connections (see dispatcher::release).
+        least_loaded,
+
+        /// @brief Hand each connection to the worker pinned to the CPU that received its packets (SO_INCOMING_CPU),
+        /// falling back to round robin when the CPU is unknown or no worker is pinned to it.
+        incoming_cpu
+    };
+
+    /// @brief Enumeration that defines which threads may hand connections to a dispatcher.
+    enum class producer_mode
+    {
+        /// @brief Only a single thread calls dispatch; the per-worker queues are single-producer queues.
+        single,
+
+        /// @brief Any number of threads call dispatch; the per-worker queues are multi-producer queues.
+        multiple
+    };
+
+    /// @brief Type that holds the options used to construct a dispatcher.
+    struct dispatcher_options
+    {
+        placement_policy policy = placement_policy::round_robin;
+        producer_mode producers = producer_mode::single;
+
+        /// @brief The number of connections that can wait in each worker's queue.
+        std::size_t queue_capacity = 1024;
+    };
+
+    /// @brief Type that refers to an object receiving the connections handed to a worker.
+    ///
+    /// Use the dispatcher constructor that takes a handler object to create one; the stored function pointer calls the
+    /// handler's `on_connection(worker&, socket&, const raw_address&)` member directly.
+    struct connection_handler
+    {
+        void* object = nullptr;
+        void (*on_connection)(void* object, worker& w, socket& sock, const raw_address& addr) = nullptr;
+    };
+
+    /// @brief Type that hands accepted connections from acceptor threads to the workers of a runtime.
+    ///
+    /// Each worker has a bounded lock-free queue of connections. Handing over a connection never takes a lock or
+    /// allocates, and it only wakes the target worker when that worker had no connections waiting, so a burst of
+    /// accepts costs one wakeup per worker. On the worker thread the handler is called for every connection; it takes
+    /// ownership by moving from the socket. A socket left behind is closed and not counted as a connection of the worker.
+    ///
+    /// @note The runtime must be stopped before the dispatcher is destroyed.
+    class ASL_API dispatcher final
+    {
+    public:
+        /// @brief Construct a new dispatcher.
+        /// @param rt The runtime whose workers receive the connections.
+        /// @param handler The handler called on a worker thread for every connection handed to that worker.
+        /// @param options The options for the dispatcher.
+        dispatcher(runtime& rt, connection_handler handler, const dispatcher_options& options = {});
+
+        /// @brief Construct a new dispatcher with a handler object.
+        /// @param rt The runtime whose workers receive the connections.
+        /// @param handler Object whose `on_connection(worker&, socket&, const raw_address&)` member is called on a
+        /// worker thread for every connection; it must outlive the dispatcher.
+        /// @param options The options for the dispatcher.
+        template <typename Handler>
+        dispatcher(runtime& rt, Handler& handler, const dispatcher_options& options = {})
+            : dispatcher(rt,
+                         connection_handler{&handler,
+                                            [](void* object, worker& w, socket& sock, const raw_address& addr) {
+                                                static_cast<Handler*>(object)->on_connection(w, sock, addr);
+                                            }},
+                         options)
+        {
+        }
+
+        ~dispatcher();
+
+        dispatcher(const dispatcher&) = delete;
+        dispatcher& operator=(const dispatcher&) = delete;
+
+        /// @brief Hand a connection to a worker chosen by the placement policy.
+        ///
+        /// If the chosen worker's queue is full the remaining workers are tried in turn.
+        ///
+        /// @param sock The connected socket; it is moved from if the connection is handed over.
+        /// @param addr The address of the peer.
+        /// @returns The index of the worker that received the connection, or std::nullopt if every queue is full.
+        std::optional<std::size_t> dispatch(socket& sock, const raw_address& addr);
+
+        /// @brief Record that a connection handed to a worker has been closed.
+        ///
+        /// Only the least_loaded policy uses the connection counts; they may be released from any thread.
+        ///
+        /// @param worker_index The index of the worker that owned the connection.
+        void release(std::size_t worker_index);
+
+        /// @brief Retrieve the number of connections handed to a worker that have not been released.
+        [[nodiscard]] std::size_t get_load(std::size_t worker_index) const;
+
+    private:
+        struct accepted_connection
+        {
+            socket sock;
+            raw_address addr;
+        };
+
+        struct worker_state : posted_task
+        {
+            dispatcher* owner = nullptr;
+            worker* target = nullptr;
+            std::unique_ptr<spsc_queue<accepted_connection>> single_queue;
+            std::unique_ptr<mpsc_queue<accepted_connection>> multiple_queue;
+            alignas(k_cache_line_size) std::atomic<bool> scheduled{false};
+            std::atomic<std::size_t> load{0};
+        };
+
+        connection_handler handler_;
+        placement_policy policy_;
+        std::vector<std::unique_ptr<worker_state>> workers_;
+        std::atomic<std::size_t> next_{0};
+
+        std::size_t choose_worker(const socket& sock);
+        bool try_push(worker_state& state, accepted_connection& conn) const;
+        bool try_pop(worker_state& state, accepted_connection& conn) const;
+
+        static void drain(posted_task& self);
+    };
+
+} // namespace jhoyt::asl
@@ -0,0 +1,111 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "address.hpp"
+#include "common.hpp"
+#include "raw_address.hpp"
+
+/// The message and file formats behind the resolver: DNS queries and responses (RFC 1035), hosts files and the
+/// nameserver entries of resolv.conf.
+namespace jhoyt::asl::detail
+{
+
+    /// @brief The largest DNS message sent or received over UDP without extensions.
+    inline constexpr auto k_max_dns_message_size = std::size_t{512};
+
+    /// @brief Enumeration that represents the DNS record types the resolver works with.
+    enum class dns_record_type : std::uint16_t
+    {
+        a = 1,
+        cname = 5,
+        soa = 6,
+        aaaa = 28
+    };
+
+    /// @brief Enumeration that represents the response code of a DNS response.
+    enum class dns_response_code : std::uint8_t
+    {
+        no_error = 0,
+        format_error = 1,
+        server_failure = 2,
+        name_error = 3,
+        not_implemented = 4,
+        refused = 5
+    };
+
+    /// @brief The hosts of a name, in the order in which they were listed.
+    using dns_hosts = std::vector<std::variant<ipv4_host, ipv6_host>>;
+
+    /// @brief Type that holds what a DNS response says about the name and record type that were queried.
+    struct dns_response
+    {
+        dns_response_code code = dns_response_code::no_error;
+
+        /// @brief Whether the server cut the response short to fit it into a datagram.
+        bool truncated = false;
+
+        /// @brief The addresses of the queried record type, following CNAME records from the queried name.
+        dns_hosts hosts;
+
+        /// @brief For an answer, the smallest TTL of the records it was taken from; for a negative answer, the TTL
+        /// given by the SOA record of the authority section (RFC 2308), if there is one.
+        std::optional<std::uint32_t> ttl;
+    };
+
+    /// @brief Convert a name to the form in which it is looked up and compared: ASCII lower case, without a trailing
+    /// dot.
+    std::string normalize_dns_name(std::string_view name);
+
+    /// @brief Check if a name can be queried: one to 63 characters per label and at most 253 characters overall,
+    /// optionally followed by a dot.
+    bool is_valid_dns_name(std::string_view name);
+
+    /// @brief Write a recursive query for one record type of a name.
+    /// @param name The name to query.
+    /// @param id The identifier that the response has to echo.
+    /// @param type The record type to query.
+    /// @param out Buffer that receives the message.
+    /// @returns The number of bytes written to the front of the buffer, or zero if the name is not valid.
+    std::size_t write_dns_query(std::string_view name,
+                                std::uint16_t id,
+                                dns_record_type type,
+                                std::span<char, k_max_dns_message_size> out);
+
+    /// @brief Parse the response to a query written by write_dns_query.
+    /// @param data The bytes of the response.
+    /// @param id The identifier of the query.
+    /// @param name The name of the query.
+    /// @param type The record type of the query.
+    /// @returns The parsed response, or std::nullopt if the data is malformed or not a response to that query.
+    std::optional<dns_response> parse_dns_response(std::span<const char> data,
+                                                   std::uint16_t id,
+                                                   std::string_view name,
+                                                   dns_record_type type);
+
+    /// @brief Parse the text of a hosts file (e.g. /etc/hosts) into the hosts of each name.
+    ///
+    /// Each line holds an address followed by the names for it; text after a '#' is a comment. Names are normalized
+    /// (see normalize_dns_name), and lines whose address is malformed or has a zone id are skipped.
+    ///
+    /// @param text The text of the file.
+    /// @returns The hosts of every name that appears in the file.
+    std::unordered_map<std::string, dns_hosts> parse_hosts_file(std::string_view text);
+
+    /// @brief Parse the text of a resolv.conf file for the first nameserver with a numeric address.
+    /// @param text The text of the file.
+    /// @returns The address of the nameserver on port 53, or std::nullopt if there is none.
+    std::optional<raw_address> parse_resolv_conf(std::string_view text);
+
+} // namespace jhoyt::asl::detail
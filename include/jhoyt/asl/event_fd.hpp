@@ -0,0 +1,59 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstdint>
+
+#include "common.hpp"
+#include "socket_id.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that wraps a pollable event counter that any thread can signal.
+    ///
+    /// On Linux this is an eventfd; elsewhere it is emulated with a non-blocking pipe. Register get_id() with a poller
+    /// using poller::poll_type::event, which results in poller::poll_status::event_signaled once the counter is
+    /// non-zero, and call consume() to reset it.
+    class ASL_API event_fd final
+    {
+    public:
+        /// @brief Construct a new event counter.
+        /// @param initial The initial value of the counter.
+        explicit event_fd(std::uint64_t initial = 0);
+
+        ~event_fd();
+
+        event_fd(const event_fd&) = delete;
+        event_fd& operator=(const event_fd&) = delete;
+
+        event_fd(event_fd&& other) noexcept;
+        event_fd& operator=(event_fd&& other) noexcept;
+
+        /// @brief Retrieve the OS-level identifier to register with a poller.
+        [[nodiscard]] socket_id get_id() const
+        {
+            return read_id_;
+        }
+
+        /// @brief Add to the counter, waking any poller waiting on it; may be called from any thread.
+        ///
+        /// If the counter cannot take the value without blocking (it would overflow, or the emulation pipe is full)
+        /// the value is dropped; the counter is already non-zero in that case, so no wakeup is lost.
+        ///
+        /// @param value The amount to add; must not be zero.
+        void signal(std::uint64_t value = 1) const;
+
+        /// @brief Read and reset the counter without blocking.
+        /// @returns The value of the counter, or zero if it has not been signaled since the last call.
+        std::uint64_t consume() const;
+
+    private:
+        socket_id read_id_ = k_invalid_socket;
+        socket_id write_id_ = k_invalid_socket;
+
+        void close();
+    };
+
+} // namespace jhoyt::asl
@@ -0,0 +1,538 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+#include "poller.hpp"
+#include "raw_address.hpp"
+#include "socket.hpp"
+#include "socket_id.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that is notified by the event loop when a socket it waits on becomes ready.
+    ///
+    /// Waiters are intrusive: the event loop only stores a pointer to the waiter and calls the function pointer it
+    /// holds, so no allocation, virtual call or std::function is involved in dispatching an event.
+    struct io_waiter
+    {
+        void (*on_ready)(io_waiter& self, poller::poll_status status) = nullptr;
+    };
+
+    /// @brief Type that refers to an object handling every poll status of a socket registered with an event loop.
+    ///
+    /// Use event_loop::add_socket with a handler object to create one; the stored function pointer calls the handler's
+    /// `on_poll(socket_id, poller::poll_status)` member directly.
+    struct io_handler
+    {
+        void* object = nullptr;
+        void (*on_poll)(void* object, socket_id id, poller::poll_status status) = nullptr;
+    };
+
+    /// @brief Type that is notified by the event loop when a deadline has passed.
+    ///
+    /// Timers are intrusive: the type embedding (or deriving from) the timer must outlive its scheduling. The
+    /// remaining fields are managed by the event loop.
+    struct timer
+    {
+        static constexpr auto k_unscheduled = static_cast<std::size_t>(-1);
+
+        void (*on_expired)(timer& self) = nullptr;
+        std::chrono::steady_clock::time_point deadline{};
+        std::size_t heap_index = k_unscheduled;
+
+        /// @brief Check if the timer is currently scheduled on an event loop.
+        [[nodiscard]] bool is_scheduled() const
+        {
+            return heap_index != k_unscheduled;
+        }
+    };
+
+    /// @brief Type that represents a unit of work posted to an event loop to be run on a later iteration.
+    ///
+    /// Posted tasks are intrusive: the event loop links them into a queue through the next field, so posting does not
+    /// allocate.
+    struct posted_task
+    {
+        void (*run)(posted_task& self) = nullptr;
+        posted_task* next = nullptr;
+    };
+
+    class address_filter;
+
+    namespace detail
+    {
+        struct recv_operation;
+        struct send_operation;
+        struct accept_operation;
+    } // namespace detail
+
+    template <typename Operation>
+    class io_awaiter;
+
+    class connect_awaiter;
+
+    /// @brief Type that drives sockets, timers and posted tasks from a poller on a single thread.
+    ///
+    /// Sockets are either registered with a handler object, which is called for every poll status until the socket is
+    /// removed, or waited on by one-shot waiters. Each socket can have at most one read waiter and one write (or
+    /// connect) waiter at a time. The polling interest for a waited-on socket is derived from its current waiters and
+    /// only registered with the poller while there is a waiter, so a level-triggered poller never reports sockets that
+    /// nobody is waiting on.
+    ///
+    /// The async_* functions return awaitables for use in coroutines (see task). Each of them first tries the
+    /// non-blocking socket operation and only suspends the coroutine if the operation reports that it would block.
+    ///
+    /// @note All functions must be called on the thread that runs the loop.
+    class ASL_API event_loop final
+    {
+    public:
+        event_loop() = default;
+
+        event_loop(const event_loop&) = delete;
+        event_loop& operator=(const event_loop&) = delete;
+
+        /// @brief Inner type that holds statistics about the iterations the loop has run.
+        ///
+        /// The latency of an iteration is the time from the poller returning until every ready socket, expired timer
+        /// and posted task of that iteration has been handled; it excludes the time spent waiting in the poller. The
+        /// time spent waiting is split into the time spent spinning (see spin_options) and the time spent blocked in
+        /// the poller; spin_hits counts the waits that ended while spinning.
+        struct stats
+        {
+            std::uint64_t iterations = 0;
+            std::uint64_t events = 0;
+            std::uint64_t timers = 0;
+            std::uint64_t tasks = 0;
+            std::chrono::nanoseconds total_latency{};
+            std::chrono::nanoseconds max_latency{};
+            std::chrono::nanoseconds last_latency{};
+            std::uint64_t spin_hits = 0;
+            std::chrono::nanoseconds spin_time{};
+            std::chrono::nanoseconds blocked_time{};
+        };
+
+        /// @brief Retrieve the statistics collected since construction or the last call to reset_stats.
+        [[nodiscard]] const stats& get_stats() const
+        {
+            return stats_;
+        }
+
+        /// @brief Reset all collected statistics to zero.
+        void reset_stats()
+        {
+            stats_ = {};
+        }
+
+        /// @brief Inner type that holds the settings of the spin-then-block policy of the loop.
+        ///
+        /// When a policy is set, an iteration that would wait in the poller first polls without blocking for up to
+        /// the spin budget and only blocks once the budget is used up, which avoids the context switches of blocking
+        /// when events arrive close together. The budget adapts to the observed event rate: it is twice the average
+        /// time the loop waits for something to happen (limited to max_budget), and drops to min_budget while the
+        /// average wait is longer than max_budget, so a loop that goes idle stops burning CPU.
+        struct spin_options
+        {
+            /// @brief The longest the loop spins before blocking.
+            std::chrono::nanoseconds max_budget = std::chrono::microseconds{50};
+
+            /// @brief The shortest the loop spins before blocking, even when events are infrequent.
+            std::chrono::nanoseconds min_budget{};
+        };
+
+        /// @brief Set (or clear) the spin-then-block policy of the loop; by default the loop blocks right away.
+        ///
+        /// Spinning only affects how the loop waits in the poller. To also have the kernel busy-poll the device queue
+        /// of a socket, see socket::set_busy_poll_option.
+        ///
+        /// @param options The policy to use, or std::nullopt to always block.
+        void set_spin_options(const std::optional<spin_options>& options);
+
+        /// @brief Retrieve the current spin budget, which is zero if no spin policy is set.
+        [[nodiscard]] std::chrono::nanoseconds get_spin_budget() const
+        {
+            return spin_budget_;
+        }
+
+        /// @brief Register a socket with a handler that is called for every poll status of the socket.
+        /// @param id The OS-level identifier of the socket.
+        /// @param type The type of polling that should occur for the socket.
+        /// @param handler The handler to call.
+        /// @param mode When the socket should be reported; see poller::trigger_mode.
+        void add_socket(socket_id id,
+                        poller::poll_type type,
+                        io_handler handler,
+                        poller::trigger_mode mode = poller::trigger_mode::level);
+
+        /// @brief Register a socket with a handler object that is called for every poll status of the socket.
+        ///
+        /// The handler object must have a member `on_poll(socket_id, poller::poll_status)` and remain valid until the
+        /// socket is removed.
+        ///
+        /// @param id The OS-level identifier of the socket.
+        /// @param type The type of polling that should occur for the socket.
+        /// @param handler The handler object to call.
+        /// @param mode When the socket should be reported; see poller::trigger_mode.
+        template <typename Handler>
+        void add_socket(const socket_id id,
+                        const poller::poll_type type,
+                        Handler& handler,
+                        const poller::trigger_mode mode = poller::trigger_mode::level)
+        {
+            add_socket(id,
+                       type,
+                       io_handler{&handler,
+                                  [](void* object, const socket_id sock_id, const poller::poll_status status) {
+                                      static_cast<Handler*>(object)->on_poll(sock_id, status);
+                                  }},
+                       mode);
+        }
+
+        /// @brief Update the polling type for a socket registered with a handler.
+        /// @param id The OS-level identifier of the socket.
+        /// @param type The new type of polling that should occur for the socket.
+        void update_socket(socket_id id, poller::poll_type type);
+
+        /// @brief Re-arm an edge-triggered or one-shot socket registered with a handler, typically once the handler has
+        /// drained it until an operation reported that it would block.
+        /// @param id The OS-level identifier of the socket.
+        void rearm_socket(socket_id id);
+
+        /// @brief Remove a socket registered with a handler.
+        /// @param id The OS-level identifier of the socket.
+        void remove_socket(socket_id id);
+
+        /// @brief Inner enumeration that represents what a waiter is waiting for.
+        enum class wait_type
+        {
+            /// @brief Wait for the socket to have data to read (or a connection to accept).
+            read,
+
+            /// @brief Wait for the socket to be able to accept more data for writing.
+            write,
+
+            /// @brief Wait for an in-progress connection to succeed or fail.
+            connect
+        };
+
+        /// @brief Register a waiter for a socket.
+        ///
+        /// The waiter is notified once, the next time the socket is ready, and must register again to be notified
+        /// again. If storing the registration throws, the waiter is not registered.
+        ///
+        /// @param id The OS-level identifier of the socket to wait on.
+        /// @param type What to wait for.
+        /// @param waiter The waiter to notify; it must remain valid until it has been notified or cancelled.
+        void wait(socket_id id, wait_type type, io_waiter& waiter);
+
+        /// @brief Remove all waiters (or the handler) for a socket without notifying them, e.g. before the socket is
+        /// closed.
+        /// @param id The OS-level identifier of the socket.
+        void cancel(socket_id id);
+
+        /// @brief Check if any waiters are registered.
+        [[nodiscard]] bool has_waiters() const
+        {
+            return waiter_count_ > 0;
+        }
+
+        /// @brief Schedule a timer to expire at a point in time, replacing any previous schedule of the timer.
+        /// @param t The timer to schedule; it must remain valid until it has expired or been cancelled.
+        /// @param deadline The point in time at which the timer expires.
+        void schedule(timer& t, std::chrono::steady_clock::time_point deadline);
+
+        /// @brief Schedule a timer to expire after an amount of time, replacing any previous schedule of the timer.
+        /// @param t The timer to schedule; it must remain valid until it has expired or been cancelled.
+        /// @param delay The amount of time after which the timer expires.
+        template <typename Rep, typename Period>
+        void schedule_after(timer& t, const std::chrono::duration<Rep, Period>& delay)
+        {
+            schedule(t,
+                     std::chrono::steady_clock::now() +
+                         std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay));
+        }
+
+        /// @brief Cancel a scheduled timer without notifying it. Cancelling an unscheduled timer has no effect.
+        /// @param t The timer to cancel.
+        void cancel(timer& t);
+
+        /// @brief Post a task to be run on the next iteration of the loop.
+        /// @param task The task to run; it must remain valid until it has run.
+        void post(posted_task& task);
+
+        /// @brief Run a single iteration of the loop.
+        ///
+        /// Polls for ready sockets (waiting no longer than the timeout, the next timer deadline, or not at all when
+        /// tasks are posted), then notifies ready sockets, expires due timers and runs posted tasks.
+        ///
+        /// @param timeout The maximum amount of time to wait for a socket to become ready. A negative timeout waits
+        /// until something is ready.
+        /// @returns The number of socket events, timers and tasks that were handled.
+        std::size_t run_once(const std::chrono::nanoseconds& timeout);
+
+        /// @brief Run a single iteration of the loop.
+        /// @param timeout The maximum amount of time to wait for a socket to become ready.
+        /// @returns The number of socket events, timers and tasks that were handled.
+        template <typename Rep, typename Period>
+        std::size_t run_once(const std::chrono::duration<Rep, Period>& timeout)
+        {
+            return run_once(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout));
+        }
+
+        /// @brief Run iterations of the loop until stop() is called or there is nothing left to wait for.
+        void run();
+
+        /// @brief Make run() return once the current iteration has completed.
+        void stop()
+        {
+            stopped_ = true;
+        }
+
+        /// @brief Check if there are any sockets, waiters, timers or posted tasks left to handle.
+        [[nodiscard]] bool has_work() const
+        {
+            return waiter_count_ > 0 || handler_count_ > 0 || !timers_.empty() || posted_head_;
+        }
+
+        /// @brief Receive data on a socket, suspending until data is available.
+        /// @param sock The socket to receive on.
+        /// @param data Buffer for the received bytes.
+        /// @returns Awaitable that produces the result of socket::recv; it never produces transfer_status::blocked.
+        io_awaiter<detail::recv_operation> async_recv(socket& sock, std::span<char> data);
+
+        /// @brief Send data on a socket, suspending until at least some of it can be sent.
+        /// @param sock The socket to send on.
+        /// @param data The bytes to send.
+        /// @returns Awaitable that produces the result of socket::send; it never produces transfer_status::blocked.
+        io_awaiter<detail::send_operation> async_send(socket& sock, std::span<const char> data);
+
+        /// @brief Accept a new incoming connection, suspending until one is available.
+        /// @param listener The listening socket.
+        /// @param sock A socket object to update with the new incoming connection.
+        /// @param addr An address object to update with the new address for the connection.
+        /// @returns Awaitable that completes once a connection has been accepted.
+        io_awaiter<detail::accept_operation> async_accept(socket& listener, socket& sock, raw_address& addr);
+
+        /// @brief Accept a new incoming connection from an allowed peer, suspending until one is available.
+        ///
+        /// Connections from peers that the filter denies are closed as soon as they are accepted.
+        ///
+        /// @param listener The listening socket.
+        /// @param sock A socket object to update with the new incoming connection.
+        /// @param addr An address object to update with the new address for the connection.
+        /// @param filter The filter to check peers against; it must outlive the operation.
+        /// @returns Awaitable that completes once an allowed connection has been accepted.
+        io_awaiter<detail::accept_operation> async_accept(socket& listener,
+                                                          socket& sock,
+                                                          raw_address& addr,
+                                                          const address_filter& filter);
+
+        /// @brief Connect a socket to an address, suspending until the connection succeeds or fails.
+        /// @param sock The socket to connect.
+        /// @param addr The address to connect the socket to.
+        /// @returns Awaitable that produces true if the connection succeeded, otherwise false.
+        connect_awaiter async_connect(socket& sock, const raw_address& addr);
+
+    private:
+        struct registration
+        {
+            io_handler handler;
+            poller::poll_type handler_type = poller::poll_type::read;
+            poller::trigger_mode handler_mode = poller::trigger_mode::level;
+            io_waiter* reader = nullptr;
+            io_waiter* writer = nullptr;
+            bool connecting = false;
+            std::optional<poller::poll_type> polled_type;
+        };
+
+        poller poller_;
+        std::unordered_map<socket_id, registration> registrations_;
+        std::vector<socket_id> dirty_;
+        std::size_t waiter_count_ = 0;
+        std::size_t handler_count_ = 0;
+        std::vector<timer*> timers_;
+        std::optional<std::chrono::steady_clock::time_point> expiring_at_;
+        posted_task* posted_head_ = nullptr;
+        posted_task* posted_tail_ = nullptr;
+        bool stopped_ = false;
+        stats stats_;
+        std::optional<spin_options> spin_options_;
+        std::chrono::nanoseconds spin_budget_{};
+        std::chrono::nanoseconds average_wait_{};
+
+        void update_registrations();
+        std::span<const poller::poll_result> wait_for_events(std::chrono::nanoseconds timeout);
+        void adapt_spin_budget(std::chrono::nanoseconds wait);
+        std::size_t dispatch(std::span<const poller::poll_result> results);
+        std::size_t expire_timers(std::chrono::steady_clock::time_point now);
+        std::size_t run_posted();
+
+        void sift_up(std::size_t ix);
+        void sift_down(std::size_t ix);
+        void swap_timers(std::size_t first, std::size_t second);
+    };
+
+    namespace detail
+    {
+
+        struct recv_operation
+        {
+            socket* sock;
+            std::span<char> data;
+
+            std::optional<std::pair<socket::transfer_status, size_t>> operator()() const
+            {
+                const auto result = sock->recv(data);
+                if (result.first == socket::transfer_status::blocked)
+                {
+                    return std::nullopt;
+                }
+
+                return result;
+            }
+        };
+
+        struct send_operation
+        {
+            socket* sock;
+            std::span<const char> data;
+
+            std::optional<std::pair<socket::transfer_status, size_t>> operator()() const
+            {
+                const auto result = sock->send(data);
+                if (result.first == socket::transfer_status::blocked)
+                {
+                    return std::nullopt;
+                }
+
+                return result;
+            }
+        };
+
+        struct accept_operation
+        {
+            socket* listener;
+            socket* sock;
+            raw_address* addr;
+            const address_filter* filter = nullptr;
+
+            ASL_API std::optional<bool> operator()() const;
+        };
+
+    } // namespace detail
+
+    /// @brief Awaitable that retries a non-blocking socket operation each time its socket becomes ready.
+    ///
+    /// The operation is a callable returning a std::optional, where an empty optional means that the operation would
+    /// have blocked. Exceptions thrown by the operation are rethrown in the awaiting coroutine.
+    ///
+    /// @tparam Operation The type of the operation to perform.
+    template <typename Operation>
+    class io_awaiter final : private io_waiter
+    {
+    public:
+        using result_type = typename std::invoke_result_t<Operation&>::value_type;
+
+        io_awaiter(event_loop& loop, const socket_id id, const event_loop::wait_type type, Operation operation)
+            : io_waiter{&io_awaiter::notify}, loop_(loop), id_(id), type_(type), operation_(std::move(operation))
+        {
+        }
+
+        bool await_ready()
+        {
+            return try_complete();
+        }
+
+        void await_suspend(const std::coroutine_handle<> handle)
+        {
+            handle_ = handle;
+            loop_.wait(id_, type_, *this);
+        }
+
+        result_type await_resume()
+        {
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+
+            return std::move(*result_);
+        }
+
+    private:
+        event_loop& loop_;
+        socket_id id_;
+        event_loop::wait_type type_;
+        Operation operation_;
+        std::coroutine_handle<> handle_;
+        std::optional<result_type> result_;
+        std::exception_ptr error_;
+
+        bool try_complete()
+        {
+            try
+            {
+                result_ = operation_();
+                return result_.has_value();
+            }
+            catch (...)
+            {
+                error_ = std::current_exception();
+                return true;
+            }
+        }
+
+        static void notify(io_waiter& self, poller::poll_status)
+        {
+            auto& awaiter = static_cast<io_awaiter&>(self);
+            if (awaiter.try_complete())
+            {
+                awaiter.handle_.resume();
+            }
+            else
+            {
+                awaiter.loop_.wait(awaiter.id_, awaiter.type_, awaiter);
+            }
+        }
+    };
+
+    /// @brief Awaitable that connects a socket and completes once the connection has succeeded or failed.
+    class ASL_API connect_awaiter final : private io_waiter
+    {
+    public:
+        connect_awaiter(event_loop& loop, socket& sock, const raw_address& addr)
+            : io_waiter{&connect_awaiter::notify}, loop_(loop), sock_(sock), addr_(addr)
+        {
+        }
+
+        bool await_ready();
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        bool await_resume();
+
+    private:
+        event_loop& loop_;
+        socket& sock_;
+        const raw_address& addr_;
+        std::coroutine_handle<> handle_;
+        bool connected_ = false;
+        std::exception_ptr error_;
+
+        static void notify(io_waiter& self, poller::poll_status status);
+    };
+
+} // namespace jhoyt::asl
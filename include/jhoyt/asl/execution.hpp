@@ -0,0 +1,375 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <span>
+#include <utility>
+
+#include <stdexec/execution.hpp>
+
+#include "event_loop.hpp"
+#include "raw_address.hpp"
+#include "socket.hpp"
+
+namespace jhoyt::asl
+{
+
+    class loop_scheduler;
+
+    namespace detail
+    {
+
+        /// Environment of every sender created by a loop_scheduler; it reports the scheduler as the place where the
+        /// sender completes so that algorithms such as let_value and when_all can schedule onto the same loop.
+        struct loop_sender_env
+        {
+            event_loop* loop;
+
+            [[nodiscard]] loop_scheduler
+                query(stdexec::get_completion_scheduler_t<stdexec::set_value_t>) const noexcept;
+        };
+
+        template <typename Receiver>
+        class schedule_operation final : private posted_task
+        {
+        public:
+            using operation_state_concept = stdexec::operation_state_t;
+
+            schedule_operation(event_loop& loop, Receiver rcvr)
+                : posted_task{&schedule_operation::run_task}, loop_(loop), rcvr_(std::move(rcvr))
+            {
+            }
+
+            schedule_operation(const schedule_operation&) = delete;
+            schedule_operation& operator=(const schedule_operation&) = delete;
+
+            void start() & noexcept
+            {
+                loop_.post(*this);
+            }
+
+        private:
+            event_loop& loop_;
+            Receiver rcvr_;
+
+            static void run_task(posted_task& self)
+            {
+                stdexec::set_value(std::move(static_cast<schedule_operation&>(self).rcvr_));
+            }
+        };
+
+        struct schedule_sender
+        {
+            using sender_concept = stdexec::sender_t;
+            using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t()>;
+
+            event_loop* loop;
+
+            template <stdexec::receiver Receiver>
+            schedule_operation<Receiver> connect(Receiver rcvr) const
+            {
+                return {*loop, std::move(rcvr)};
+            }
+
+            [[nodiscard]] loop_sender_env get_env() const noexcept
+            {
+                return {loop};
+            }
+        };
+
+        /// Operation state that performs a non-blocking socket operation and, if it would block, waits on the event
+        /// loop and retries. The operation state is the waiter, so starting it does not allocate.
+        template <typename Operation, typename Receiver>
+        class io_operation final : private io_waiter
+        {
+        public:
+            using operation_state_concept = stdexec::operation_state_t;
+
+            io_operation(event_loop& loop,
+                         const socket_id id,
+                         const event_loop::wait_type type,
+                         Operation operation,
+                         Receiver rcvr)
+                : io_waiter{&io_operation::notify}, loop_(loop), id_(id), type_(type),
+                  operation_(std::move(operation)), rcvr_(std::move(rcvr))
+            {
+            }
+
+            io_operation(const io_operation&) = delete;
+            io_operation& operator=(const io_operation&) = delete;
+
+            void start() & noexcept
+            {
+                if (!try_complete())
+                {
+                    wait();
+                }
+            }
+
+        private:
+            event_loop& loop_;
+            socket_id id_;
+            event_loop::wait_type type_;
+            Operation operation_;
+            Receiver rcvr_;
+
+            bool try_complete() noexcept
+            {
+                try
+                {
+                    auto result = operation_();
+                    if (!result)
+                    {
+                        return false;
+                    }
+
+                    Operation::complete(std::move(rcvr_), std::move(*result));
+                }
+                catch (...)
+                {
+                    stdexec::set_error(std::move(rcvr_), std::current_exception());
+                }
+
+                return true;
+            }
+
+            /// Registering with the loop may throw (it stores the registration), which completes the operation with
+            /// the error instead.
+            void wait() noexcept
+            {
+                try
+                {
+                    loop_.wait(id_, type_, *this);
+                }
+                catch (...)
+                {
+                    stdexec::set_error(std::move(rcvr_), std::current_exception());
+                }
+            }
+
+            static void notify(io_waiter& self, poller::poll_status)
+            {
+                auto& op = static_cast<io_operation&>(self);
+                if (!op.try_complete())
+                {
+                    op.wait();
+                }
+            }
+        };
+
+        /// Operations adapt the awaitable operations of the event loop to the values a sender completes with.
+        template <typename Operation>
+        struct transfer_sender_operation : Operation
+        {
+            template <typename Receiver>
+            static void complete(Receiver&& rcvr, const std::pair<socket::transfer_status, size_t> result)
+            {
+                stdexec::set_value(std::forward<Receiver>(rcvr), result.first, result.second);
+            }
+        };
+
+        using recv_sender_operation = transfer_sender_operation<recv_operation>;
+        using send_sender_operation = transfer_sender_operation<send_operation>;
+
+        struct accept_sender_operation : accept_operation
+        {
+            template <typename Receiver>
+            static void complete(Receiver&& rcvr, bool)
+            {
+                stdexec::set_value(std::forward<Receiver>(rcvr));
+            }
+        };
+
+        template <typename Operation, typename... Values>
+        struct io_sender
+        {
+            using sender_concept = stdexec::sender_t;
+            using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t(Values...),
+                                                                         stdexec::set_error_t(std::exception_ptr)>;
+
+            event_loop* loop;
+            socket_id id;
+            event_loop::wait_type type;
+            Operation operation;
+
+            template <stdexec::receiver Receiver>
+            io_operation<Operation, Receiver> connect(Receiver rcvr) const
+            {
+                return {*loop, id, type, operation, std::move(rcvr)};
+            }
+
+            [[nodiscard]] loop_sender_env get_env() const noexcept
+            {
+                return {loop};
+            }
+        };
+
+        template <typename Receiver>
+        class connect_operation final : private io_waiter
+        {
+        public:
+            using operation_state_concept = stdexec::operation_state_t;
+
+            connect_operation(event_loop& loop, socket& sock, const raw_address& addr, Receiver rcvr)
+                : io_waiter{&connect_operation::notify}, loop_(loop), sock_(sock), addr_(addr), rcvr_(std::move(rcvr))
+            {
+            }
+
+            connect_operation(const connect_operation&) = delete;
+            connect_operation& operator=(const connect_operation&) = delete;
+
+            void start() & noexcept
+            {
+                try
+                {
+                    if (sock_.connect(addr_) == socket::connect_status::connected)
+                    {
+                        stdexec::set_value(std::move(rcvr_), true);
+                        return;
+                    }
+
+                    loop_.wait(sock_.get_id(), event_loop::wait_type::connect, *this);
+                }
+                catch (...)
+                {
+                    stdexec::set_error(std::move(rcvr_), std::current_exception());
+                }
+            }
+
+        private:
+            event_loop& loop_;
+            socket& sock_;
+            raw_address addr_;
+            Receiver rcvr_;
+
+            static void notify(io_waiter& self, const poller::poll_status status)
+            {
+                auto& op = static_cast<connect_operation&>(self);
+                stdexec::set_value(std::move(op.rcvr_), status == poller::poll_status::connection_succeeded);
+            }
+        };
+
+        struct connect_sender
+        {
+            using sender_concept = stdexec::sender_t;
+            using completion_signatures =
+                stdexec::completion_signatures<stdexec::set_value_t(bool), stdexec::set_error_t(std::exception_ptr)>;
+
+            event_loop* loop;
+            socket* sock;
+            raw_address addr;
+
+            template <stdexec::receiver Receiver>
+            connect_operation<Receiver> connect(Receiver rcvr) const
+            {
+                return {*loop, *sock, addr, std::move(rcvr)};
+            }
+
+            [[nodiscard]] loop_sender_env get_env() const noexcept
+            {
+                return {loop};
+            }
+        };
+
+    } // namespace detail
+
+    /// @brief Type that exposes an event loop as a std::execution (P2300) scheduler and socket operations as senders.
+    ///
+    /// Every sender completes on the thread running the event loop. Socket senders first try the non-blocking socket
+    /// operation when started and only wait on the loop if it would block; their operation states are registered with
+    /// the loop intrusively, so connecting and starting a sender does not allocate.
+    ///
+    /// Socket senders complete with set_error(std::exception_ptr) when the underlying socket function throws.
+    class loop_scheduler final
+    {
+    public:
+        using scheduler_concept = stdexec::scheduler_t;
+
+        /// @brief Construct a scheduler for an event loop.
+        /// @param loop The event loop that runs the work; it must outlive the scheduler and its senders.
+        explicit loop_scheduler(event_loop& loop) : loop_(&loop)
+        {
+        }
+
+        /// @brief Retrieve the event loop of this scheduler.
+        [[nodiscard]] event_loop& get_loop() const
+        {
+            return *loop_;
+        }
+
+        /// @brief Create a sender that completes on the next iteration of the event loop.
+        [[nodiscard]] detail::schedule_sender schedule() const noexcept
+        {
+            return {loop_};
+        }
+
+        /// @brief Create a sender that receives data on a socket.
+        /// @param sock The socket to receive on.
+        /// @param data Buffer for the received bytes.
+        /// @returns Sender that completes with the transfer status and byte count of socket::recv (never
+        /// transfer_status::blocked).
+        [[nodiscard]] auto recv(socket& sock, const std::span<char> data) const
+        {
+            return detail::io_sender<detail::recv_sender_operation, socket::transfer_status, size_t>{
+                loop_, sock.get_id(), event_loop::wait_type::read, {{&sock, data}}};
+        }
+
+        /// @brief Create a sender that sends data on a socket.
+        /// @param sock The socket to send on.
+        /// @param data The bytes to send.
+        /// @returns Sender that completes with the transfer status and byte count of socket::send (never
+        /// transfer_status::blocked).
+        [[nodiscard]] auto send(socket& sock, const std::span<const char> data) const
+        {
+            return detail::io_sender<detail::send_sender_operation, socket::transfer_status, size_t>{
+                loop_, sock.get_id(), event_loop::wait_type::write, {{&sock, data}}};
+        }
+
+        /// @brief Create a sender that accepts a new incoming connection.
+        /// @param listener The listening socket.
+        /// @param sock A socket object to update with the new incoming connection.
+        /// @param addr An address object to update with the new address for the connection.
+        /// @returns Sender that completes without values once a connection has been accepted.
+        [[nodiscard]] auto accept(socket& listener, socket& sock, raw_address& addr) const
+        {
+            return detail::io_sender<detail::accept_sender_operation>{
+                loop_, listener.get_id(), event_loop::wait_type::read, {{&listener, &sock, &addr}}};
+        }
+
+        /// @brief Create a sender that accepts a new incoming connection from a peer the filter allows.
+        /// @param listener The listening socket.
+        /// @param sock A socket object to update with the new incoming connection.
+        /// @param addr An address object to update with the new address for the connection.
+        /// @param filter The filter to check peers against; connections from denied peers are closed.
+        /// @returns Sender that completes without values once an allowed connection has been accepted.
+        [[nodiscard]] auto accept(socket& listener, socket& sock, raw_address& addr, const address_filter& filter) const
+        {
+            return detail::io_sender<detail::accept_sender_operation>{
+                loop_, listener.get_id(), event_loop::wait_type::read, {{&listener, &sock, &addr, &filter}}};
+        }
+
+        /// @brief Create a sender that connects a socket to an address.
+        /// @param sock The socket to connect.
+        /// @param addr The address to connect the socket to.
+        /// @returns Sender that completes with true if the connection succeeded, otherwise false.
+        [[nodiscard]] detail::connect_sender connect(socket& sock, const raw_address& addr) const
+        {
+            return {loop_, &sock, addr};
+        }
+
+        bool operator==(const loop_scheduler&) const = default;
+
+    private:
+        event_loop* loop_;
+    };
+
+    inline loop_scheduler
+        detail::loop_sender_env::query(stdexec::get_completion_scheduler_t<stdexec::set_value_t>) const noexcept
+    {
+        return loop_scheduler{*loop};
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,219 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace jhoyt::asl
+{
+
+    /// @brief Enumeration that represents the outcome of decoding a frame (or frame header).
+    enum class frame_status
+    {
+        /// @brief A complete frame is available at the front of the data.
+        complete,
+
+        /// @brief More data must be received before the frame is complete.
+        incomplete,
+
+        /// @brief The frame header announces a payload larger than the allowed maximum.
+        too_large,
+
+        /// @brief The frame header is not valid for the chosen header format.
+        malformed
+    };
+
+    /// @brief Type that represents the result of decoding a frame header.
+    struct frame_header_result
+    {
+        frame_status status;
+        std::size_t header_size;
+        std::size_t payload_size;
+    };
+
+    /// @brief Concept that a frame header format must satisfy to be used with the framer.
+    template <typename T>
+    concept frame_header = requires(std::span<const char> data, std::size_t payload_size, std::span<char> out) {
+        { T::k_max_size } -> std::convertible_to<std::size_t>;
+        { T::decode(data) } -> std::same_as<frame_header_result>;
+        { T::encode(payload_size, out) } -> std::same_as<std::size_t>;
+    };
+
+    /// @brief Frame header format that stores the payload length as an unsigned LEB128 variable-length integer.
+    struct varint_header
+    {
+        static constexpr auto k_max_size = std::size_t{(std::numeric_limits<std::size_t>::digits + 6) / 7};
+
+        static constexpr frame_header_result decode(const std::span<const char> data)
+        {
+            auto value = std::size_t{0};
+            for (auto ix = std::size_t{0}; ix < k_max_size; ++ix)
+            {
+                if (ix == data.size())
+                {
+                    return {frame_status::incomplete, 0, 0};
+                }
+
+                const auto byte = static_cast<std::uint8_t>(data[ix]);
+                const auto bits = static_cast<std::size_t>(byte & 0x7f);
+                const auto shift = 7 * ix;
+                if (shift > 0 && (bits >> (std::numeric_limits<std::size_t>::digits - shift)) != 0)
+                {
+                    return {frame_status::malformed, 0, 0};
+                }
+
+                value |= bits << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return {frame_status::complete, ix + 1, value};
+                }
+            }
+
+            return {frame_status::malformed, 0, 0};
+        }
+
+        static constexpr std::size_t encode(std::size_t payload_size, const std::span<char> out)
+        {
+            auto ix = std::size_t{0};
+            while (payload_size >= 0x80)
+            {
+                out[ix++] = static_cast<char>((payload_size & 0x7f) | 0x80);
+                payload_size >>= 7;
+            }
+
+            out[ix++] = static_cast<char>(payload_size);
+            return ix;
+        }
+    };
+
+    /// @brief Frame header format that stores the payload length as a fixed-size unsigned integer.
+    /// @tparam UInt The unsigned integer type used on the wire.
+    /// @tparam Order The byte order of the integer on the wire.
+    template <std::unsigned_integral UInt, std::endian Order>
+    struct fixed_header
+    {
+        static constexpr auto k_max_size = sizeof(UInt);
+
+        static constexpr frame_header_result decode(const std::span<const char> data)
+        {
+            if (data.size() < k_max_size)
+            {
+                return {frame_status::incomplete, 0, 0};
+            }
+
+            auto value = UInt{0};
+            for (auto ix = std::size_t{0}; ix < k_max_size; ++ix)
+            {
+                const auto byte = static_cast<UInt>(static_cast<std::uint8_t>(data[ix]));
+                const auto shift = Order == std::endian::big ? 8 * (k_max_size - 1 - ix) : 8 * ix;
+                value |= static_cast<UInt>(byte << shift);
+            }
+
+            return {frame_status::complete, k_max_size, static_cast<std::size_t>(value)};
+        }
+
+        static constexpr std::size_t encode(const std::size_t payload_size, const std::span<char> out)
+        {
+            assert(payload_size <= std::numeric_limits<UInt>::max());
+
+            for (auto ix = std::size_t{0}; ix < k_max_size; ++ix)
+            {
+                const auto shift = Order == std::endian::big ? 8 * (k_max_size - 1 - ix) : 8 * ix;
+                out[ix] = static_cast<char>((payload_size >> shift) & 0xff);
+            }
+
+            return k_max_size;
+        }
+    };
+
+    using u16_be_header = fixed_header<std::uint16_t, std::endian::big>;
+    using u16_le_header = fixed_header<std::uint16_t, std::endian::little>;
+    using u32_be_header = fixed_header<std::uint32_t, std::endian::big>;
+    using u32_le_header = fixed_header<std::uint32_t, std::endian::little>;
+
+    /// @brief Type that represents a single frame decoded by the framer.
+    struct frame_result
+    {
+        /// @brief The outcome of the decode; the remaining fields are only meaningful for frame_status::complete.
+        frame_status status;
+
+        /// @brief View of the frame payload inside the decoded data (no bytes are copied).
+        std::span<const char> payload;
+
+        /// @brief Total number of bytes (header and payload) that the frame occupies at the front of the data.
+        std::size_t size;
+    };
+
+    /// @brief Type that splits a received byte stream into length-prefixed frames without copying.
+    ///
+    /// The framer does not own any storage. Each call to next() inspects the front of the provided data and, if a
+    /// complete frame is present, returns a view of its payload that remains valid for as long as the underlying data
+    /// does. The caller is expected to discard `size` bytes from the front of its buffer before asking for the next
+    /// frame (see recv_buffer::consume).
+    ///
+    /// @tparam Header The frame header format (e.g. varint_header or u32_be_header).
+    template <frame_header Header>
+    class framer final
+    {
+    public:
+        static constexpr auto k_default_max_frame_size = std::size_t{16 * 1024 * 1024};
+
+        /// @brief Construct a new framer.
+        /// @param max_payload_size The largest payload size that will be accepted before reporting
+        /// frame_status::too_large.
+        constexpr explicit framer(const std::size_t max_payload_size = k_default_max_frame_size)
+            : max_payload_size_(max_payload_size)
+        {
+        }
+
+        /// @brief Retrieve the largest payload size accepted by this framer.
+        [[nodiscard]] constexpr auto get_max_payload_size() const
+        {
+            return max_payload_size_;
+        }
+
+        /// @brief Attempt to decode the frame at the front of a sequence of received bytes.
+        /// @param data Sequence of received bytes, starting at a frame boundary.
+        /// @returns The decode result. When the status is frame_status::complete the payload refers into data.
+        [[nodiscard]] constexpr frame_result next(const std::span<const char> data) const
+        {
+            const auto [status, header_size, payload_size] = Header::decode(data);
+            if (status != frame_status::complete)
+            {
+                return {status, {}, 0};
+            }
+
+            if (payload_size > max_payload_size_)
+            {
+                return {frame_status::too_large, {}, 0};
+            }
+
+            if (data.size() - header_size < payload_size)
+            {
+                return {frame_status::incomplete, {}, 0};
+            }
+
+            return {frame_status::complete, data.subspan(header_size, payload_size), header_size + payload_size};
+        }
+
+        /// @brief Write the header for a payload of the given size.
+        /// @param payload_size The size of the payload that will follow the header.
+        /// @param out Buffer that receives the header bytes; it must hold at least Header::k_max_size bytes.
+        /// @returns The number of header bytes written to the front of out.
+        static constexpr std::size_t encode_header(const std::size_t payload_size, const std::span<char> out)
+        {
+            return Header::encode(payload_size, out);
+        }
+
+    private:
+        std::size_t max_payload_size_;
+    };
+
+} // namespace jhoyt::asl
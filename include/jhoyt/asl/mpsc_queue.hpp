@@ -0,0 +1,121 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "common.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that represents a bounded, lock-free queue with any number of producer threads and a single
+    /// consumer thread.
+    ///
+    /// Every slot carries a sequence number that tells producers whether the slot is free for the position they
+    /// claimed and tells the consumer whether the element at its position has been published, so producers only
+    /// contend on a single compare-and-swap of the tail position.
+    ///
+    /// @tparam T The element type; it must be default constructible and move assignable.
+    template <typename T>
+    class mpsc_queue final
+    {
+    public:
+        /// @brief Construct a new queue.
+        /// @param capacity The minimum number of elements the queue can hold; it is rounded up to a power of two.
+        explicit mpsc_queue(const std::size_t capacity)
+            : capacity_(std::bit_ceil(std::max<std::size_t>(capacity, 2))), mask_(capacity_ - 1),
+              slots_(std::make_unique<slot[]>(capacity_))
+        {
+            for (auto ix = std::size_t{0}; ix < capacity_; ++ix)
+            {
+                slots_[ix].sequence.store(ix, std::memory_order_relaxed);
+            }
+        }
+
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+        /// @brief Retrieve the number of elements the queue can hold.
+        [[nodiscard]] std::size_t get_capacity() const
+        {
+            return capacity_;
+        }
+
+        /// @brief Check if the queue is empty; only exact when called by the consumer.
+        [[nodiscard]] bool empty() const
+        {
+            const auto& s = slots_[head_ & mask_];
+            return s.sequence.load(std::memory_order_acquire) != head_ + 1;
+        }
+
+        /// @brief Add an element to the back of the queue; may be called from any thread.
+        /// @param value The element to add; it is only moved from if the push succeeds.
+        /// @returns True if the element was added, or false if the queue is full.
+        bool try_push(T& value)
+        {
+            auto tail = tail_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                auto& s = slots_[tail & mask_];
+                const auto sequence = s.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - tail);
+                if (diff == 0)
+                {
+                    if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                    {
+                        s.value = std::move(value);
+                        s.sequence.store(tail + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    tail = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// @brief Remove the element at the front of the queue; must only be called by the consumer.
+        /// @param value Object that is assigned the removed element.
+        /// @returns True if an element was removed, or false if the queue is empty.
+        bool try_pop(T& value)
+        {
+            auto& s = slots_[head_ & mask_];
+            if (s.sequence.load(std::memory_order_acquire) != head_ + 1)
+            {
+                return false;
+            }
+
+            value = std::move(s.value);
+            s.sequence.store(head_ + capacity_, std::memory_order_release);
+            ++head_;
+            return true;
+        }
+
+    private:
+        struct slot
+        {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        std::size_t capacity_;
+        std::size_t mask_;
+        std::unique_ptr<slot[]> slots_;
+
+        alignas(k_cache_line_size) std::atomic<std::size_t> tail_{0};
+        alignas(k_cache_line_size) std::size_t head_ = 0;
+    };
+
+} // namespace jhoyt::asl
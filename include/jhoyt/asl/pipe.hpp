@@ -0,0 +1,71 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include "common.hpp"
+#include "socket.hpp"
+#include "socket_id.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that wraps a non-blocking, unidirectional pipe, for example to pass bytes between threads.
+    ///
+    /// Register get_read_id() with a poller using poller::poll_type::read and get_write_id() using
+    /// poller::poll_type::write; they result in poller::poll_status::ready_to_read and ready_to_write as for a socket.
+    /// Writes of up to PIPE_BUF bytes are atomic, so several threads may write records of that size to one pipe.
+    class ASL_API pipe final
+    {
+    public:
+        pipe();
+        ~pipe();
+
+        pipe(const pipe&) = delete;
+        pipe& operator=(const pipe&) = delete;
+
+        pipe(pipe&& other) noexcept;
+        pipe& operator=(pipe&& other) noexcept;
+
+        /// @brief Retrieve the OS-level identifier of the read end, to register with a poller.
+        [[nodiscard]] socket_id get_read_id() const
+        {
+            return read_id_;
+        }
+
+        /// @brief Retrieve the OS-level identifier of the write end, to register with a poller.
+        [[nodiscard]] socket_id get_write_id() const
+        {
+            return write_id_;
+        }
+
+        /// @brief Write bytes to the pipe without blocking.
+        /// @param data The bytes to write.
+        /// @returns Pair of the transfer status and the number of bytes written. The status is
+        /// socket::transfer_status::blocked if the pipe is full, or disconnected if the read end has been closed (as
+        /// for sockets, the process must ignore SIGPIPE to observe that).
+        std::pair<socket::transfer_status, std::size_t> write(std::span<const char> data) const;
+
+        /// @brief Read bytes from the pipe without blocking.
+        /// @param data Buffer for the bytes that are read.
+        /// @returns Pair of the transfer status and the number of bytes read. The status is
+        /// socket::transfer_status::blocked if the pipe is empty, or disconnected if the write end has been closed
+        /// and everything has been read.
+        std::pair<socket::transfer_status, std::size_t> read(std::span<char> data) const;
+
+        /// @brief Close the write end, so that the reader sees socket::transfer_status::disconnected once it has read
+        /// everything.
+        void close_write();
+
+    private:
+        socket_id read_id_ = k_invalid_socket;
+        socket_id write_id_ = k_invalid_socket;
+
+        void close();
+    };
+
+} // namespace jhoyt::asl
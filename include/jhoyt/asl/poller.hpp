@@ -4,6 +4,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <span>
 
@@ -14,10 +15,40 @@ namespace jhoyt::asl
 {
 
     /// @brief Type that provides polling capabilities for sets of sockets.
+    ///
+    /// Besides sockets, a poller can wait on the other pollable sources of this library (event_fd, timer_fd,
+    /// signal_fd and pipe), identified by their OS-level identifier and polled with a matching poll_type, so that a
+    /// single thread can block on all of them at once.
+    ///
+    /// By default a poller must only be used from a single thread. A poller constructed with
+    /// threading_mode::thread_safe accepts add_socket, update_socket and remove_socket from any thread: the changes are
+    /// pushed onto a lock-free command queue and applied, in order, by the polling thread at the start of the next
+    /// poll. A change made from another thread wakes a poll that is blocked waiting, and neither side takes a lock.
     class ASL_API poller final
     {
     public:
+        /// @brief Inner enumeration that defines which threads may change the polling set.
+        enum class threading_mode
+        {
+            /// @brief All functions are called on one thread; changes take effect immediately.
+            single_thread,
+
+            /// @brief Changes to the polling set may be made from any thread; they take effect at the start of the
+            /// next poll, which must still be called from a single thread.
+            thread_safe
+        };
+
+        static constexpr auto k_default_command_capacity = std::size_t{4096};
+
         poller();
+
+        /// @brief Construct a new poller.
+        /// @param mode Which threads may change the polling set.
+        /// @param command_capacity The number of pending changes the command queue of a thread-safe poller can hold;
+        /// a thread making a change while the queue is full waits for the polling thread to apply the queued ones,
+        /// except for the polling thread itself (the thread of the latest poll), which applies them right away.
+        explicit poller(threading_mode mode, std::size_t command_capacity = k_default_command_capacity);
+
         ~poller();
 
         poller(const poller&) = delete;
@@ -39,19 +70,60 @@ namespace jhoyt::asl
 
             /// @brief Poll for write availability. This type will result in poll_status::ready_to_write if the socket
             /// can accept additioanl data for writing.
-            read_write
+            read_write,
+
+            /// @brief Poll for write availability only. This type will result in poll_status::ready_to_write if the
+            /// socket can accept additional data for writing, without reporting read availability.
+            write,
+
+            /// @brief Poll an event_fd. This type will result in poll_status::event_signaled once the event counter
+            /// has been signaled.
+            event,
+
+            /// @brief Poll a timer_fd. This type will result in poll_status::timer_expired once the timer has expired.
+            timer,
+
+            /// @brief Poll a signal_fd. This type will result in poll_status::signal_received while a signal is
+            /// pending.
+            signal
+        };
+
+        /// @brief Inner enumeration that defines when a socket in the polling set is reported.
+        ///
+        /// The poll() backend emulates the edge-triggered and one-shot modes by disarming what it has reported until
+        /// the socket is re-armed, so their contract is the same as for epoll with EPOLLET or EPOLLONESHOT plus one
+        /// rule: once an operation on the socket reports that it would block, call rearm_socket. Adding a socket (for
+        /// example after moving it to another poller) arms it, so readiness that arose in the meantime is reported.
+        enum class trigger_mode
+        {
+            /// @brief The socket is reported on every poll for as long as it is ready.
+            level,
+
+            /// @brief Each readiness condition (read or write) is reported once, and then again only after the
+            /// socket has been re-armed, which should happen after draining it until an operation blocks.
+            edge,
+
+            /// @brief The socket is reported once, after which it is not polled at all until it has been re-armed or
+            /// updated.
+            one_shot
         };
 
         /// @brief Add a new socket to the polling set.
         /// @param id The OS-level identifier for the socket to poll.
         /// @param type The type of polling that should occur for the socket.
-        void add_socket(socket_id id, poll_type type);
+        /// @param mode When the socket should be reported.
+        void add_socket(socket_id id, poll_type type, trigger_mode mode = trigger_mode::level);
 
-        /// @brief Update the polling type for a specific socket in the polling set.
+        /// @brief Update the polling type for a specific socket in the polling set; this also re-arms the socket.
         /// @param id The OS-level identifier for the socket to poll.
         /// @param type The new type of polling that should occur for the socket.
         void update_socket(socket_id id, poll_type type);
 
+        /// @brief Re-arm a socket registered with trigger_mode::edge or trigger_mode::one_shot, so that it is reported
+        /// the next time it is ready. Re-arming a level-triggered socket has no effect.
+        /// @param id The OS-level identifier for the socket to re-arm.
+        void rearm_socket(socket_id id);
+
         /// @brief Remove a socket from the polling set.
         /// @param id The OS-level identifier for the socket to remove.
         void remove_socket(socket_id id);
@@ -69,7 +141,16 @@ namespace jhoyt::asl
             ready_to_read,
 
             /// @brief The associated socket has space to write more data.
-            ready_to_write
+            ready_to_write,
+
+            /// @brief The associated event_fd has been signaled.
+            event_signaled,
+
+            /// @brief The associated timer_fd has expired.
+            timer_expired,
+
+            /// @brief The associated signal_fd has a pending signal.
+            signal_received
         };
 
         /// @brief Inner type that represents a single poll status for a socket.
@@ -84,7 +165,7 @@ namespace jhoyt::asl
         /// A timeout is provided in nanoseconds, although the underlying OS-level polling capabilities may have less
         /// resolution than that. The timeout is the maximum amount of time to wait for socket updates before
         /// returning. If socket updates have been detected then the function will return before the timeout has
-        /// expired.
+        /// expired. A wait that is interrupted by a signal handler returns early with no results.
         ///
         /// @param timeout The number of nanoseconds to wait for updates to occur.
         /// @returns Sequence of socket polling results that occurred.
@@ -3,10 +3,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <memory>
 #include <span>
+#include <string>
 
 #if !defined(_WIN32)
+#include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #endif
 
 #include "address.hpp"
@@ -19,9 +29,16 @@ namespace jhoyt::asl
     ///
     /// This class serves as a bridge between cross-platform address representations (i.e. `jhoyt::asl::address`) and
     /// the platform-specific structures that are used as inputs to various OS-level socket functions.
+    ///
+    /// Only the family-specific OS-level address is stored, along with its length, so an IPv4 or IPv6 address (the
+    /// common case for peers) takes a fraction of the size of a sockaddr_storage. The much larger sockaddr_un of a file
+    /// address is kept on the heap.
     class ASL_API raw_address final
     {
     public:
+        /// @brief The largest number of characters in the string representation of a raw address.
+        static constexpr auto k_max_string_size = std::size_t{128};
+
         /// @brief Construct an empty raw address.
         raw_address();
 
@@ -38,6 +55,15 @@ namespace jhoyt::asl
         /// @param data The raw bytes that represent the internal OS-level address type.
         explicit raw_address(std::span<const char> data);
 
+        raw_address(const raw_address& other);
+        raw_address& operator=(const raw_address& other);
+
+        /// @brief Move a raw address; the moved-from value is left empty.
+        raw_address(raw_address&& other) noexcept;
+        raw_address& operator=(raw_address&& other) noexcept;
+
+        ~raw_address();
+
         /// @brief Retrieve the raw address bytes stored in this value.
         ///
         /// @returns Span that represents the total bytes used by the corresponding and internal OS-level address type.
@@ -48,10 +74,76 @@ namespace jhoyt::asl
         /// @returns Generic address representation in a cross-platform form.
         [[nodiscard]] address get_address() const;
 
+        /// @brief Write the string representation of this value into a buffer without allocating.
+        ///
+        /// The representation is the same as that of the generic address (see to_string), but it is written straight
+        /// from the OS-level address, so no intermediate address or host string is created.
+        ///
+        /// @param out Buffer that receives the characters.
+        /// @returns The number of characters written to the front of the buffer.
+        std::size_t write_string(std::span<char, k_max_string_size> out) const;
+
+        /// @brief Retrieve a hash of this value, which is the same as the std::hash of the generic address it holds.
+        ///
+        /// Only the meaningful bytes are hashed (the family, host, port and scope id, or the path), never the unused
+        /// rest of the OS-level address.
+        [[nodiscard]] std::size_t get_hash() const;
+
+        /// @brief Compare two raw addresses by their meaningful bytes.
+        ///
+        /// Addresses are ordered by family, then as their generic addresses are: IP addresses by host bytes (which is
+        /// the numeric order), port and scope id, and file addresses by path. Empty raw addresses are equal.
+        std::strong_ordering operator<=>(const raw_address& other) const;
+
+        bool operator==(const raw_address& other) const;
+
     private:
-        sockaddr_storage data_{};
+        union ip_storage
+        {
+            sockaddr_in ipv4;
+            sockaddr_in6 ipv6;
+        };
+
+        /// The OS-level address of an IPv4 or IPv6 address; unused (zero) for a file address.
+        ip_storage ip_;
+
+        /// The length of the OS-level address, or zero for an empty raw address.
+        socklen_t size_ = 0;
+
+        /// The OS-level address of a file address, or null for any other address.
+        std::unique_ptr<sockaddr_un> file_;
+
+        [[nodiscard]] sa_family_t get_family() const;
     };
 
+    /// @brief Helper function to return a string representation of a raw address.
+    /// @param addr The raw address value to get the string representation of.
+    /// @returns The string representation, the same as that of the generic address it holds.
     std::string to_string(const raw_address& addr);
 
 } // namespace jhoyt::asl
+
+/// @brief Formatter that writes a raw address in the same form as to_string.
+///
+/// The address is formatted from the OS-level address into a buffer on the stack and copied to the output of the
+/// format context, so std::format_to and std::format_to_n with a fixed buffer do not allocate.
+template <>
+struct std::formatter<jhoyt::asl::raw_address> : jhoyt::asl::detail::address_formatter_base
+{
+    template <typename FormatContext>
+    auto format(const jhoyt::asl::raw_address& addr, FormatContext& ctx) const
+    {
+        auto buf = std::array<char, jhoyt::asl::raw_address::k_max_string_size>{};
+        const auto size = addr.write_string(buf);
+        return std::copy_n(buf.data(), size, ctx.out());
+    }
+};
+
+template <>
+struct std::hash<jhoyt::asl::raw_address>
+{
+    std::size_t operator()(const jhoyt::asl::raw_address& addr) const noexcept
+    {
+        return addr.get_hash();
+    }
+};
@@ -0,0 +1,173 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common.hpp"
+#include "event_loop.hpp"
+#include "poller.hpp"
+#include "runtime.hpp"
+#include "socket_id.hpp"
+
+namespace jhoyt::asl
+{
+
+    class rebalancer;
+
+    /// @brief Type that represents a socket registered with a worker's event loop through a rebalancer, so that it can
+    /// be moved to another worker while it is in use.
+    ///
+    /// Tracked connections are intrusive: the rebalancer links them into a per-worker list, so the connection must
+    /// remain valid until it is detached. The id, type, mode, handler and on_migrated fields are set by the owner
+    /// before attaching; the remaining fields are managed by the rebalancer.
+    ///
+    /// A migrated connection is added to the target's loop armed, so an edge-triggered or one-shot connection that was
+    /// disarmed on its old worker is reported on the new one if it is (still) ready.
+    struct tracked_connection
+    {
+        socket_id id = k_invalid_socket;
+        poller::poll_type type = poller::poll_type::read;
+        poller::trigger_mode mode = poller::trigger_mode::level;
+        io_handler handler;
+
+        /// @brief Called on the target worker thread once the connection has been registered with the target's loop.
+        void (*on_migrated)(tracked_connection& self, worker& target) = nullptr;
+
+        /// @brief Number of bytes transferred on the connection, as reported by add_bytes.
+        std::uint64_t bytes = 0;
+
+        /// @brief Number of poll statuses delivered to the handler.
+        std::uint64_t events = 0;
+
+        worker* owner = nullptr;
+        tracked_connection* prev = nullptr;
+        tracked_connection* next = nullptr;
+        std::uint64_t sampled_bytes = 0;
+        std::uint64_t sampled_events = 0;
+        std::uint64_t serial = 0;
+
+        struct migration_task : posted_task
+        {
+            tracked_connection* conn = nullptr;
+            rebalancer* owner = nullptr;
+            std::size_t target_index = 0;
+            std::atomic<std::size_t>* completion = nullptr;
+        };
+
+        migration_task arrival;
+
+        /// @brief Record bytes transferred on the connection; must be called on the owning worker thread.
+        void add_bytes(const std::size_t count)
+        {
+            bytes += count;
+        }
+    };
+
+    /// @brief Type that holds the options used to construct a rebalancer.
+    struct rebalancer_options
+    {
+        /// @brief The load of one poll status, in bytes; a connection's load is its byte count plus its event count
+        /// multiplied by this weight.
+        std::uint64_t event_weight = 256;
+
+        /// @brief Workers are only rebalanced while the most loaded one is this much above the average (e.g. 0.25 is
+        /// 25% above).
+        double imbalance_threshold = 0.25;
+
+        /// @brief The number of heaviest connections each worker reports as candidates for migration.
+        std::size_t candidates_per_worker = 8;
+
+        /// @brief The maximum number of connections moved by one call to rebalance.
+        std::size_t max_migrations = 16;
+    };
+
+    /// @brief Type that moves connections between the workers of a runtime, either on request or to even out load.
+    ///
+    /// A migration removes the socket from the source worker's event loop on the source thread and registers it with
+    /// the target worker's loop on the target thread, so each loop is still only used by its own thread. Because the
+    /// poller is level-triggered, data that arrives while the connection is in transit is reported by the target loop
+    /// as soon as the socket is registered there; no readiness is lost.
+    ///
+    /// @note The runtime must be stopped before the rebalancer is destroyed.
+    class ASL_API rebalancer final
+    {
+    public:
+        /// @brief Construct a new rebalancer.
+        /// @param rt The runtime whose workers own the connections.
+        /// @param options The options for the rebalancer.
+        explicit rebalancer(runtime& rt, const rebalancer_options& options = {});
+
+        ~rebalancer();
+
+        rebalancer(const rebalancer&) = delete;
+        rebalancer& operator=(const rebalancer&) = delete;
+
+        /// @brief Register a connection with the event loop of the calling worker thread.
+        /// @param conn The connection to register; it must remain valid until detached.
+        void attach(tracked_connection& conn);
+
+        /// @brief Remove a connection from the event loop of its worker; must be called on the owning worker thread.
+        /// @param conn The connection to remove.
+        void detach(tracked_connection& conn);
+
+        /// @brief Update the polling type of a connection; must be called on the owning worker thread.
+        /// @param conn The connection to update.
+        /// @param type The new type of polling that should occur for the socket.
+        void update(tracked_connection& conn, poller::poll_type type);
+
+        /// @brief Move a connection to another worker; must be called on the owning worker thread.
+        ///
+        /// The connection stops being polled by the calling worker immediately and is handed to the target worker,
+        /// which registers it and calls on_migrated. The connection must not be used until then.
+        ///
+        /// @param conn The connection to move.
+        /// @param target_index The index of the target worker.
+        void migrate(tracked_connection& conn, std::size_t target_index);
+
+        /// @brief Move the heaviest connections off overloaded workers.
+        ///
+        /// Every worker reports the load of its connections since the previous call, and connections are moved from
+        /// the most loaded worker to the least loaded one while that reduces the imbalance. The call blocks until the
+        /// moves have completed, so it must be called from a thread that is not a worker thread, e.g. periodically
+        /// from a monitoring thread.
+        ///
+        /// @returns The number of connections that were moved.
+        std::size_t rebalance();
+
+        /// @brief Retrieve the load of each worker measured by the last call to rebalance.
+        [[nodiscard]] const std::vector<std::uint64_t>& get_last_loads() const
+        {
+            return last_loads_;
+        }
+
+    private:
+        struct candidate
+        {
+            tracked_connection* conn;
+            std::uint64_t serial;
+            std::uint64_t load;
+        };
+
+        struct worker_state;
+
+        runtime& runtime_;
+        rebalancer_options options_;
+        std::vector<std::unique_ptr<worker_state>> workers_;
+        std::vector<std::uint64_t> last_loads_;
+        std::atomic<std::uint64_t> next_serial_{1};
+
+        void start_migration(tracked_connection& conn, std::size_t target_index, std::atomic<std::size_t>* completion);
+
+        static void on_poll(void* object, socket_id id, poller::poll_status status);
+        static void on_arrival(posted_task& self);
+        static void on_sample(posted_task& self);
+        static void on_move(posted_task& self);
+    };
+
+} // namespace jhoyt::asl
@@ -0,0 +1,66 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "common.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that holds received bytes in a single contiguous region so they can be viewed in place.
+    ///
+    /// Bytes are received directly into the writable region (see get_writable and commit) and inspected through the
+    /// readable region (see get_readable and consume). Views returned by get_readable remain valid until the next call
+    /// to get_writable, which may move the unread bytes to the front of the buffer or grow it.
+    class ASL_API recv_buffer final
+    {
+    public:
+        static constexpr auto k_default_capacity = std::size_t{64 * 1024};
+
+        /// @brief Construct a new receive buffer.
+        /// @param capacity The initial number of bytes the buffer can hold.
+        explicit recv_buffer(std::size_t capacity = k_default_capacity);
+
+        /// @brief Retrieve the bytes that have been received but not yet consumed.
+        /// @returns Span over the unconsumed bytes.
+        [[nodiscard]] std::span<const char> get_readable() const
+        {
+            return {data_.data() + read_pos_, write_pos_ - read_pos_};
+        }
+
+        /// @brief Retrieve a region that more bytes can be received into.
+        ///
+        /// Unread bytes are moved to the front of the buffer when that makes enough space available, otherwise the
+        /// buffer is grown. Either operation invalidates spans previously returned by get_readable.
+        ///
+        /// @param min_size The minimum number of bytes the returned region must hold.
+        /// @returns Span over the writable region, which is at least min_size bytes long.
+        std::span<char> get_writable(std::size_t min_size);
+
+        /// @brief Mark bytes at the front of the writable region as received.
+        /// @param count The number of bytes that were written into the region returned by get_writable.
+        void commit(std::size_t count);
+
+        /// @brief Discard bytes from the front of the readable region.
+        /// @param count The number of bytes to discard.
+        void consume(std::size_t count);
+
+        /// @brief Discard all readable bytes.
+        void clear()
+        {
+            read_pos_ = 0;
+            write_pos_ = 0;
+        }
+
+    private:
+        std::vector<char> data_;
+        std::size_t read_pos_ = 0;
+        std::size_t write_pos_ = 0;
+    };
+
+} // namespace jhoyt::asl
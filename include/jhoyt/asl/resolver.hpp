@@ -0,0 +1,223 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common.hpp"
+#include "event_loop.hpp"
+#include "raw_address.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Enumeration that represents the outcome of resolving a name.
+    enum class resolve_status
+    {
+        /// @brief The name has at least one address.
+        success,
+
+        /// @brief The name does not exist, has no addresses or is not a valid name.
+        not_found,
+
+        /// @brief The nameserver did not answer in time.
+        timed_out,
+
+        /// @brief The nameserver reported an error (e.g. a server failure) or could not be reached.
+        failed
+    };
+
+    namespace detail
+    {
+        struct resolve_query;
+    } // namespace detail
+
+    /// @brief Type that represents a request to resolve a name, which is completed by a resolver.
+    ///
+    /// Requests are intrusive: the resolver links every request for a name that is being queried into one list, so
+    /// the request must remain valid until it has been completed or cancelled. The on_resolved field is set by the
+    /// owner; the remaining fields are managed by the resolver.
+    struct resolve_request
+    {
+        /// @brief Called once with the outcome; the addresses are only valid for the duration of the call.
+        void (*on_resolved)(resolve_request& self, resolve_status status, std::span<const raw_address> addrs) = nullptr;
+
+        std::uint16_t port = 0;
+        detail::resolve_query* query = nullptr;
+        resolve_request* next = nullptr;
+    };
+
+    /// @brief Type that holds the settings of a resolver.
+    struct resolver_options
+    {
+        /// @brief The nameserver to query, or std::nullopt for the first nameserver of resolv_conf_path (or
+        /// 127.0.0.1 if that has none).
+        std::optional<raw_address> nameserver;
+
+        /// @brief The hosts file to read when the resolver is constructed; an empty path or missing file is skipped.
+        std::string hosts_path = "/etc/hosts";
+
+        /// @brief The file to read the nameserver from when none is set.
+        std::string resolv_conf_path = "/etc/resolv.conf";
+
+        /// @brief How long to wait for an answer before sending the query again.
+        std::chrono::milliseconds timeout{2000};
+
+        /// @brief The number of times a query is sent before giving up.
+        std::size_t attempts = 2;
+
+        /// @brief The number of names queried from one socket before queries move to a new socket, and so to a new
+        /// source port; zero keeps one socket for the lifetime of the resolver.
+        std::size_t queries_per_socket = 128;
+
+        /// @brief Whether to also query AAAA records, so that names resolve to their IPv6 addresses as well.
+        bool query_ipv6 = true;
+
+        /// @brief The longest an answer is cached, whatever its TTL.
+        std::chrono::seconds max_ttl{3600};
+
+        /// @brief The longest a name that was not found is cached; the SOA record of the answer may shorten this.
+        std::chrono::seconds negative_ttl{30};
+
+        /// @brief The number of names to cache; expired names are dropped first when the cache is full.
+        std::size_t cache_capacity = 4096;
+    };
+
+    class resolve_awaiter;
+
+    /// @brief Type that resolves host names to raw addresses without blocking the thread of an event loop.
+    ///
+    /// Names are looked up in order as numeric hosts, in the hosts file, in the cache and finally by querying the
+    /// nameserver over a datagram socket that is registered with the event loop. Queries for A and (optionally) AAAA
+    /// records are sent at the same time, retried on timeout and answered once both have been answered; the addresses
+    /// are listed with the IPv6 ones first. Answers are cached for their TTL and names that do not exist for the TTL of
+    /// the negative answer. Requests for a name that is already being queried join that query instead of sending
+    /// another one, so a burst of requests for a name costs a single round trip.
+    ///
+    /// Names are queried as given: the search domains of resolv.conf are not applied and responses that were
+    /// truncated are not retried over TCP.
+    ///
+    /// Answers are only accepted from the nameserver, on the socket the query was sent from and with the random id of
+    /// the query, which is all that stands between the cache and a forged answer. The socket is therefore replaced
+    /// every queries_per_socket queries, so that the source port an attacker has to guess keeps changing; even so,
+    /// the resolver is meant for a nameserver on a trusted path, such as a local caching stub.
+    ///
+    /// @note All functions must be called on the thread that runs the loop.
+    class ASL_API resolver final
+    {
+    public:
+        /// @brief Construct a new resolver that registers its socket with an event loop.
+        /// @param loop The event loop to run the queries on; it must outlive the resolver.
+        /// @param options The settings of the resolver.
+        explicit resolver(event_loop& loop, resolver_options options = {});
+
+        /// @brief Destroy the resolver; requests that have not been completed are dropped without being notified.
+        ~resolver();
+
+        resolver(const resolver&) = delete;
+        resolver& operator=(const resolver&) = delete;
+
+        /// @brief Inner type that holds statistics about the lookups of a resolver.
+        struct stats
+        {
+            std::uint64_t lookups = 0;
+            std::uint64_t hosts_hits = 0;
+            std::uint64_t cache_hits = 0;
+
+            /// @brief Lookups that joined a query already in flight for the same name.
+            std::uint64_t joined = 0;
+
+            /// @brief Messages sent to the nameserver, including retries.
+            std::uint64_t queries = 0;
+            std::uint64_t timeouts = 0;
+        };
+
+        /// @brief Retrieve the statistics collected since construction.
+        [[nodiscard]] const stats& get_stats() const;
+
+        /// @brief Resolve a name.
+        ///
+        /// A numeric host, a name in the hosts file or a cached name completes the request before this returns;
+        /// otherwise it is completed from the event loop once the nameserver has answered or the query has timed out.
+        ///
+        /// @param name The name to resolve.
+        /// @param port The port of the addresses produced for the request.
+        /// @param request The request to complete; its on_resolved field must be set.
+        void resolve(std::string_view name, std::uint16_t port, resolve_request& request);
+
+        /// @brief Cancel a request without notifying it. Cancelling a completed request has no effect.
+        ///
+        /// The query for the name carries on, so its answer still ends up in the cache.
+        ///
+        /// @param request The request to cancel.
+        void cancel(resolve_request& request);
+
+        /// @brief Resolve a name, suspending until it has been resolved.
+        /// @param name The name to resolve.
+        /// @param port The port of the addresses produced.
+        /// @returns Awaitable that produces the outcome and the addresses.
+        resolve_awaiter async_resolve(std::string_view name, std::uint16_t port);
+
+        /// @brief Retrieve the number of names in the cache, including ones that have expired but not been dropped.
+        [[nodiscard]] std::size_t get_cache_size() const;
+
+        /// @brief Drop every cached name.
+        void clear_cache();
+
+    private:
+        struct impl;
+        std::unique_ptr<impl> pimpl_;
+    };
+
+    /// @brief Type that holds the outcome of resolving a name with resolver::async_resolve.
+    struct resolve_result
+    {
+        resolve_status status = resolve_status::failed;
+        std::vector<raw_address> addrs;
+    };
+
+    /// @brief Awaitable that resolves a name and completes with its addresses.
+    class ASL_API resolve_awaiter final : private resolve_request
+    {
+    public:
+        resolve_awaiter(resolver& owner, std::string_view name, std::uint16_t port);
+
+        ~resolve_awaiter();
+
+        resolve_awaiter(const resolve_awaiter&) = delete;
+        resolve_awaiter& operator=(const resolve_awaiter&) = delete;
+
+        bool await_ready()
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        resolve_result await_resume()
+        {
+            return std::move(result_);
+        }
+
+    private:
+        resolver& owner_;
+        std::string name_;
+        std::uint16_t port_;
+        std::coroutine_handle<> handle_;
+        resolve_result result_;
+        bool completed_ = false;
+
+        static void notify(resolve_request& self, resolve_status status, std::span<const raw_address> addrs);
+    };
+
+} // namespace jhoyt::asl
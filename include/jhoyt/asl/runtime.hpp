@@ -0,0 +1,364 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "buffer_pool.hpp"
+#include "common.hpp"
+#include "event_loop.hpp"
+#include "poller.hpp"
+#include "socket_id.hpp"
+#include "work_stealing_deque.hpp"
+
+namespace jhoyt::asl
+{
+
+    namespace detail
+    {
+        class notifier;
+    } // namespace detail
+
+    class runtime;
+
+    /// @brief Type that represents a unit of CPU-bound work that may be run by any worker of a runtime.
+    ///
+    /// Compute tasks are intrusive: the worker only stores a pointer to the task, so submitting one does not allocate
+    /// (other than when a worker's deque has to grow).
+    struct compute_task
+    {
+        void (*run)(compute_task& self) = nullptr;
+    };
+
+    /// @brief Type that represents one thread of a runtime, with its own event loop and buffer pool.
+    ///
+    /// Workers share nothing with each other: the event loop, the poller behind it, its timers and the buffer pool are
+    /// only ever used by the worker's own thread. The single way in from another thread is post, which hands a task to
+    /// the worker to run on its thread. To place a socket on a worker, post a task that registers the socket with
+    /// get_loop() (or uses the loop's awaitables); from then on the socket is only touched by that worker.
+    class ASL_API worker final
+    {
+    public:
+        ~worker();
+
+        worker(const worker&) = delete;
+        worker& operator=(const worker&) = delete;
+
+        /// @brief Retrieve the worker running on the calling thread.
+        /// @returns Pointer to the worker, or nullptr if the calling thread is not a worker thread.
+        [[nodiscard]] static worker* get_current();
+
+        /// @brief Retrieve the index of the worker within its runtime.
+        [[nodiscard]] auto get_index() const
+        {
+            return index_;
+        }
+
+        /// @brief Retrieve the CPU the worker thread is pinned to, if pinning was requested (see runtime_options).
+        [[nodiscard]] auto get_cpu() const
+        {
+            return cpu_;
+        }
+
+        /// @brief Retrieve the event loop of the worker.
+        /// @note The event loop must only be used on the worker thread.
+        event_loop& get_loop()
+        {
+            return loop_;
+        }
+
+        /// @brief Retrieve the buffer pool of the worker.
+        /// @note The buffer pool must only be used on the worker thread.
+        buffer_pool& get_buffer_pool()
+        {
+            return buffers_;
+        }
+
+        /// @brief Run a task on the worker thread.
+        ///
+        /// This function may be called from any thread. It does not allocate or take a lock, and it only wakes the
+        /// worker's poller when the worker had no other tasks pending. Tasks still pending when the runtime stops are
+        /// not run.
+        ///
+        /// @param task The task to run; it must remain valid until it has run.
+        void post(posted_task& task);
+
+        /// @brief Submit CPU-bound work to the worker's compute deque; must be called on the worker thread.
+        ///
+        /// Workers run compute tasks between iterations of their event loop, a batch at a time so that sockets are
+        /// still polled regularly. Workers that have nothing else to do steal tasks from the deques of the others, and
+        /// a worker blocked in its poller is woken to do so. Tasks still queued when the runtime stops are not run.
+        ///
+        /// @param task The task to run; it must remain valid until it has run.
+        void submit(compute_task& task);
+
+        /// @brief Inner type that holds statistics about the compute tasks run by the worker.
+        struct compute_stats
+        {
+            std::uint64_t tasks = 0;
+            std::uint64_t stolen = 0;
+        };
+
+        /// @brief Retrieve the compute statistics of the worker; must be called on the worker thread (or after the
+        /// runtime has stopped).
+        [[nodiscard]] const compute_stats& get_compute_stats() const
+        {
+            return compute_stats_;
+        }
+
+    private:
+        friend class runtime;
+
+        runtime& runtime_;
+        std::size_t index_;
+        std::optional<std::size_t> cpu_;
+        std::size_t compute_batch_;
+        event_loop loop_;
+        buffer_pool buffers_;
+        std::unique_ptr<detail::notifier> notifier_;
+        std::atomic<posted_task*> inbox_{nullptr};
+        std::atomic<bool> stopping_{false};
+        std::atomic<bool> sleeping_{false};
+        work_stealing_deque<compute_task*> compute_;
+        compute_stats compute_stats_;
+        std::size_t next_victim_ = 0;
+        std::thread thread_;
+
+        worker(runtime& rt,
+               std::size_t index,
+               std::optional<std::size_t> cpu,
+               std::size_t buffer_size,
+               std::size_t compute_batch);
+
+        void start();
+        void stop();
+        void run();
+        void run_inbox();
+        void run_compute();
+        [[nodiscard]] bool has_compute_work() const;
+        void wake_sleeper();
+
+        static void on_wake(void* object, socket_id id, poller::poll_status status);
+    };
+
+    /// @brief Type that holds the options used to construct a runtime.
+    struct runtime_options
+    {
+        /// @brief The number of worker threads; zero uses one worker per CPU the process may run on.
+        std::size_t worker_count = 0;
+
+        /// @brief Pin each worker thread to its own CPU, taken in order from the CPUs the process may run on (its
+        /// affinity mask, which a container or taskset may restrict), starting at first_cpu and wrapping around.
+        bool pin_threads = true;
+
+        /// @brief The position, among the CPUs the process may run on, of the CPU that the first worker is pinned to.
+        std::size_t first_cpu = 0;
+
+        /// @brief The size of the buffers handed out by each worker's buffer pool.
+        std::size_t buffer_size = buffer_pool::k_default_buffer_size;
+
+        /// @brief The maximum number of compute tasks a worker runs between two polls of its event loop.
+        std::size_t compute_batch = 16;
+
+        /// @brief The spin-then-block policy of each worker's event loop; by default workers block right away.
+        std::optional<event_loop::spin_options> spin{};
+    };
+
+    /// @brief Type that runs a set of worker threads, each with its own event loop, in a thread-per-core arrangement.
+    ///
+    /// Each worker polls only the sockets placed on it, so connection state never crosses cores unless a program
+    /// explicitly posts work to another worker. Pinning is only supported on Linux; elsewhere the option is ignored.
+    ///
+    /// Exceptions thrown by tasks or socket handlers run on a worker thread are not caught, so as with std::thread they
+    /// terminate the program.
+    class ASL_API runtime final
+    {
+    public:
+        /// @brief Construct a new runtime; the workers are created but not started.
+        /// @param options The options for the runtime.
+        explicit runtime(const runtime_options& options = {});
+
+        /// @brief Stop the workers and wait for their threads to finish.
+        ~runtime();
+
+        runtime(const runtime&) = delete;
+        runtime& operator=(const runtime&) = delete;
+
+        /// @brief Start the worker threads.
+        void start();
+
+        /// @brief Stop the worker threads and wait for them to finish.
+        ///
+        /// Each worker finishes the loop iteration it is running; sockets, waiters and timers that are still registered
+        /// with its event loop are left as they are.
+        void stop();
+
+        /// @brief Check if the worker threads are running.
+        [[nodiscard]] auto is_running() const
+        {
+            return running_;
+        }
+
+        /// @brief Retrieve the number of workers.
+        [[nodiscard]] std::size_t get_worker_count() const
+        {
+            return workers_.size();
+        }
+
+        /// @brief Retrieve a worker.
+        /// @param index The index of the worker, less than get_worker_count().
+        worker& get_worker(const std::size_t index)
+        {
+            return *workers_[index];
+        }
+
+        /// @brief Run a task on a worker thread (see worker::post).
+        /// @param index The index of the worker.
+        /// @param task The task to run; it must remain valid until it has run.
+        void post(const std::size_t index, posted_task& task)
+        {
+            workers_[index]->post(task);
+        }
+
+    private:
+        friend class worker;
+
+        std::vector<std::unique_ptr<worker>> workers_;
+        bool running_ = false;
+    };
+
+    namespace detail
+    {
+
+        template <typename T>
+        struct offload_result
+        {
+            std::optional<T> value;
+
+            template <typename F>
+            void invoke(F& fn)
+            {
+                value.emplace(fn());
+            }
+
+            T take()
+            {
+                return std::move(*value);
+            }
+        };
+
+        template <>
+        struct offload_result<void>
+        {
+            template <typename F>
+            void invoke(F& fn)
+            {
+                fn();
+            }
+
+            void take()
+            {
+            }
+        };
+
+    } // namespace detail
+
+    /// @brief Type that runs a function as a compute task and resumes the awaiting coroutine on its own worker.
+    template <typename F>
+    class offload_awaiter final : private compute_task, private posted_task
+    {
+    public:
+        using result_type = std::invoke_result_t<F&>;
+
+        explicit offload_awaiter(F fn)
+            : compute_task{&offload_awaiter::compute}, posted_task{&offload_awaiter::resume}, fn_(std::move(fn))
+        {
+        }
+
+        offload_awaiter(const offload_awaiter&) = delete;
+        offload_awaiter& operator=(const offload_awaiter&) = delete;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(const std::coroutine_handle<> handle)
+        {
+            owner_ = worker::get_current();
+            assert(owner_ && "offload must be awaited on a worker thread");
+            handle_ = handle;
+            owner_->submit(static_cast<compute_task&>(*this));
+        }
+
+        result_type await_resume()
+        {
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+
+            return result_.take();
+        }
+
+    private:
+        F fn_;
+        worker* owner_ = nullptr;
+        std::coroutine_handle<> handle_;
+        detail::offload_result<result_type> result_;
+        std::exception_ptr error_;
+
+        static void compute(compute_task& self)
+        {
+            auto& awaiter = static_cast<offload_awaiter&>(self);
+            try
+            {
+                awaiter.result_.invoke(awaiter.fn_);
+            }
+            catch (...)
+            {
+                awaiter.error_ = std::current_exception();
+            }
+
+            if (worker::get_current() == awaiter.owner_)
+            {
+                awaiter.handle_.resume();
+            }
+            else
+            {
+                awaiter.owner_->post(static_cast<posted_task&>(awaiter));
+            }
+        }
+
+        static void resume(posted_task& self)
+        {
+            static_cast<offload_awaiter&>(self).handle_.resume();
+        }
+    };
+
+    /// @brief Run CPU-bound work as a compute task of the runtime and resume on the calling worker once it is done.
+    ///
+    /// The function may run on any worker, so it must not use sockets or other state owned by the calling worker.
+    /// Exceptions thrown by the function are rethrown in the awaiting coroutine.
+    ///
+    /// @param fn The function to run.
+    /// @returns Awaitable that produces the result of the function; it must be awaited on a worker thread.
+    template <typename F>
+    offload_awaiter<F> offload(F fn)
+    {
+        return offload_awaiter<F>{std::move(fn)};
+    }
+
+} // namespace jhoyt::asl
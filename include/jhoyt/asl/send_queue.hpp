@@ -0,0 +1,57 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <deque>
+
+#include "common.hpp"
+#include "shared_buffer.hpp"
+#include "socket.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that holds the data still waiting to be sent on a single socket.
+    ///
+    /// Each queued entry is a shared buffer plus the offset of the first byte that has not been sent yet, so queuing
+    /// the same buffer on many sockets does not copy it.
+    class ASL_API send_queue final
+    {
+    public:
+        /// @brief Append a buffer to the end of the queue.
+        /// @param buf The buffer to send once everything ahead of it has been sent.
+        void push(shared_buffer buf);
+
+        /// @brief Send as much queued data as the socket will accept without blocking.
+        /// @param sock The socket to send the queued data on.
+        /// @returns transfer_status::success if the queue was drained, transfer_status::blocked if data remains queued
+        /// or transfer_status::disconnected if the socket was disconnected.
+        socket::transfer_status flush(socket& sock);
+
+        /// @brief Discard all queued data.
+        void clear()
+        {
+            entries_.clear();
+        }
+
+        /// @brief Check if there is no queued data.
+        [[nodiscard]] auto empty() const
+        {
+            return entries_.empty();
+        }
+
+        /// @brief Retrieve the number of queued bytes that have not been sent yet.
+        [[nodiscard]] std::size_t get_pending_bytes() const;
+
+    private:
+        struct entry
+        {
+            shared_buffer buf;
+            std::size_t offset;
+        };
+
+        std::deque<entry> entries_;
+    };
+
+} // namespace jhoyt::asl
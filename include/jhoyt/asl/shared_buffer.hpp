@@ -0,0 +1,66 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+#include "common.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that holds an immutable, reference-counted sequence of bytes.
+    ///
+    /// Copying a shared buffer only adjusts a reference count; the bytes themselves are stored once, in a single
+    /// allocation together with the count, and released when the last copy is destroyed. This allows the same payload
+    /// to be queued for sending on many sockets at the cost of one pointer per socket. The reference count is atomic so
+    /// copies may be handed to other threads.
+    class ASL_API shared_buffer final
+    {
+    public:
+        /// @brief Construct an empty shared buffer.
+        shared_buffer() = default;
+
+        /// @brief Construct a new shared buffer holding a copy of the provided bytes.
+        /// @param data The bytes to store in the buffer.
+        explicit shared_buffer(std::span<const char> data);
+
+        ~shared_buffer();
+
+        shared_buffer(const shared_buffer& other) noexcept;
+        shared_buffer& operator=(const shared_buffer& other) noexcept;
+
+        shared_buffer(shared_buffer&& other) noexcept;
+        shared_buffer& operator=(shared_buffer&& other) noexcept;
+
+        /// @brief Retrieve the bytes stored in the buffer.
+        /// @returns Span over the stored bytes, which is empty for an empty buffer.
+        [[nodiscard]] std::span<const char> get_data() const;
+
+        /// @brief Retrieve the number of shared buffer values that refer to the same bytes.
+        /// @returns The number of references, or 0 for an empty buffer.
+        [[nodiscard]] std::size_t get_use_count() const;
+
+        /// @brief Check if the buffer holds any bytes.
+        /// @returns True if the buffer is not empty, otherwise false.
+        explicit operator bool() const
+        {
+            return block_ != nullptr;
+        }
+
+    private:
+        struct block
+        {
+            std::atomic<std::size_t> refs;
+            std::size_t size;
+        };
+
+        block* block_ = nullptr;
+
+        void release() noexcept;
+    };
+
+} // namespace jhoyt::asl
@@ -0,0 +1,53 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <initializer_list>
+#include <optional>
+
+#include "common.hpp"
+#include "socket_id.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that wraps a pollable source of POSIX signals.
+    ///
+    /// This is a signalfd and is only available on Linux; constructing one elsewhere throws. Register get_id() with a
+    /// poller using poller::poll_type::signal, which results in poller::poll_status::signal_received while a signal
+    /// is pending, and call consume() until it returns std::nullopt to take the pending signals.
+    ///
+    /// @note A signal is only queued for the signalfd if it is blocked in every thread, otherwise it is delivered to
+    /// a thread as usual. The constructor blocks the signals for the calling thread; create the signal_fd (or block the
+    /// signals) before starting other threads, which inherit the signal mask.
+    class ASL_API signal_fd final
+    {
+    public:
+        /// @brief Construct a new signal source and block its signals for the calling thread.
+        /// @param signals The signal numbers to receive (e.g. SIGINT, SIGTERM).
+        explicit signal_fd(std::initializer_list<int> signals);
+
+        ~signal_fd();
+
+        signal_fd(const signal_fd&) = delete;
+        signal_fd& operator=(const signal_fd&) = delete;
+
+        signal_fd(signal_fd&& other) noexcept;
+        signal_fd& operator=(signal_fd&& other) noexcept;
+
+        /// @brief Retrieve the OS-level identifier to register with a poller.
+        [[nodiscard]] socket_id get_id() const
+        {
+            return id_;
+        }
+
+        /// @brief Take the next pending signal without blocking.
+        /// @returns The signal number, or std::nullopt if no signal is pending.
+        std::optional<int> consume() const;
+
+    private:
+        socket_id id_ = k_invalid_socket;
+    };
+
+} // namespace jhoyt::asl
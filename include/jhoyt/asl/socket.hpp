@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
 #include "common.hpp"
 #include "raw_address.hpp"
 #include "socket_domain.hpp"
@@ -22,7 +26,7 @@ namespace jhoyt::asl
         socket(const socket&) = delete;
         socket& operator=(const socket&) = delete;
 
-        socket(socket& other) noexcept;
+        socket(socket&& other) noexcept;
         socket& operator=(socket&& other) noexcept;
 
         /// @brief Retrieve the OS-level identifier of the socket, or k_invalid_socket if there is not one.
@@ -51,6 +55,23 @@ namespace jhoyt::asl
         /// @param value The value of the option to set.
         void set_reuse_address_option(bool value);
 
+        /// @brief Retrieve the CPU that processed the most recent incoming packets of the socket.
+        ///
+        /// This reads the SO_INCOMING_CPU option, which is only available on Linux.
+        ///
+        /// @returns The CPU index, or std::nullopt if the platform does not report it or no packets have been received.
+        [[nodiscard]] std::optional<std::size_t> get_incoming_cpu_option() const;
+
+        /// @brief Set how long a blocking receive or poll on the socket busy-polls the device queue before sleeping.
+        ///
+        /// This sets the SO_BUSY_POLL option (and SO_PREFER_BUSY_POLL where the headers provide it), which are only
+        /// available on Linux. Raising the busy poll time above the system default may require CAP_NET_ADMIN.
+        ///
+        /// @param duration The busy poll time; zero disables busy polling for the socket.
+        /// @param prefer_busy_poll Whether the kernel should prefer busy polling over interrupt-driven processing.
+        /// @returns True if the option was set, or false if the platform does not support it.
+        bool set_busy_poll_option(std::chrono::microseconds duration, bool prefer_busy_poll = false);
+
         /// @brief Inner enumeration that represents what side of a socket to shut down.
         enum class shutdown_type
         {
@@ -124,6 +145,27 @@ namespace jhoyt::asl
         /// successfully received.
         std::pair<transfer_status, size_t> recv(std::span<char> data);
 
+        /// @brief Attempt to send a datagram to an address.
+        ///
+        /// An unbound socket is bound to an ephemeral port by the first datagram it sends.
+        ///
+        /// @param data The bytes of the datagram; an empty span sends an empty datagram.
+        /// @param addr The address to send the datagram to.
+        /// @returns The transfer status along with the number of bytes that were sent, which is either all of them or
+        /// none if the socket would have blocked.
+        std::pair<transfer_status, size_t> send_to(std::span<const char> data, const raw_address& addr);
+
+        /// @brief Attempt to receive a datagram along with the address it was sent from.
+        ///
+        /// A datagram larger than the buffer is truncated. Receiving an empty datagram is a successful transfer of zero
+        /// bytes; a datagram socket is never reported as disconnected.
+        ///
+        /// @param data Buffer for the bytes of the datagram.
+        /// @param addr An address object to update with the address of the sender.
+        /// @returns The transfer status along with the number of bytes (into the front of the buffer) that were
+        /// received.
+        std::pair<transfer_status, size_t> recv_from(std::span<char> data, raw_address& addr);
+
     private:
         socket_id sock_ = k_invalid_socket;
 
@@ -9,7 +9,11 @@ namespace jhoyt::asl
     /// @brief Enumeration that represents the supported types of sockets.
     enum class socket_type
     {
-        stream
+        /// @brief A connection-oriented byte stream, e.g. TCP.
+        stream,
+
+        /// @brief Connectionless datagrams, e.g. UDP; see socket::send_to and socket::recv_from.
+        datagram
     };
 
 } // namespace jhoyt::asl
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that represents a bounded, lock-free queue with a single producer thread and a single consumer
+    /// thread.
+    ///
+    /// Each side caches the last observed position of the other side, so a push or pop only touches the shared
+    /// positions when the cached value says the queue looks full (or empty).
+    ///
+    /// @tparam T The element type; it must be default constructible and move assignable.
+    template <typename T>
+    class spsc_queue final
+    {
+    public:
+        /// @brief Construct a new queue.
+        /// @param capacity The minimum number of elements the queue can hold; it is rounded up to a power of two.
+        explicit spsc_queue(const std::size_t capacity)
+            : slots_(std::bit_ceil(std::max<std::size_t>(capacity, 2))), mask_(slots_.size() - 1)
+        {
+        }
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+
+        /// @brief Retrieve the number of elements the queue can hold.
+        [[nodiscard]] std::size_t get_capacity() const
+        {
+            return slots_.size();
+        }
+
+        /// @brief Check if the queue is empty; only exact when called by the consumer.
+        [[nodiscard]] bool empty() const
+        {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+        /// @brief Add an element to the back of the queue; must only be called by the producer.
+        /// @param value The element to add; it is only moved from if the push succeeds.
+        /// @returns True if the element was added, or false if the queue is full.
+        bool try_push(T& value)
+        {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cached_head_ == slots_.size())
+            {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (tail - cached_head_ == slots_.size())
+                {
+                    return false;
+                }
+            }
+
+            slots_[tail & mask_] = std::move(value);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Remove the element at the front of the queue; must only be called by the consumer.
+        /// @param value Object that is assigned the removed element.
+        /// @returns True if an element was removed, or false if the queue is empty.
+        bool try_pop(T& value)
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (head == cached_tail_)
+            {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                if (head == cached_tail_)
+                {
+                    return false;
+                }
+            }
+
+            value = std::move(slots_[head & mask_]);
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::vector<T> slots_;
+        std::size_t mask_;
+
+        alignas(k_cache_line_size) std::atomic<std::size_t> head_{0};
+        std::size_t cached_tail_ = 0;
+
+        alignas(k_cache_line_size) std::atomic<std::size_t> tail_{0};
+        std::size_t cached_head_ = 0;
+    };
+
+} // namespace jhoyt::asl
@@ -0,0 +1,287 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "common.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Allocate memory for a coroutine frame from the calling thread's frame pool.
+    ///
+    /// Frames are grouped into power-of-two size classes and released frames are kept on a per-thread free list, so
+    /// once a program has reached its steady state starting a coroutine does not allocate from the heap. Frames larger
+    /// than the biggest size class are allocated from the heap directly.
+    ///
+    /// @param size The number of bytes required by the frame.
+    /// @returns Pointer to the frame memory.
+    ASL_API void* allocate_frame(std::size_t size);
+
+    /// @brief Return memory for a coroutine frame to the calling thread's frame pool.
+    /// @param ptr Pointer previously returned by allocate_frame.
+    /// @param size The size that was passed to allocate_frame.
+    ASL_API void deallocate_frame(void* ptr, std::size_t size) noexcept;
+
+    template <typename T>
+    class task;
+
+    namespace detail
+    {
+
+        class task_promise_base
+        {
+        public:
+            static void* operator new(const std::size_t size)
+            {
+                return allocate_frame(size);
+            }
+
+            static void operator delete(void* ptr, const std::size_t size) noexcept
+            {
+                deallocate_frame(ptr, size);
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            struct final_awaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+                {
+                    auto& promise = handle.promise();
+                    if (promise.detached_)
+                    {
+                        if (promise.exception_)
+                        {
+                            // As with std::thread there is nobody left to report the error to.
+                            std::terminate();
+                        }
+
+                        handle.destroy();
+                        return std::noop_coroutine();
+                    }
+
+                    return promise.continuation_ ? promise.continuation_ : std::noop_coroutine();
+                }
+
+                void await_resume() noexcept
+                {
+                }
+            };
+
+            final_awaiter final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception_ = std::current_exception();
+            }
+
+            void set_continuation(const std::coroutine_handle<> continuation) noexcept
+            {
+                continuation_ = continuation;
+            }
+
+            void set_detached() noexcept
+            {
+                detached_ = true;
+            }
+
+            void rethrow_if_exception() const
+            {
+                if (exception_)
+                {
+                    std::rethrow_exception(exception_);
+                }
+            }
+
+        private:
+            std::coroutine_handle<> continuation_;
+            std::exception_ptr exception_;
+            bool detached_ = false;
+        };
+
+        template <typename T>
+        class task_promise final : public task_promise_base
+        {
+        public:
+            task<T> get_return_object() noexcept;
+
+            template <typename U>
+            void return_value(U&& value)
+            {
+                value_.emplace(std::forward<U>(value));
+            }
+
+            T get_result()
+            {
+                rethrow_if_exception();
+                return std::move(*value_);
+            }
+
+        private:
+            std::optional<T> value_;
+        };
+
+        template <>
+        class task_promise<void> final : public task_promise_base
+        {
+        public:
+            task<void> get_return_object() noexcept;
+
+            void return_void() noexcept
+            {
+            }
+
+            void get_result() const
+            {
+                rethrow_if_exception();
+            }
+        };
+
+    } // namespace detail
+
+    /// @brief Type that represents a lazily started coroutine producing a value of type T.
+    ///
+    /// A task does not run until it is awaited (or passed to spawn), at which point it runs until its first suspension.
+    /// When it completes, the awaiting coroutine is resumed directly (symmetric transfer) with its result or exception.
+    /// Task frames are allocated with allocate_frame.
+    ///
+    /// @tparam T The type of value produced by the coroutine.
+    template <typename T = void>
+    class [[nodiscard]] task final
+    {
+    public:
+        using promise_type = detail::task_promise<T>;
+
+        task() = default;
+
+        ~task()
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+        task(const task&) = delete;
+        task& operator=(const task&) = delete;
+
+        task(task&& other) noexcept : handle_(std::exchange(other.handle_, {}))
+        {
+        }
+
+        task& operator=(task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle_)
+                {
+                    handle_.destroy();
+                }
+
+                handle_ = std::exchange(other.handle_, {});
+            }
+
+            return *this;
+        }
+
+        /// @brief Check if the task refers to a coroutine.
+        explicit operator bool() const
+        {
+            return static_cast<bool>(handle_);
+        }
+
+        /// @brief Check if the coroutine has run to completion.
+        [[nodiscard]] bool done() const
+        {
+            return handle_ && handle_.done();
+        }
+
+        auto operator co_await() && noexcept
+        {
+            struct awaiter
+            {
+                std::coroutine_handle<promise_type> handle;
+
+                bool await_ready() const noexcept
+                {
+                    return !handle || handle.done();
+                }
+
+                std::coroutine_handle<> await_suspend(const std::coroutine_handle<> continuation) noexcept
+                {
+                    handle.promise().set_continuation(continuation);
+                    return handle;
+                }
+
+                T await_resume()
+                {
+                    return handle.promise().get_result();
+                }
+            };
+
+            return awaiter{handle_};
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+
+        explicit task(const std::coroutine_handle<promise_type> handle) : handle_(handle)
+        {
+        }
+
+        friend class detail::task_promise<T>;
+        friend void spawn(task<void> t);
+    };
+
+    namespace detail
+    {
+
+        template <typename T>
+        task<T> task_promise<T>::get_return_object() noexcept
+        {
+            return task<T>{std::coroutine_handle<task_promise>::from_promise(*this)};
+        }
+
+        inline task<void> task_promise<void>::get_return_object() noexcept
+        {
+            return task<void>{std::coroutine_handle<task_promise>::from_promise(*this)};
+        }
+
+    } // namespace detail
+
+    /// @brief Start a task without awaiting it.
+    ///
+    /// The task runs until its first suspension before this function returns and destroys itself when it completes.
+    /// As with std::thread, std::terminate is called if the task completes with an exception.
+    ///
+    /// @param t The task to start.
+    inline void spawn(task<void> t)
+    {
+        auto handle = std::exchange(t.handle_, {});
+        if (handle)
+        {
+            handle.promise().set_detached();
+            handle.resume();
+        }
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,58 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "common.hpp"
+#include "socket_id.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that wraps a pollable timer based on the monotonic clock.
+    ///
+    /// This is a timerfd and is only available on Linux; constructing one elsewhere throws. Register get_id() with a
+    /// poller using poller::poll_type::timer, which results in poller::poll_status::timer_expired once the timer has
+    /// expired, and call consume() to acknowledge the expirations.
+    ///
+    /// @note Timers that only need to run callbacks on an event loop are cheaper as event_loop timers; a timer_fd is
+    /// for waiting on a deadline with a bare poller, or sharing one with code that expects a descriptor.
+    class ASL_API timer_fd final
+    {
+    public:
+        timer_fd();
+        ~timer_fd();
+
+        timer_fd(const timer_fd&) = delete;
+        timer_fd& operator=(const timer_fd&) = delete;
+
+        timer_fd(timer_fd&& other) noexcept;
+        timer_fd& operator=(timer_fd&& other) noexcept;
+
+        /// @brief Retrieve the OS-level identifier to register with a poller.
+        [[nodiscard]] socket_id get_id() const
+        {
+            return id_;
+        }
+
+        /// @brief Start (or restart) the timer.
+        /// @param initial The time until the first expiration; must be greater than zero.
+        /// @param interval The time between subsequent expirations, or zero for a timer that expires once.
+        void arm(std::chrono::nanoseconds initial,
+                 std::chrono::nanoseconds interval = std::chrono::nanoseconds::zero());
+
+        /// @brief Stop the timer; expirations that have not been consumed are discarded.
+        void disarm();
+
+        /// @brief Acknowledge the expirations of the timer without blocking.
+        /// @returns The number of times the timer has expired since the last call, or zero if it has not.
+        std::uint64_t consume() const;
+
+    private:
+        socket_id id_ = k_invalid_socket;
+    };
+
+} // namespace jhoyt::asl
@@ -0,0 +1,174 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "common.hpp"
+
+namespace jhoyt::asl
+{
+
+    /// @brief Type that represents a Chase-Lev work-stealing deque.
+    ///
+    /// The owning thread pushes and pops at the bottom of the deque without contention, while any other thread may
+    /// steal from the top; the two ends only synchronise when a single element is left. The deque grows when full.
+    /// Arrays that have been replaced are kept until the deque is destroyed, because a thief may still be reading from
+    /// one.
+    ///
+    /// @tparam T The element type, typically a pointer; it must be trivially copyable so it can be stored atomically.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    class work_stealing_deque final
+    {
+    public:
+        static constexpr auto k_default_capacity = std::size_t{256};
+
+        /// @brief Construct a new deque.
+        /// @param capacity The initial number of elements the deque can hold; it is rounded up to a power of two.
+        explicit work_stealing_deque(const std::size_t capacity = k_default_capacity)
+        {
+            const auto& initial =
+                arrays_.emplace_back(std::make_unique<array>(std::bit_ceil(std::max<std::size_t>(capacity, 2))));
+            array_.store(initial.get(), std::memory_order_relaxed);
+        }
+
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+        /// @brief Retrieve an estimate of the number of elements in the deque; may be called from any thread.
+        [[nodiscard]] std::size_t get_size() const
+        {
+            const auto bottom = bottom_.load(std::memory_order_seq_cst);
+            const auto top = top_.load(std::memory_order_seq_cst);
+            return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+        }
+
+        /// @brief Check if the deque appears empty; may be called from any thread.
+        [[nodiscard]] bool empty() const
+        {
+            return get_size() == 0;
+        }
+
+        /// @brief Add an element to the bottom of the deque; must only be called by the owning thread.
+        /// @param value The element to add.
+        void push(const T value)
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed);
+            const auto top = top_.load(std::memory_order_acquire);
+            auto* a = array_.load(std::memory_order_relaxed);
+            if (bottom - top > static_cast<std::int64_t>(a->capacity) - 1)
+            {
+                a = grow(a, top, bottom);
+            }
+
+            a->put(bottom, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /// @brief Remove the element at the bottom of the deque; must only be called by the owning thread.
+        /// @returns The most recently pushed element, or std::nullopt if the deque is empty.
+        std::optional<T> pop()
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            auto* a = array_.load(std::memory_order_relaxed);
+            bottom_.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = top_.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            auto value = std::optional<T>{a->get(bottom)};
+            if (top == bottom)
+            {
+                // Last element: race any thieves for it.
+                if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    value.reset();
+                }
+
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return value;
+        }
+
+        /// @brief Remove the element at the top of the deque; may be called from any thread.
+        /// @returns The least recently pushed element, or std::nullopt if the deque is empty or another thread took
+        /// the element first.
+        std::optional<T> steal()
+        {
+            auto top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = bottom_.load(std::memory_order_acquire);
+            if (top >= bottom)
+            {
+                return std::nullopt;
+            }
+
+            auto* a = array_.load(std::memory_order_acquire);
+            const auto value = a->get(top);
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return std::nullopt;
+            }
+
+            return value;
+        }
+
+    private:
+        struct array
+        {
+            std::size_t capacity;
+            std::size_t mask;
+            std::unique_ptr<std::atomic<T>[]> slots;
+
+            explicit array(const std::size_t size)
+                : capacity(size), mask(size - 1), slots(std::make_unique<std::atomic<T>[]>(size))
+            {
+            }
+
+            T get(const std::int64_t ix) const
+            {
+                return slots[static_cast<std::size_t>(ix) & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(const std::int64_t ix, const T value)
+            {
+                slots[static_cast<std::size_t>(ix) & mask].store(value, std::memory_order_relaxed);
+            }
+        };
+
+        alignas(k_cache_line_size) std::atomic<std::int64_t> top_{0};
+        alignas(k_cache_line_size) std::atomic<std::int64_t> bottom_{0};
+        std::atomic<array*> array_{nullptr};
+        std::vector<std::unique_ptr<array>> arrays_;
+
+        array* grow(const array* old, const std::int64_t top, const std::int64_t bottom)
+        {
+            auto& bigger = arrays_.emplace_back(std::make_unique<array>(old->capacity * 2));
+            for (auto ix = top; ix < bottom; ++ix)
+            {
+                bigger->put(ix, old->get(ix));
+            }
+
+            array_.store(bigger.get(), std::memory_order_release);
+            return bigger.get();
+        }
+    };
+
+} // namespace jhoyt::asl
@@ -14,10 +14,13 @@ namespace jhoyt::asl::mock
     {
         socket_id arg_id;
         poller::poll_type arg_type;
+        poller::trigger_mode arg_mode;
         std::chrono::steady_clock::time_point when;
 
-        poller_modify_socket_call(const socket_id id, const poller::poll_type type)
-            : arg_id(id), arg_type(type), when(std::chrono::steady_clock::now())
+        poller_modify_socket_call(const socket_id id,
+                                  const poller::poll_type type,
+                                  const poller::trigger_mode mode = poller::trigger_mode::level)
+            : arg_id(id), arg_type(type), arg_mode(mode), when(std::chrono::steady_clock::now())
         {
         }
     };
@@ -36,6 +39,7 @@ namespace jhoyt::asl::mock
     };
 
     std::span<const poller_remove_socket_call> poller_get_remove_socket_calls();
+    std::span<const poller_remove_socket_call> poller_get_rearm_socket_calls();
 
     struct poller_poll_call
     {
@@ -47,6 +47,8 @@ namespace jhoyt::asl::mock
     void socket_set_set_reuse_address_option_throws(bool value);
     std::span<const socket_set_reuse_address_option_call> socket_get_set_reuse_address_option_calls();
 
+    void socket_add_incoming_cpu_result(std::optional<std::size_t> cpu);
+
     struct socket_shutdown_call : public socket_call
     {
         socket::shutdown_type arg_type;
@@ -10,6 +10,7 @@ namespace
     auto g_add_socket_calls = std::vector<mock::poller_modify_socket_call>{};
     auto g_update_socket_calls = std::vector<mock::poller_modify_socket_call>{};
     auto g_remove_socket_calls = std::vector<mock::poller_remove_socket_call>{};
+    auto g_rearm_socket_calls = std::vector<mock::poller_remove_socket_call>{};
     auto g_poll_calls = std::vector<mock::poller_poll_call>{};
     auto g_poll_throws = false;
     auto g_poll_results = std::vector<poller::poll_result>{};
@@ -23,11 +24,16 @@ namespace jhoyt::asl
     };
 
     poller::poller() = default;
+
+    poller::poller(threading_mode, std::size_t)
+    {
+    }
+
     poller::~poller() = default;
 
-    void poller::add_socket(socket_id id, poll_type type)
+    void poller::add_socket(socket_id id, poll_type type, trigger_mode mode)
     {
-        g_add_socket_calls.emplace_back(id, type);
+        g_add_socket_calls.emplace_back(id, type, mode);
     }
 
     void poller::update_socket(socket_id id, poll_type type)
@@ -35,6 +41,11 @@ namespace jhoyt::asl
         g_update_socket_calls.emplace_back(id, type);
     }
 
+    void poller::rearm_socket(socket_id id)
+    {
+        g_rearm_socket_calls.emplace_back(id);
+    }
+
     void poller::remove_socket(socket_id id)
     {
         g_remove_socket_calls.emplace_back(id);
@@ -60,6 +71,7 @@ namespace jhoyt::asl
             g_add_socket_calls.clear();
             g_update_socket_calls.clear();
             g_remove_socket_calls.clear();
+            g_rearm_socket_calls.clear();
             g_poll_calls.clear();
             g_poll_throws = false;
             g_poll_results.clear();
@@ -80,6 +92,11 @@ namespace jhoyt::asl
             return g_remove_socket_calls;
         }
 
+        std::span<const poller_remove_socket_call> poller_get_rearm_socket_calls()
+        {
+            return g_rearm_socket_calls;
+        }
+
         void poller_enqueue_poll_result(const poller::poll_result result)
         {
             g_poll_results.push_back(result);
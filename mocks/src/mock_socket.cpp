@@ -16,6 +16,7 @@ namespace
     auto g_close_calls = std::vector<mock::socket_call>{};
     auto g_set_reuse_address_option_throws = false;
     auto g_set_reuse_address_option_calls = std::vector<mock::socket_set_reuse_address_option_call>{};
+    auto g_incoming_cpu_results = std::queue<std::optional<std::size_t>>{};
     auto g_shutdown_throws = false;
     auto g_shutdown_calls = std::vector<mock::socket_shutdown_call>{};
     auto g_bind_throws = false;
@@ -42,7 +43,7 @@ namespace jhoyt::asl
 
     socket::~socket() = default;
 
-    socket::socket(socket& other) noexcept : sock_(other.sock_)
+    socket::socket(socket&& other) noexcept : sock_(other.sock_)
     {
         other.sock_ = k_invalid_socket;
     }
@@ -84,6 +85,23 @@ namespace jhoyt::asl
         }
     }
 
+    std::optional<std::size_t> socket::get_incoming_cpu_option() const
+    {
+        if (!g_incoming_cpu_results.empty())
+        {
+            const auto result = g_incoming_cpu_results.front();
+            g_incoming_cpu_results.pop();
+            return result;
+        }
+
+        return std::nullopt;
+    }
+
+    bool socket::set_busy_poll_option(std::chrono::microseconds, bool)
+    {
+        return false;
+    }
+
     void socket::shutdown(shutdown_type type)
     {
         g_shutdown_calls.emplace_back(sock_, type);
@@ -190,6 +208,17 @@ namespace jhoyt::asl
         return std::make_pair(socket::transfer_status::disconnected, 0);
     }
 
+    // Datagrams share the recorded calls and queued results of send and recv.
+    std::pair<socket::transfer_status, size_t> socket::send_to(std::span<const char> data, const raw_address&)
+    {
+        return send(data);
+    }
+
+    std::pair<socket::transfer_status, size_t> socket::recv_from(std::span<char> data, raw_address&)
+    {
+        return recv(data);
+    }
+
     namespace mock
     {
 
@@ -201,6 +230,10 @@ namespace jhoyt::asl
             g_close_calls.clear();
             g_set_reuse_address_option_throws = false;
             g_set_reuse_address_option_calls.clear();
+            while (!g_incoming_cpu_results.empty())
+            {
+                g_incoming_cpu_results.pop();
+            }
             g_shutdown_throws = false;
             g_shutdown_calls.clear();
             g_bind_throws = false;
@@ -258,6 +291,11 @@ namespace jhoyt::asl
             return g_set_reuse_address_option_calls;
         }
 
+        void socket_add_incoming_cpu_result(const std::optional<std::size_t> cpu)
+        {
+            g_incoming_cpu_results.push(cpu);
+        }
+
         void socket_set_shutdown_calls(const bool value)
         {
             g_shutdown_throws = value;
@@ -1,21 +1,57 @@
 // Copyright (c) 2025-present, Jason Hoyt
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
-#include <cassert>
+#include <cstring>
 #include <format>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#endif
 
 #include "jhoyt/asl/address.hpp"
 
+namespace
+{
+
+    /// Write host text with inet_ntop, which adds a NUL terminator, so it writes into a stack buffer first.
+    template <std::size_t MaxSize>
+    std::size_t write_host(const int family, const void* host, const std::span<char, MaxSize> out)
+    {
+        auto buf = std::array<char, MaxSize + 1>{};
+        if (!inet_ntop(family, host, buf.data(), static_cast<socklen_t>(buf.size())))
+        {
+            throw std::runtime_error{family == AF_INET ? "malformed ipv4 host" : "malformed ipv6 host"};
+        }
+
+        const auto size = strlen(buf.data());
+        std::copy_n(buf.data(), size, out.data());
+        return size;
+    }
+
+} // namespace
+
 namespace jhoyt::asl
 {
+
+    std::size_t ipv4_host::write_string(const std::span<char, k_max_string_size> out) const
+    {
+        return write_host(AF_INET, bytes_.data(), out);
+    }
+
+    std::size_t ipv6_host::write_string(const std::span<char, k_max_string_size> out) const
+    {
+        return write_host(AF_INET6, bytes_.data(), out);
+    }
+
     std::string to_string(const ipv4_address& addr)
     {
-        return std::format("{}:{}", addr.host, addr.port);
+        return std::format("{}", addr);
     }
 
     std::string to_string(const ipv6_address& addr)
     {
-        return std::format("{}:{}", addr.host, addr.port);
+        return std::format("{}", addr);
     }
 
     std::string to_string(const file_address& addr)
@@ -25,27 +61,7 @@ namespace jhoyt::asl
 
     std::string to_string(const address& addr)
     {
-        switch (get_address_type(addr))
-        {
-
-        case address_type::ipv4: {
-            const auto& [host, port] = *std::get_if<ipv4_address>(&addr);
-            return std::format("ipv4://{}:{}", host, port);
-        }
-
-        case address_type::ipv6: {
-            const auto& [host, port] = *std::get_if<ipv6_address>(&addr);
-            return std::format("ipv6://{}:{}", host, port);
-        }
-
-        case address_type::file: {
-            const auto& [path] = *std::get_if<file_address>(&addr);
-            return std::format("file://{}", path);
-        }
-
-        default:
-            assert(false);
-        }
+        return std::format("{}", addr);
     }
 
-} // namespace jhoyt::asl
\ No newline at end of file
+} // namespace jhoyt::asl
@@ -0,0 +1,423 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ASL_CIDR_LOOKUP_POPCNT
+#endif
+
+#include "jhoyt/asl/address_filter.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    /// An address as a 128-bit key, most significant bit first; an IPv4 address takes the top 32 bits.
+    using address_key = std::array<std::uint64_t, 2>;
+
+    /// The number of address bits covered by each trie node, which makes for 64-way nodes.
+    constexpr auto k_stride = 6u;
+
+    /// The number of leading address bits resolved by the direct table; a multiple of the stride.
+    constexpr auto k_direct_bits = 12u;
+
+    /// Set in a direct table entry (or a step result) that holds an action rather than a node index.
+    constexpr auto k_leaf_flag = std::uint32_t{1} << 31;
+
+    struct compiled_rule
+    {
+        address_key key;
+        unsigned length;
+        filter_action action;
+    };
+
+    template <std::size_t Size>
+    address_key make_key(const std::array<std::uint8_t, Size>& bytes)
+    {
+        auto key = address_key{};
+        for (auto ix = std::size_t{0}; ix < Size; ++ix)
+        {
+            key[ix / 8] |= std::uint64_t{bytes[ix]} << (56 - ix % 8 * 8);
+        }
+
+        return key;
+    }
+
+    address_key mask_key(address_key key, const unsigned length)
+    {
+        for (auto word = 0u; word < key.size(); ++word)
+        {
+            const auto start = word * 64;
+            if (length <= start)
+            {
+                key[word] = 0;
+            }
+            else if (length < start + 64)
+            {
+                key[word] &= ~std::uint64_t{0} << (start + 64 - length);
+            }
+        }
+
+        return key;
+    }
+
+    /// Retrieve the six bits of a key starting at a bit offset; bits past the end of the key are zero.
+    unsigned get_chunk(const address_key& key, const unsigned offset)
+    {
+        auto window = std::uint64_t{0};
+        if (offset == 0)
+        {
+            window = key[0];
+        }
+        else if (offset < 64)
+        {
+            window = key[0] << offset | key[1] >> (64 - offset);
+        }
+        else
+        {
+            window = key[1] << (offset - 64);
+        }
+
+        return static_cast<unsigned>(window >> (64 - k_stride));
+    }
+
+    /// Compile the node at an index from the rules that are longer than its bit offset and share its prefix.
+    void build_node(detail::cidr_trie& trie,
+                    const std::size_t index,
+                    const unsigned offset,
+                    const std::vector<compiled_rule>& rules,
+                    const filter_action inherited)
+    {
+        auto actions = std::array<filter_action, 64>{};
+        actions.fill(inherited);
+
+        auto deeper = std::array<std::vector<compiled_rule>, 64>{};
+        auto ending = std::vector<const compiled_rule*>{};
+        for (const auto& rule : rules)
+        {
+            if (rule.length > offset + k_stride)
+            {
+                deeper[get_chunk(rule.key, offset)].push_back(rule);
+            }
+            else
+            {
+                ending.push_back(&rule);
+            }
+        }
+
+        // A rule that ends within this node sets the action of every chunk value it covers. Shorter prefixes go first
+        // so that longer ones override them, and the sort is stable so that a later rule for the same network wins.
+        std::ranges::stable_sort(ending, {}, [](const compiled_rule* rule) { return rule->length; });
+        for (const auto* rule : ending)
+        {
+            const auto first = get_chunk(rule->key, offset);
+            std::fill_n(actions.begin() + first, 1u << (offset + k_stride - rule->length), rule->action);
+        }
+
+        auto node = detail::cidr_node{};
+        node.leaf_base = static_cast<std::uint32_t>(trie.leaves.size());
+        auto last = std::optional<filter_action>{};
+        for (auto chunk = 0u; chunk < actions.size(); ++chunk)
+        {
+            const auto bit = std::uint64_t{1} << chunk;
+            if (!deeper[chunk].empty())
+            {
+                node.children |= bit;
+            }
+            else if (last != actions[chunk])
+            {
+                node.leaves |= bit;
+                trie.leaves.push_back(actions[chunk]);
+                last = actions[chunk];
+            }
+        }
+
+        // The children of a node are stored next to each other, so one base index and a count of bits finds them.
+        node.child_base = static_cast<std::uint32_t>(trie.nodes.size());
+        trie.nodes.resize(trie.nodes.size() + static_cast<std::size_t>(std::popcount(node.children)));
+        trie.nodes[index] = node;
+
+        auto child = std::size_t{node.child_base};
+        for (auto chunk = 0u; chunk < actions.size(); ++chunk)
+        {
+            if (!deeper[chunk].empty())
+            {
+                build_node(trie, child++, offset + k_stride, deeper[chunk], actions[chunk]);
+            }
+        }
+    }
+
+    /// Follow a chunk value from a node, returning the index of the child node or the action of the leaf (with
+    /// k_leaf_flag set).
+    inline std::uint32_t follow_chunk(const detail::cidr_trie& trie, const detail::cidr_node& node, const unsigned chunk)
+    {
+        const auto through_chunk = ~std::uint64_t{0} >> (63 - chunk);
+        if ((node.children >> chunk & 1) == 0)
+        {
+            const auto leaf = static_cast<std::size_t>(std::popcount(node.leaves & through_chunk)) - 1;
+            return k_leaf_flag | static_cast<std::uint32_t>(trie.leaves[node.leaf_base + leaf]);
+        }
+
+        return node.child_base + static_cast<std::uint32_t>(std::popcount(node.children & through_chunk)) - 1;
+    }
+
+    detail::cidr_trie compile_trie(const std::vector<compiled_rule>& rules, const filter_action default_action)
+    {
+        // A /0 rule replaces the default action, which is where every lookup starts.
+        auto root_action = default_action;
+        auto longer = std::vector<compiled_rule>{};
+        for (const auto& rule : rules)
+        {
+            if (rule.length == 0)
+            {
+                root_action = rule.action;
+            }
+            else
+            {
+                longer.push_back(rule);
+            }
+        }
+
+        auto trie = detail::cidr_trie{};
+        trie.nodes.resize(1);
+        build_node(trie, 0, 0, longer, root_action);
+
+        // The top levels are walked once for every value of the leading bits, so a lookup starts further down.
+        trie.direct.resize(std::size_t{1} << k_direct_bits);
+        for (auto prefix = std::size_t{0}; prefix < trie.direct.size(); ++prefix)
+        {
+            const auto key = address_key{std::uint64_t{prefix} << (64 - k_direct_bits), 0};
+            auto entry = std::uint32_t{0};
+            for (auto offset = 0u; offset < k_direct_bits && (entry & k_leaf_flag) == 0; offset += k_stride)
+            {
+                entry = follow_chunk(trie, trie.nodes[entry], get_chunk(key, offset));
+            }
+
+            trie.direct[prefix] = entry;
+        }
+
+        return trie;
+    }
+
+    inline filter_action lookup_trie_generic(const detail::cidr_trie& trie, const address_key& key)
+    {
+        auto entry = trie.direct[key[0] >> (64 - k_direct_bits)];
+        for (auto offset = k_direct_bits; (entry & k_leaf_flag) == 0; offset += k_stride)
+        {
+            entry = follow_chunk(trie, trie.nodes[entry], get_chunk(key, offset));
+        }
+
+        return static_cast<filter_action>(entry & ~k_leaf_flag);
+    }
+
+#if defined(ASL_CIDR_LOOKUP_POPCNT)
+
+    /// The same lookup compiled for the popcnt instruction, which is otherwise a library call on x86-64.
+    __attribute__((target("popcnt"))) filter_action lookup_trie_popcnt(const detail::cidr_trie& trie,
+                                                                       const address_key& key)
+    {
+        return lookup_trie_generic(trie, key);
+    }
+
+    const bool k_has_popcnt = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("popcnt") != 0;
+    }();
+
+#endif
+
+    filter_action lookup_trie(const detail::cidr_trie& trie, const address_key& key)
+    {
+#if defined(ASL_CIDR_LOOKUP_POPCNT)
+        if (k_has_popcnt)
+        {
+            return lookup_trie_popcnt(trie, key);
+        }
+#endif
+
+        return lookup_trie_generic(trie, key);
+    }
+
+    bool is_ipv4_mapped(const std::array<std::uint8_t, 16>& bytes)
+    {
+        return std::all_of(bytes.begin(), bytes.begin() + 10, [](const std::uint8_t b) { return b == 0; }) &&
+               bytes[10] == 0xff && bytes[11] == 0xff;
+    }
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    std::optional<cidr_rule> parse_cidr_rule(const std::string_view text, const filter_action action)
+    {
+        const auto slash = text.find('/');
+        const auto host_text = text.substr(0, slash);
+
+        auto prefix_length = std::optional<std::uint32_t>{};
+        if (slash != std::string_view::npos)
+        {
+            auto value = std::uint32_t{0};
+            if (!detail::parse_decimal(text.substr(slash + 1), 128, value))
+            {
+                return std::nullopt;
+            }
+
+            prefix_length = value;
+        }
+
+        if (auto bytes = ipv4_host::bytes_type{}; detail::parse_ipv4_bytes(host_text, bytes))
+        {
+            if (prefix_length.value_or(32) > 32)
+            {
+                return std::nullopt;
+            }
+
+            return cidr_rule{ipv4_host{bytes}, static_cast<std::uint8_t>(prefix_length.value_or(32)), action};
+        }
+
+        if (auto bytes = ipv6_host::bytes_type{}; detail::parse_ipv6_bytes(host_text, bytes))
+        {
+            return cidr_rule{ipv6_host{bytes}, static_cast<std::uint8_t>(prefix_length.value_or(128)), action};
+        }
+
+        return std::nullopt;
+    }
+
+    cidr_table::cidr_table() : cidr_table(std::span<const cidr_rule>{})
+    {
+    }
+
+    cidr_table::cidr_table(const std::span<const cidr_rule> rules, const filter_action default_action)
+        : default_action_(default_action)
+    {
+        auto ipv4_rules = std::vector<compiled_rule>{};
+        auto ipv6_rules = std::vector<compiled_rule>{};
+        for (const auto& [network, prefix_length, action] : rules)
+        {
+            if (const auto* host = std::get_if<ipv4_host>(&network))
+            {
+                if (prefix_length > 32)
+                {
+                    throw std::runtime_error{"ipv4 cidr prefix length is too long"};
+                }
+
+                ipv4_rules.push_back({mask_key(make_key(host->get_bytes()), prefix_length), prefix_length, action});
+            }
+            else
+            {
+                if (prefix_length > 128)
+                {
+                    throw std::runtime_error{"ipv6 cidr prefix length is too long"};
+                }
+
+                const auto& bytes = std::get<ipv6_host>(network).get_bytes();
+                ipv6_rules.push_back({mask_key(make_key(bytes), prefix_length), prefix_length, action});
+            }
+        }
+
+        ipv4_ = compile_trie(ipv4_rules, default_action);
+        ipv6_ = compile_trie(ipv6_rules, default_action);
+    }
+
+    filter_action cidr_table::lookup(const raw_address& addr) const
+    {
+        // Only the OS-level address is read; an empty or unnamed address is shorter than any IP address.
+        const auto data = addr.get_data();
+        if (data.size() < sizeof(sockaddr_in))
+        {
+            return default_action_;
+        }
+
+        auto family = sa_family_t{};
+        memcpy(&family, data.data() + offsetof(sockaddr, sa_family), sizeof(family));
+        if (family == AF_INET)
+        {
+            auto ipv4_data = sockaddr_in{};
+            memcpy(&ipv4_data, data.data(), sizeof(ipv4_data));
+            return lookup_trie(ipv4_, {std::uint64_t{ntohl(ipv4_data.sin_addr.s_addr)} << 32, 0});
+        }
+
+        if (family == AF_INET6)
+        {
+            auto ipv6_data = sockaddr_in6{};
+            memcpy(&ipv6_data, data.data(), sizeof(ipv6_data));
+            const auto bytes = std::bit_cast<std::array<std::uint8_t, 16>>(ipv6_data.sin6_addr);
+            if (is_ipv4_mapped(bytes))
+            {
+                return lookup_trie(ipv4_, make_key(std::array{bytes[12], bytes[13], bytes[14], bytes[15]}));
+            }
+
+            return lookup_trie(ipv6_, make_key(bytes));
+        }
+
+        return default_action_;
+    }
+
+    address_filter::address_filter(cidr_table table)
+        : accept_([](const address_filter& self, socket& listener, socket& sock, raw_address& addr) {
+              return self.accept(listener, sock, addr);
+          }),
+          table_(new cidr_table{std::move(table)})
+    {
+    }
+
+    address_filter::~address_filter()
+    {
+        delete table_.load();
+    }
+
+    void address_filter::update(cidr_table table)
+    {
+        auto next = std::make_unique<const cidr_table>(std::move(table));
+
+        const auto lock = std::scoped_lock{update_mutex_};
+        const auto* old = table_.exchange(next.release());
+
+        // Lookups that may have read the old table registered in the current epoch. Lookups that register in the next
+        // one read the new table, so only the current epoch has to drain before the old table is freed.
+        const auto epoch = epoch_.fetch_add(1);
+        while (readers_[epoch & 1].load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+
+        delete old;
+    }
+
+    bool address_filter::is_allowed(const raw_address& addr) const
+    {
+        // If an update moves on to the next epoch while registering, the lookup registers there instead, as the update
+        // only waits for the readers of the epoch it ended.
+        auto epoch = epoch_.load();
+        for (;;)
+        {
+            readers_[epoch & 1].fetch_add(1);
+            const auto current = epoch_.load();
+            if (current == epoch)
+            {
+                break;
+            }
+
+            readers_[epoch & 1].fetch_sub(1, std::memory_order_release);
+            epoch = current;
+        }
+
+        const auto action = table_.load(std::memory_order_acquire)->lookup(addr);
+        readers_[epoch & 1].fetch_sub(1, std::memory_order_release);
+        return action == filter_action::allow;
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,51 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cstring>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#endif
+
+#include "jhoyt/asl/address_map.hpp"
+
+namespace jhoyt::asl::detail
+{
+
+    address_key make_address_key(const raw_address& addr)
+    {
+        const auto data = addr.get_data();
+        auto storage = sockaddr_storage{};
+        memcpy(&storage, data.data(), data.size());
+
+        auto key = address_key{};
+        switch (storage.ss_family)
+        {
+
+        case AF_INET: {
+            const auto& ipv4_data = *reinterpret_cast<const sockaddr_in*>(&storage);
+            memcpy(key.host.data(), &ipv4_data.sin_addr, sizeof(ipv4_data.sin_addr));
+            key.port = ntohs(ipv4_data.sin_port);
+            key.type = static_cast<std::uint16_t>(address_type::ipv4);
+            break;
+        }
+
+        case AF_INET6: {
+            const auto& ipv6_data = *reinterpret_cast<const sockaddr_in6*>(&storage);
+            memcpy(key.host.data(), &ipv6_data.sin6_addr, sizeof(ipv6_data.sin6_addr));
+            key.scope_id = ipv6_data.sin6_scope_id;
+            key.port = ntohs(ipv6_data.sin6_port);
+            key.type = static_cast<std::uint16_t>(address_type::ipv6);
+            break;
+        }
+
+        default:
+            throw std::runtime_error{"address maps only hold ipv4 and ipv6 addresses"};
+        }
+
+        return key;
+    }
+
+} // namespace jhoyt::asl::detail
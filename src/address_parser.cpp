@@ -0,0 +1,225 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ASL_PARSE_IPV4_SSSE3
+#include <immintrin.h>
+#endif
+
+#include "jhoyt/asl/address.hpp"
+
+namespace
+{
+
+#if defined(ASL_PARSE_IPV4_SSSE3)
+
+    /// The shortest and longest dotted-quad text, "0.0.0.0" and "255.255.255.255".
+    constexpr auto k_min_ipv4_size = std::size_t{7};
+    constexpr auto k_max_ipv4_size = std::size_t{15};
+
+    /// A shuffle that moves the digits of the four fields into four 32-bit lanes laid out as {hundreds, tens, ones, 0},
+    /// with missing digits zeroed (0x80), for each of the 81 combinations of field lengths. The pattern for lengths
+    /// l0..l3 is at index (l0 - 1) * 27 + (l1 - 1) * 9 + (l2 - 1) * 3 + (l3 - 1).
+    constexpr auto k_digit_shuffles = [] {
+        auto result = std::array<std::array<std::uint8_t, 16>, 81>{};
+        for (auto index = std::size_t{0}; index < result.size(); ++index)
+        {
+            auto& shuffle = result[index];
+            shuffle.fill(0x80);
+
+            auto start = std::size_t{0};
+            auto lengths = index;
+            for (auto field = std::size_t{0}; field < 4; ++field)
+            {
+                const auto length = lengths / 27 + 1;
+                lengths = lengths % 27 * 3;
+                for (auto digit = std::size_t{0}; digit < length; ++digit)
+                {
+                    shuffle[field * 4 + 3 - length + digit] = static_cast<std::uint8_t>(start + digit);
+                }
+
+                start += length + 1;
+            }
+        }
+
+        return result;
+    }();
+
+    /// For each text size, a shuffle that moves the bytes of the second of two overlapping loads (see load_text) to
+    /// where they belong, and zeroes the rest.
+    constexpr auto k_tail_shuffles = [] {
+        auto result = std::array<std::array<std::uint8_t, 16>, k_max_ipv4_size + 1>{};
+        for (auto size = k_min_ipv4_size; size <= k_max_ipv4_size; ++size)
+        {
+            const auto head_size = size < 8 ? std::size_t{4} : std::size_t{8};
+            result[size].fill(0x80);
+            for (auto ix = head_size; ix < size; ++ix)
+            {
+                result[size][ix] = static_cast<std::uint8_t>(ix - (size - head_size));
+            }
+        }
+
+        return result;
+    }();
+
+    /// Load text of k_min_ipv4_size to k_max_ipv4_size characters into a zero filled vector without reading past its
+    /// end. The head and the tail are loaded separately, overlapping in the middle, and the tail is shuffled into
+    /// place.
+    __attribute__((target("ssse3"))) inline __m128i load_text(const std::string_view text)
+    {
+        auto head = __m128i{};
+        auto tail = __m128i{};
+        if (text.size() < 8)
+        {
+            auto head_bits = std::uint32_t{0};
+            auto tail_bits = std::uint32_t{0};
+            std::memcpy(&head_bits, text.data(), 4);
+            std::memcpy(&tail_bits, text.data() + text.size() - 4, 4);
+            head = _mm_cvtsi32_si128(static_cast<int>(head_bits));
+            tail = _mm_cvtsi32_si128(static_cast<int>(tail_bits));
+        }
+        else
+        {
+            auto head_bits = std::uint64_t{0};
+            auto tail_bits = std::uint64_t{0};
+            std::memcpy(&head_bits, text.data(), 8);
+            std::memcpy(&tail_bits, text.data() + text.size() - 8, 8);
+            head = _mm_cvtsi64_si128(static_cast<long long>(head_bits));
+            tail = _mm_cvtsi64_si128(static_cast<long long>(tail_bits));
+        }
+
+        const auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k_tail_shuffles[text.size()].data()));
+        return _mm_or_si128(head, _mm_shuffle_epi8(tail, shuffle));
+    }
+
+    /// Parse one host with SSSE3: the text is checked and its dots found with vector compares, the field lengths
+    /// select a shuffle that lines the digits up, and a multiply-add turns them into the four field values.
+    __attribute__((target("ssse3"))) inline bool parse_ipv4_ssse3(const std::string_view text,
+                                                                  std::array<std::uint8_t, 4>& out)
+    {
+        if (text.size() < k_min_ipv4_size || text.size() > k_max_ipv4_size)
+        {
+            return false;
+        }
+
+        const auto chars = load_text(text);
+        const auto digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+        const auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+        const auto used = (1u << text.size()) - 1;
+        const auto digit_mask = static_cast<unsigned>(_mm_movemask_epi8(is_digit)) & used;
+        const auto dot_mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('.'))));
+        if ((digit_mask | dot_mask) != used)
+        {
+            return false;
+        }
+
+        // Exactly three dots, taken off the mask from the lowest.
+        const auto after_dot0 = dot_mask & (dot_mask - 1);
+        const auto after_dot1 = after_dot0 & (after_dot0 - 1);
+        if (after_dot1 == 0 || (after_dot1 & (after_dot1 - 1)) != 0)
+        {
+            return false;
+        }
+
+        const auto dot0 = static_cast<std::size_t>(std::countr_zero(dot_mask));
+        const auto dot1 = static_cast<std::size_t>(std::countr_zero(after_dot0));
+        const auto dot2 = static_cast<std::size_t>(std::countr_zero(after_dot1));
+        const auto lengths = std::array<std::size_t, 4>{dot0, dot1 - dot0 - 1, dot2 - dot1 - 1, text.size() - dot2 - 1};
+        for (const auto length : lengths)
+        {
+            if (length == 0 || length > 3)
+            {
+                return false;
+            }
+        }
+
+        // A field starts at the front or after a dot; it has a leading zero if it starts with '0' followed by a digit.
+        const auto starts = dot_mask << 1 | 1;
+        const auto zero_mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('0'))));
+        if ((starts & zero_mask & digit_mask >> 1) != 0)
+        {
+            return false;
+        }
+
+        const auto index = (lengths[0] - 1) * 27 + (lengths[1] - 1) * 9 + (lengths[2] - 1) * 3 + (lengths[3] - 1);
+        const auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k_digit_shuffles[index].data()));
+        const auto lined_up = _mm_shuffle_epi8(digits, shuffle);
+
+        // {100h + 10t, o} in 16 bits, then 100h + 10t + o in 32 bits.
+        const auto weights = _mm_setr_epi8(100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0);
+        const auto values = _mm_madd_epi16(_mm_maddubs_epi16(lined_up, weights), _mm_set1_epi16(1));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(values, _mm_set1_epi32(255))) != 0)
+        {
+            return false;
+        }
+
+        const auto low_bytes = _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const auto packed = _mm_shuffle_epi8(values, low_bytes);
+        out = std::bit_cast<std::array<std::uint8_t, 4>>(_mm_cvtsi128_si32(packed));
+        return true;
+    }
+
+    /// The whole loop is compiled for SSSE3 so that the per-host parse is inlined into it.
+    __attribute__((target("ssse3"))) std::size_t parse_ipv4_hosts_ssse3(
+        const std::span<const std::string_view> texts, const std::span<jhoyt::asl::ipv4_host> hosts)
+    {
+        auto bytes = jhoyt::asl::ipv4_host::bytes_type{};
+        for (auto ix = std::size_t{0}; ix < texts.size(); ++ix)
+        {
+            if (!parse_ipv4_ssse3(texts[ix], bytes))
+            {
+                return ix;
+            }
+
+            hosts[ix] = jhoyt::asl::ipv4_host{bytes};
+        }
+
+        return texts.size();
+    }
+
+    const bool k_has_ssse3 = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3") != 0;
+    }();
+
+#endif
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    std::size_t parse_ipv4_hosts(const std::span<const std::string_view> texts, const std::span<ipv4_host> hosts)
+    {
+        if (hosts.size() < texts.size())
+        {
+            throw std::runtime_error{"not enough room for the parsed hosts"};
+        }
+
+#if defined(ASL_PARSE_IPV4_SSSE3)
+        if (k_has_ssse3)
+        {
+            return parse_ipv4_hosts_ssse3(texts, hosts);
+        }
+#endif
+
+        auto bytes = ipv4_host::bytes_type{};
+        for (auto ix = std::size_t{0}; ix < texts.size(); ++ix)
+        {
+            if (!detail::parse_ipv4_bytes(texts[ix], bytes))
+            {
+                return ix;
+            }
+
+            hosts[ix] = ipv4_host{bytes};
+        }
+
+        return texts.size();
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,60 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cassert>
+
+#include "jhoyt/asl/broadcaster.hpp"
+
+namespace jhoyt::asl
+{
+
+    std::size_t broadcaster::broadcast(const std::span<socket* const> sockets, const shared_buffer& buf)
+    {
+        for (auto* sock : sockets)
+        {
+            assert(sock && *sock);
+            queues_[sock->get_id()].push(buf);
+        }
+
+        auto pending = std::size_t{0};
+        for (auto* sock : sockets)
+        {
+            if (flush(*sock) == socket::transfer_status::blocked)
+            {
+                ++pending;
+            }
+        }
+
+        return pending;
+    }
+
+    socket::transfer_status broadcaster::flush(socket& sock)
+    {
+        const auto it = queues_.find(sock.get_id());
+        if (it == queues_.end())
+        {
+            return socket::transfer_status::success;
+        }
+
+        // Drained queues are kept so that the next broadcast does not have to allocate a new one.
+        const auto status = it->second.flush(sock);
+        if (status == socket::transfer_status::disconnected)
+        {
+            queues_.erase(it);
+        }
+
+        return status;
+    }
+
+    bool broadcaster::has_pending(const socket_id id) const
+    {
+        const auto it = queues_.find(id);
+        return it != queues_.end() && !it->second.empty();
+    }
+
+    void broadcaster::remove(const socket_id id)
+    {
+        queues_.erase(id);
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,44 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cassert>
+
+#include "jhoyt/asl/buffer_pool.hpp"
+
+namespace jhoyt::asl
+{
+
+    buffer_pool::buffer_pool(const std::size_t buffer_size, const std::size_t buffers_per_slab)
+        : buffer_size_(buffer_size), buffers_per_slab_(buffers_per_slab)
+    {
+        assert(buffer_size_ > 0);
+        assert(buffers_per_slab_ > 0);
+    }
+
+    std::span<char> buffer_pool::acquire()
+    {
+        if (free_.empty())
+        {
+            // Slabs are never returned to the allocator, so the pool only ever grows to its high-water mark.
+            auto& slab = slabs_.emplace_back(std::make_unique_for_overwrite<char[]>(buffer_size_ * buffers_per_slab_));
+            free_.reserve(get_allocated_count());
+            for (auto ix = buffers_per_slab_; ix > 0; --ix)
+            {
+                free_.push_back(slab.get() + (ix - 1) * buffer_size_);
+            }
+        }
+
+        auto* buffer = free_.back();
+        free_.pop_back();
+        return {buffer, buffer_size_};
+    }
+
+    void buffer_pool::release(const std::span<char> buffer)
+    {
+        assert(buffer.size() == buffer_size_);
+        assert(free_.size() < get_allocated_count());
+
+        free_.push_back(buffer.data());
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,299 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#endif
+
+#include "jhoyt/asl/connect_race.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    sa_family_t get_family(const raw_address& addr)
+    {
+        const auto data = addr.get_data();
+        auto family = sa_family_t{AF_UNSPEC};
+        if (data.size() >= offsetof(sockaddr, sa_family) + sizeof(family))
+        {
+            memcpy(&family, data.data() + offsetof(sockaddr, sa_family), sizeof(family));
+        }
+
+        return family;
+    }
+
+    socket_domain get_domain(const raw_address& addr)
+    {
+        switch (get_family(addr))
+        {
+
+        case AF_INET6:
+            return socket_domain::ipv6;
+
+        case AF_UNIX:
+            return socket_domain::file;
+
+        default:
+            return socket_domain::ipv4;
+        }
+    }
+
+} // namespace
+
+namespace jhoyt::asl::detail
+{
+
+    std::vector<raw_address> order_connect_candidates(const std::span<const raw_address> candidates,
+                                                      const std::size_t first_family_count)
+    {
+        if (candidates.empty())
+        {
+            return {};
+        }
+
+        const auto preferred_family = get_family(candidates.front());
+        auto preferred = std::vector<const raw_address*>{};
+        auto others = std::vector<const raw_address*>{};
+        for (const auto& candidate : candidates)
+        {
+            (get_family(candidate) == preferred_family ? preferred : others).push_back(&candidate);
+        }
+
+        auto ordered = std::vector<raw_address>{};
+        ordered.reserve(candidates.size());
+
+        auto next_preferred = preferred.begin();
+        auto next_other = others.begin();
+        for (auto count = std::max<std::size_t>(first_family_count, 1); count > 0 && next_preferred != preferred.end();
+             --count)
+        {
+            ordered.push_back(**next_preferred++);
+        }
+
+        while (next_preferred != preferred.end() || next_other != others.end())
+        {
+            if (next_other != others.end())
+            {
+                ordered.push_back(**next_other++);
+            }
+
+            if (next_preferred != preferred.end())
+            {
+                ordered.push_back(**next_preferred++);
+            }
+        }
+
+        return ordered;
+    }
+
+} // namespace jhoyt::asl::detail
+
+namespace jhoyt::asl
+{
+
+    /// A connection attempt to one candidate, which is its own waiter for the connection to complete.
+    struct connect_race::attempt : io_waiter
+    {
+        connect_race* owner = nullptr;
+        std::size_t candidate = 0;
+        socket sock;
+    };
+
+    connect_race::connect_race(event_loop& loop, const connect_race_options options) : loop_(loop), options_(options)
+    {
+        delay_timer_.on_expired = &connect_race::on_delay_expired;
+        delay_timer_.owner = this;
+        deadline_timer_.on_expired = &connect_race::on_deadline_expired;
+        deadline_timer_.owner = this;
+    }
+
+    connect_race::~connect_race()
+    {
+        cancel();
+    }
+
+    void connect_race::start(const std::span<const raw_address> candidates, const race_handler handler)
+    {
+        cancel();
+
+        candidates_ = detail::order_connect_candidates(candidates, options_.first_family_count);
+        attempts_.clear();
+        attempts_.reserve(candidates_.size());
+        handler_ = handler;
+        status_ = status::running;
+        socket_ = socket{};
+        address_ = raw_address{};
+
+        if (options_.timeout.count() > 0)
+        {
+            loop_.schedule_after(deadline_timer_, options_.timeout);
+        }
+
+        start_next();
+    }
+
+    connect_race_awaiter connect_race::async_connect(const std::span<const raw_address> candidates)
+    {
+        return {*this, candidates};
+    }
+
+    void connect_race::cancel()
+    {
+        if (status_ != status::running)
+        {
+            return;
+        }
+
+        close_attempts();
+        loop_.cancel(delay_timer_);
+        loop_.cancel(deadline_timer_);
+        status_ = status::idle;
+    }
+
+    void connect_race::start_next()
+    {
+        loop_.cancel(delay_timer_);
+
+        // Candidates that fail right away (e.g. an IPv6 address on a host without IPv6) are skipped without waiting
+        // for the attempt delay.
+        while (attempts_.size() < candidates_.size())
+        {
+            auto& current = *attempts_.emplace_back(std::make_unique<attempt>());
+            current.on_ready = &connect_race::notify;
+            current.owner = this;
+            current.candidate = attempts_.size() - 1;
+
+            const auto& addr = candidates_[current.candidate];
+            try
+            {
+                current.sock.open(get_domain(addr), socket_type::stream);
+                if (current.sock.connect(addr) == socket::connect_status::connected)
+                {
+                    complete(status::connected, &current);
+                    return;
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                current.sock.close();
+                continue;
+            }
+
+            loop_.wait(current.sock.get_id(), event_loop::wait_type::connect, current);
+            ++pending_;
+            if (attempts_.size() < candidates_.size())
+            {
+                loop_.schedule_after(delay_timer_, options_.attempt_delay);
+            }
+
+            return;
+        }
+
+        if (pending_ == 0)
+        {
+            complete(status::failed, nullptr);
+        }
+    }
+
+    void connect_race::on_attempt_ready(attempt& current, const poller::poll_status poll)
+    {
+        --pending_;
+        if (poll == poller::poll_status::connection_succeeded)
+        {
+            complete(status::connected, &current);
+            return;
+        }
+
+        // A failed attempt starts the next one straight away rather than waiting out the attempt delay.
+        loop_.cancel(current.sock.get_id());
+        current.sock.close();
+        start_next();
+    }
+
+    void connect_race::complete(const status result, attempt* winner)
+    {
+        if (winner != nullptr)
+        {
+            loop_.cancel(winner->sock.get_id());
+            socket_ = std::move(winner->sock);
+            address_ = candidates_[winner->candidate];
+        }
+
+        close_attempts();
+        loop_.cancel(delay_timer_);
+        loop_.cancel(deadline_timer_);
+        status_ = result;
+
+        // The handler may destroy the race, so it is called last.
+        const auto handler = handler_;
+        handler.on_completed(handler.object, *this);
+    }
+
+    void connect_race::close_attempts()
+    {
+        for (auto& current : attempts_)
+        {
+            if (current->sock)
+            {
+                loop_.cancel(current->sock.get_id());
+                current->sock.close();
+            }
+        }
+
+        pending_ = 0;
+    }
+
+    void connect_race::notify(io_waiter& self, const poller::poll_status poll)
+    {
+        auto& current = static_cast<attempt&>(self);
+        current.owner->on_attempt_ready(current, poll);
+    }
+
+    void connect_race::on_delay_expired(timer& self)
+    {
+        static_cast<race_timer&>(self).owner->start_next();
+    }
+
+    void connect_race::on_deadline_expired(timer& self)
+    {
+        static_cast<race_timer&>(self).owner->complete(status::timed_out, nullptr);
+    }
+
+    connect_race_awaiter::~connect_race_awaiter()
+    {
+        if (handle_ && !completed_)
+        {
+            race_.cancel();
+        }
+    }
+
+    bool connect_race_awaiter::await_suspend(const std::coroutine_handle<> handle)
+    {
+        // A race that completes right away (e.g. every candidate failed to open) does not suspend the coroutine.
+        race_.start(candidates_, *this);
+        if (completed_)
+        {
+            return false;
+        }
+
+        handle_ = handle;
+        return true;
+    }
+
+    void connect_race_awaiter::on_race_completed(connect_race&)
+    {
+        completed_ = true;
+        if (handle_)
+        {
+            handle_.resume();
+        }
+    }
+
+} // namespace jhoyt::asl
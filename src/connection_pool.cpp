@@ -0,0 +1,495 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "jhoyt/asl/address.hpp"
+#include "jhoyt/asl/address_map.hpp"
+#include "jhoyt/asl/connection_pool.hpp"
+
+namespace jhoyt::asl::detail
+{
+
+    /// A connection that is owned by the pool while it connects or idles. It is its own waiter, for the connection to
+    /// complete or for an idle connection to become readable, and its own connect or idle timer.
+    struct pool_connection : timer, io_waiter
+    {
+        pool_destination* destination = nullptr;
+        socket sock;
+        bool connecting = false;
+        pool_connection* prev = nullptr;
+        pool_connection* next = nullptr;
+    };
+
+    /// A list of connections, linked through their prev and next fields with the most recently added at the head.
+    struct pool_connection_list
+    {
+        pool_connection* head = nullptr;
+        pool_connection* tail = nullptr;
+        std::size_t size = 0;
+
+        void push_front(pool_connection& conn)
+        {
+            conn.prev = nullptr;
+            conn.next = head;
+            (head ? head->prev : tail) = &conn;
+            head = &conn;
+            ++size;
+        }
+
+        void erase(pool_connection& conn)
+        {
+            (conn.prev ? conn.prev->next : head) = conn.next;
+            (conn.next ? conn.next->prev : tail) = conn.prev;
+            conn.prev = nullptr;
+            conn.next = nullptr;
+            --size;
+        }
+    };
+
+    struct pool_destination
+    {
+        connection_pool* pool = nullptr;
+        raw_address addr;
+        pool_connection_list idle;
+        pool_connection_list connecting;
+        std::size_t checked_out = 0;
+        checkout_request* head = nullptr;
+        checkout_request* tail = nullptr;
+        std::size_t waiting = 0;
+
+        [[nodiscard]] std::size_t get_open_count() const
+        {
+            return idle.size + connecting.size + checked_out;
+        }
+    };
+
+} // namespace jhoyt::asl::detail
+
+namespace jhoyt::asl
+{
+    using detail::pool_connection;
+    using detail::pool_destination;
+
+    struct connection_pool::impl
+    {
+        connection_pool& owner;
+        event_loop& loop;
+        connection_pool_options options;
+        address_map<std::unique_ptr<pool_destination>> destinations;
+
+        /// Every connection record ever allocated; those not in use are kept on the free list for the next connection.
+        std::vector<std::unique_ptr<pool_connection>> records;
+        std::vector<pool_connection*> free_records;
+        connection_pool::stats counters;
+
+        impl(connection_pool& o, event_loop& l, const connection_pool_options& opts) : owner(o), loop(l), options(opts)
+        {
+        }
+
+        pool_destination& get_destination(const raw_address& addr)
+        {
+            auto& destination = destinations[addr];
+            if (!destination)
+            {
+                destination = std::make_unique<pool_destination>();
+                destination->pool = &owner;
+                destination->addr = addr;
+            }
+
+            return *destination;
+        }
+
+        pool_connection& acquire(pool_destination& destination)
+        {
+            if (free_records.empty())
+            {
+                auto& record = *records.emplace_back(std::make_unique<pool_connection>());
+                record.on_expired = &impl::on_expired;
+                record.on_ready = &impl::on_ready;
+                free_records.push_back(&record);
+            }
+
+            auto& conn = *free_records.back();
+            free_records.pop_back();
+            conn.destination = &destination;
+            return conn;
+        }
+
+        void release(pool_connection& conn)
+        {
+            conn.sock.close();
+            conn.destination = nullptr;
+            free_records.push_back(&conn);
+        }
+
+        /// Stop watching a connection the pool owns and take its socket, leaving the record free.
+        socket take(pool_connection& conn)
+        {
+            loop.cancel(conn.sock.get_id());
+            loop.cancel(static_cast<timer&>(conn));
+            auto sock = std::move(conn.sock);
+            release(conn);
+            return sock;
+        }
+
+        checkout_request* pop_request(pool_destination& destination)
+        {
+            auto* request = destination.head;
+            if (request)
+            {
+                destination.head = request->next;
+                if (!destination.head)
+                {
+                    destination.tail = nullptr;
+                }
+
+                request->next = nullptr;
+                request->destination = nullptr;
+                --destination.waiting;
+            }
+
+            return request;
+        }
+
+        /// Complete a request; as the handler may check connections out or in, this must be the last use of any state.
+        static void complete(checkout_request& request, pooled_connection connection)
+        {
+            request.on_checkout(request, std::move(connection));
+        }
+
+        void make_idle(pool_destination& destination, socket sock)
+        {
+            auto& conn = acquire(destination);
+            conn.sock = std::move(sock);
+            conn.connecting = false;
+            destination.idle.push_front(conn);
+            loop.wait(conn.sock.get_id(), event_loop::wait_type::read, conn);
+            loop.schedule_after(conn, options.idle_timeout);
+        }
+
+        /// Open connections for the requests waiting on a destination, plus the spare ones, within its limit.
+        void open_connections(pool_destination& destination, const std::size_t spare)
+        {
+            while (destination.idle.size + destination.connecting.size < destination.waiting + spare &&
+                   destination.get_open_count() < options.max_connections)
+            {
+                if (!connect(destination))
+                {
+                    fail_request(destination);
+                    return;
+                }
+            }
+        }
+
+        /// Start connecting to a destination. Returns false if the connection could not even be started.
+        bool connect(pool_destination& destination)
+        {
+            auto& conn = acquire(destination);
+            conn.connecting = true;
+            try
+            {
+                const auto type = get_address_type(destination.addr.get_address());
+                conn.sock.open(type == address_type::ipv6 ? socket_domain::ipv6 : socket_domain::ipv4,
+                               socket_type::stream);
+                if (conn.sock.connect(destination.addr) == socket::connect_status::connected)
+                {
+                    auto sock = std::move(conn.sock);
+                    release(conn);
+                    connected(destination, std::move(sock));
+                    return true;
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                ++counters.connect_failures;
+                release(conn);
+                return false;
+            }
+
+            destination.connecting.push_front(conn);
+            loop.wait(conn.sock.get_id(), event_loop::wait_type::connect, conn);
+            loop.schedule_after(conn, options.connect_timeout);
+            return true;
+        }
+
+        void connected(pool_destination& destination, socket sock)
+        {
+            ++counters.connects;
+            if (auto* request = pop_request(destination))
+            {
+                ++destination.checked_out;
+                complete(*request, pooled_connection{&destination, std::move(sock)});
+                return;
+            }
+
+            make_idle(destination, std::move(sock));
+        }
+
+        /// Fail the oldest request waiting on a destination, unless a connection is still being opened for it.
+        void fail_request(pool_destination& destination)
+        {
+            if (destination.waiting > destination.connecting.size)
+            {
+                if (auto* request = pop_request(destination))
+                {
+                    complete(*request, pooled_connection{});
+                }
+            }
+        }
+
+        static void on_ready(io_waiter& self, const poller::poll_status status)
+        {
+            auto& conn = static_cast<pool_connection&>(self);
+            auto& destination = *conn.destination;
+            auto& pool = *destination.pool->pimpl_;
+            if (!conn.connecting)
+            {
+                // An idle connection has nothing to read unless its peer closed it; it is not read from, just closed.
+                ++pool.counters.peer_closed;
+                destination.idle.erase(conn);
+                pool.take(conn);
+                return;
+            }
+
+            destination.connecting.erase(conn);
+            auto sock = pool.take(conn);
+            if (status == poller::poll_status::connection_succeeded)
+            {
+                pool.connected(destination, std::move(sock));
+                return;
+            }
+
+            ++pool.counters.connect_failures;
+            pool.fail_request(destination);
+        }
+
+        static void on_expired(timer& self)
+        {
+            auto& conn = static_cast<pool_connection&>(self);
+            auto& destination = *conn.destination;
+            auto& pool = *destination.pool->pimpl_;
+            if (!conn.connecting)
+            {
+                ++pool.counters.idle_expired;
+                destination.idle.erase(conn);
+                pool.take(conn);
+                return;
+            }
+
+            ++pool.counters.connect_failures;
+            destination.connecting.erase(conn);
+            pool.take(conn);
+            pool.fail_request(destination);
+        }
+    };
+
+    pooled_connection::~pooled_connection()
+    {
+        reset();
+    }
+
+    pooled_connection::pooled_connection(pooled_connection&& other) noexcept
+        : destination_(std::exchange(other.destination_, nullptr)), sock_(std::move(other.sock_))
+    {
+    }
+
+    pooled_connection& pooled_connection::operator=(pooled_connection&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            destination_ = std::exchange(other.destination_, nullptr);
+            sock_ = std::move(other.sock_);
+        }
+
+        return *this;
+    }
+
+    const raw_address& pooled_connection::get_address() const
+    {
+        assert(destination_);
+        return destination_->addr;
+    }
+
+    void pooled_connection::reset()
+    {
+        if (destination_)
+        {
+            destination_->pool->checkin(*this, false);
+        }
+    }
+
+    connection_pool::connection_pool(event_loop& loop, const connection_pool_options options)
+        : pimpl_(std::make_unique<impl>(*this, loop, options))
+    {
+    }
+
+    connection_pool::~connection_pool()
+    {
+        pimpl_->destinations.for_each([this](const std::unique_ptr<pool_destination>& destination) {
+            for (auto* list : {&destination->idle, &destination->connecting})
+            {
+                while (list->head)
+                {
+                    auto& conn = *list->head;
+                    list->erase(conn);
+                    pimpl_->take(conn);
+                }
+            }
+
+            while (pimpl_->pop_request(*destination))
+            {
+            }
+        });
+    }
+
+    const connection_pool::stats& connection_pool::get_stats() const
+    {
+        return pimpl_->counters;
+    }
+
+    void connection_pool::checkout(const raw_address& destination, checkout_request& request)
+    {
+        assert(request.on_checkout && !request.destination);
+
+        auto& dest = pimpl_->get_destination(destination);
+        ++pimpl_->counters.checkouts;
+
+        if (auto* conn = dest.idle.head)
+        {
+            dest.idle.erase(*conn);
+            ++dest.checked_out;
+            ++pimpl_->counters.reused;
+
+            auto sock = pimpl_->take(*conn);
+            pimpl_->open_connections(dest, pimpl_->options.spare_connections);
+            impl::complete(request, pooled_connection{&dest, std::move(sock)});
+            return;
+        }
+
+        ++pimpl_->counters.waited;
+        request.destination = &dest;
+        request.next = nullptr;
+        (dest.tail ? dest.tail->next : dest.head) = &request;
+        dest.tail = &request;
+        ++dest.waiting;
+
+        pimpl_->open_connections(dest, pimpl_->options.spare_connections);
+    }
+
+    void connection_pool::cancel(checkout_request& request)
+    {
+        auto* dest = request.destination;
+        if (!dest)
+        {
+            return;
+        }
+
+        auto* prev = static_cast<checkout_request*>(nullptr);
+        for (auto* current = dest->head; current != &request; current = current->next)
+        {
+            prev = current;
+        }
+
+        (prev ? prev->next : dest->head) = request.next;
+        if (dest->tail == &request)
+        {
+            dest->tail = prev;
+        }
+
+        request.next = nullptr;
+        request.destination = nullptr;
+        --dest->waiting;
+    }
+
+    checkout_awaiter connection_pool::async_checkout(const raw_address& destination)
+    {
+        return checkout_awaiter{*this, destination};
+    }
+
+    void connection_pool::checkin(pooled_connection& connection, const bool reusable)
+    {
+        auto* dest = std::exchange(connection.destination_, nullptr);
+        if (!dest)
+        {
+            return;
+        }
+
+        assert(dest->pool == this);
+        --dest->checked_out;
+        auto sock = std::move(connection.sock_);
+
+        if (!reusable || !sock)
+        {
+            // The connection leaves room under the limit for a request that is still waiting.
+            sock.close();
+            pimpl_->open_connections(*dest, 0);
+            return;
+        }
+
+        if (auto* request = pimpl_->pop_request(*dest))
+        {
+            ++dest->checked_out;
+            ++pimpl_->counters.reused;
+            impl::complete(*request, pooled_connection{dest, std::move(sock)});
+            return;
+        }
+
+        if (dest->idle.size < pimpl_->options.max_idle)
+        {
+            pimpl_->make_idle(*dest, std::move(sock));
+        }
+    }
+
+    std::size_t connection_pool::get_idle_count(const raw_address& destination) const
+    {
+        const auto* dest = pimpl_->destinations.find(destination);
+        return dest ? (*dest)->idle.size : 0;
+    }
+
+    std::size_t connection_pool::get_open_count(const raw_address& destination) const
+    {
+        const auto* dest = pimpl_->destinations.find(destination);
+        return dest ? (*dest)->get_open_count() : 0;
+    }
+
+    checkout_awaiter::checkout_awaiter(connection_pool& pool, const raw_address& destination)
+        : checkout_request{&checkout_awaiter::notify}, pool_(pool), destination_(destination)
+    {
+    }
+
+    checkout_awaiter::~checkout_awaiter()
+    {
+        pool_.cancel(*this);
+    }
+
+    bool checkout_awaiter::await_suspend(const std::coroutine_handle<> handle)
+    {
+        // An idle connection completes the request before checkout returns, and the coroutine carries on without
+        // suspending.
+        pool_.checkout(destination_, *this);
+        if (completed_)
+        {
+            return false;
+        }
+
+        handle_ = handle;
+        return true;
+    }
+
+    void checkout_awaiter::notify(checkout_request& self, pooled_connection connection)
+    {
+        auto& awaiter = static_cast<checkout_awaiter&>(self);
+        awaiter.result_ = std::move(connection);
+        awaiter.completed_ = true;
+        if (awaiter.handle_)
+        {
+            awaiter.handle_.resume();
+        }
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,37 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include "jhoyt/asl/event_fd.hpp"
+#include "jhoyt/asl/socket_id.hpp"
+
+namespace jhoyt::asl::detail
+{
+
+    /// Wakes a thread blocked in a poller from other threads. It is an event_fd (a self-pipe where eventfd is not
+    /// available) whose identifier is registered with the poller for read availability; notify may be called from any
+    /// thread.
+    class notifier final
+    {
+    public:
+        [[nodiscard]] socket_id get_id() const
+        {
+            return event_.get_id();
+        }
+
+        void notify() const
+        {
+            event_.signal();
+        }
+
+        void drain() const
+        {
+            event_.consume();
+        }
+
+    private:
+        event_fd event_;
+    };
+
+} // namespace jhoyt::asl::detail
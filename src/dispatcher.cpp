@@ -0,0 +1,154 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cassert>
+
+#include "jhoyt/asl/dispatcher.hpp"
+
+namespace jhoyt::asl
+{
+
+    dispatcher::dispatcher(runtime& rt, const connection_handler handler, const dispatcher_options& options)
+        : handler_(handler), policy_(options.policy)
+    {
+        assert(handler_.on_connection);
+        assert(rt.get_worker_count() > 0);
+
+        workers_.reserve(rt.get_worker_count());
+        for (auto ix = std::size_t{0}; ix < rt.get_worker_count(); ++ix)
+        {
+            auto& state = *workers_.emplace_back(std::make_unique<worker_state>());
+            state.run = &dispatcher::drain;
+            state.owner = this;
+            state.target = &rt.get_worker(ix);
+            if (options.producers == producer_mode::single)
+            {
+                state.single_queue = std::make_unique<spsc_queue<accepted_connection>>(options.queue_capacity);
+            }
+            else
+            {
+                state.multiple_queue = std::make_unique<mpsc_queue<accepted_connection>>(options.queue_capacity);
+            }
+        }
+    }
+
+    dispatcher::~dispatcher() = default;
+
+    std::optional<std::size_t> dispatcher::dispatch(socket& sock, const raw_address& addr)
+    {
+        assert(sock);
+
+        const auto first = choose_worker(sock);
+        auto conn = accepted_connection{std::move(sock), addr};
+        for (auto offset = std::size_t{0}; offset < workers_.size(); ++offset)
+        {
+            const auto ix = (first + offset) % workers_.size();
+            auto& state = *workers_[ix];
+
+            state.load.fetch_add(1, std::memory_order_relaxed);
+            if (!try_push(state, conn))
+            {
+                state.load.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // Only the push that finds the worker idle schedules a drain; the drain clears the flag before it empties
+            // the queue, so a connection pushed while it runs is either drained by it or schedules another drain.
+            if (!state.scheduled.exchange(true))
+            {
+                state.target->post(state);
+            }
+
+            return ix;
+        }
+
+        sock = std::move(conn.sock);
+        return std::nullopt;
+    }
+
+    void dispatcher::release(const std::size_t worker_index)
+    {
+        [[maybe_unused]] const auto previous = workers_[worker_index]->load.fetch_sub(1, std::memory_order_relaxed);
+        assert(previous > 0);
+    }
+
+    std::size_t dispatcher::get_load(const std::size_t worker_index) const
+    {
+        return workers_[worker_index]->load.load(std::memory_order_relaxed);
+    }
+
+    std::size_t dispatcher::choose_worker(const socket& sock)
+    {
+        switch (policy_)
+        {
+        case placement_policy::round_robin:
+            break;
+
+        case placement_policy::least_loaded:
+        {
+            auto best = std::size_t{0};
+            auto best_load = workers_[0]->load.load(std::memory_order_relaxed);
+            for (auto ix = std::size_t{1}; ix < workers_.size() && best_load > 0; ++ix)
+            {
+                const auto load = workers_[ix]->load.load(std::memory_order_relaxed);
+                if (load < best_load)
+                {
+                    best = ix;
+                    best_load = load;
+                }
+            }
+
+            return best;
+        }
+
+        case placement_policy::incoming_cpu:
+            if (const auto cpu = sock.get_incoming_cpu_option())
+            {
+                for (auto ix = std::size_t{0}; ix < workers_.size(); ++ix)
+                {
+                    if (workers_[ix]->target->get_cpu() == cpu)
+                    {
+                        return ix;
+                    }
+                }
+            }
+            break;
+
+        default:
+            assert(false);
+        }
+
+        return next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    }
+
+    bool dispatcher::try_push(worker_state& state, accepted_connection& conn) const
+    {
+        return state.single_queue ? state.single_queue->try_push(conn) : state.multiple_queue->try_push(conn);
+    }
+
+    bool dispatcher::try_pop(worker_state& state, accepted_connection& conn) const
+    {
+        return state.single_queue ? state.single_queue->try_pop(conn) : state.multiple_queue->try_pop(conn);
+    }
+
+    void dispatcher::drain(posted_task& self)
+    {
+        auto& state = static_cast<worker_state&>(self);
+        auto& owner = *state.owner;
+
+        state.scheduled.store(false);
+
+        auto conn = accepted_connection{};
+        while (owner.try_pop(state, conn))
+        {
+            owner.handler_.on_connection(owner.handler_.object, *state.target, conn.sock, conn.addr);
+            if (conn.sock)
+            {
+                // The handler did not take the connection, so it no longer counts towards the worker's load.
+                state.load.fetch_sub(1, std::memory_order_relaxed);
+                conn.sock.close();
+            }
+        }
+    }
+
+} // namespace jhoyt::asl
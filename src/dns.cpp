@@ -0,0 +1,546 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+#include "jhoyt/asl/address_parser.hpp"
+#include "jhoyt/asl/dns.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+    using namespace jhoyt::asl::detail;
+
+    constexpr auto k_header_size = std::size_t{12};
+    constexpr auto k_max_name_size = std::size_t{253};
+    constexpr auto k_max_label_size = std::size_t{63};
+    constexpr auto k_class_internet = std::uint16_t{1};
+    constexpr auto k_nameserver_port = std::uint16_t{53};
+
+    constexpr auto k_flag_response = std::uint16_t{0x8000};
+    constexpr auto k_flag_truncated = std::uint16_t{0x0200};
+    constexpr auto k_flag_recursion_desired = std::uint16_t{0x0100};
+
+    /// Compression pointers followed while reading one name, which stops pointer loops.
+    constexpr auto k_max_name_pointers = 32;
+
+    /// CNAME records followed from the queried name to the one that holds the addresses.
+    constexpr auto k_max_cname_chain = 8;
+
+    char to_lower_ascii(const char c)
+    {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool is_space(const char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    /// Remove the next whitespace-separated word from the front of a text.
+    std::string_view take_word(std::string_view& text)
+    {
+        const auto start = std::find_if_not(text.begin(), text.end(), is_space);
+        const auto end = std::find_if(start, text.end(), is_space);
+        const auto word = std::string_view{start, end};
+        text = std::string_view{end, text.end()};
+        return word;
+    }
+
+    /// Remove the next line from the front of a text, without the comment that ends it (if any).
+    std::string_view take_line(std::string_view& text, const std::string_view comment_chars)
+    {
+        const auto end = std::min(text.find('\n'), text.size());
+        auto line = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+        return line.substr(0, line.find_first_of(comment_chars));
+    }
+
+    /// Type that appends big-endian fields to a message buffer that is known to be large enough.
+    class message_writer
+    {
+    public:
+        explicit message_writer(const std::span<char> out) : out_(out)
+        {
+        }
+
+        [[nodiscard]] auto get_size() const
+        {
+            return size_;
+        }
+
+        void write_u8(const std::uint8_t value)
+        {
+            out_[size_++] = static_cast<char>(value);
+        }
+
+        void write_u16(const std::uint16_t value)
+        {
+            write_u8(static_cast<std::uint8_t>(value >> 8));
+            write_u8(static_cast<std::uint8_t>(value));
+        }
+
+        void write_text(const std::string_view text)
+        {
+            size_ += text.copy(out_.data() + size_, text.size());
+        }
+
+    private:
+        std::span<char> out_;
+        std::size_t size_ = 0;
+    };
+
+    /// Type that reads big-endian fields from a message; reading past the end marks the reader as failed (and reads
+    /// zeros) rather than throwing, so a malformed message only needs to be checked for once.
+    class message_reader
+    {
+    public:
+        explicit message_reader(const std::span<const char> data) : data_(data)
+        {
+        }
+
+        [[nodiscard]] bool is_valid() const
+        {
+            return valid_;
+        }
+
+        [[nodiscard]] std::size_t get_offset() const
+        {
+            return offset_;
+        }
+
+        void seek(const std::size_t offset)
+        {
+            fail_unless(offset <= data_.size());
+            offset_ = std::min(offset, data_.size());
+        }
+
+        std::uint8_t read_u8()
+        {
+            if (!fail_unless(offset_ < data_.size()))
+            {
+                return 0;
+            }
+
+            return static_cast<std::uint8_t>(data_[offset_++]);
+        }
+
+        std::uint16_t read_u16()
+        {
+            const auto high = read_u8();
+            return static_cast<std::uint16_t>(high << 8 | read_u8());
+        }
+
+        std::uint32_t read_u32()
+        {
+            const auto high = read_u16();
+            return std::uint32_t{high} << 16 | read_u16();
+        }
+
+        /// Read a possibly compressed name in the form of normalize_dns_name.
+        std::string read_name()
+        {
+            auto name = std::string{};
+            auto pos = offset_;
+            auto pointers = 0;
+            auto jumped = false;
+            while (valid_)
+            {
+                if (!fail_unless(pos < data_.size()))
+                {
+                    break;
+                }
+
+                const auto length = static_cast<std::uint8_t>(data_[pos]);
+                if ((length & 0xc0) == 0xc0)
+                {
+                    if (!fail_unless(pos + 1 < data_.size() && ++pointers <= k_max_name_pointers))
+                    {
+                        break;
+                    }
+
+                    if (!jumped)
+                    {
+                        offset_ = pos + 2;
+                        jumped = true;
+                    }
+
+                    pos = static_cast<std::size_t>(length & 0x3f) << 8 | static_cast<std::uint8_t>(data_[pos + 1]);
+                    continue;
+                }
+
+                if (length == 0)
+                {
+                    if (!jumped)
+                    {
+                        offset_ = pos + 1;
+                    }
+
+                    break;
+                }
+
+                // The 0x40 and 0x80 label types were never taken into use.
+                if (!fail_unless(length <= k_max_label_size && pos + 1 + length <= data_.size() &&
+                                 name.size() + 1 + length <= k_max_name_size + 1))
+                {
+                    break;
+                }
+
+                if (!name.empty())
+                {
+                    name += '.';
+                }
+
+                std::transform(data_.begin() + static_cast<std::ptrdiff_t>(pos + 1),
+                               data_.begin() + static_cast<std::ptrdiff_t>(pos + 1 + length),
+                               std::back_inserter(name),
+                               to_lower_ascii);
+                pos += 1 + length;
+            }
+
+            return name;
+        }
+
+    private:
+        std::span<const char> data_;
+        std::size_t offset_ = 0;
+        bool valid_ = true;
+
+        bool fail_unless(const bool condition)
+        {
+            valid_ = valid_ && condition;
+            return valid_;
+        }
+    };
+
+    /// A record of the answer section that is either an address of the queried type or a CNAME.
+    struct answer_record
+    {
+        std::string owner;
+        std::uint32_t ttl = 0;
+        std::optional<std::variant<ipv4_host, ipv6_host>> host;
+        std::string canonical_name;
+    };
+
+    /// Read the answer records that matter for the query; returns false if the message ends early.
+    bool read_answers(message_reader& reader,
+                      const std::uint16_t count,
+                      const dns_record_type type,
+                      std::vector<answer_record>& answers)
+    {
+        for (auto ix = 0; ix < count; ++ix)
+        {
+            auto record = answer_record{};
+            record.owner = reader.read_name();
+            const auto record_type = static_cast<dns_record_type>(reader.read_u16());
+            const auto record_class = reader.read_u16();
+            record.ttl = reader.read_u32();
+            const auto data_size = reader.read_u16();
+            const auto data_offset = reader.get_offset();
+            if (!reader.is_valid())
+            {
+                return false;
+            }
+
+            if (record_class == k_class_internet && record_type == type)
+            {
+                if (type == dns_record_type::a && data_size == 4)
+                {
+                    auto bytes = ipv4_host::bytes_type{};
+                    std::ranges::generate(bytes, [&] { return reader.read_u8(); });
+                    record.host = ipv4_host{bytes};
+                }
+                else if (type == dns_record_type::aaaa && data_size == 16)
+                {
+                    auto bytes = ipv6_host::bytes_type{};
+                    std::ranges::generate(bytes, [&] { return reader.read_u8(); });
+                    record.host = ipv6_host{bytes};
+                }
+            }
+            else if (record_class == k_class_internet && record_type == dns_record_type::cname)
+            {
+                record.canonical_name = reader.read_name();
+            }
+
+            reader.seek(data_offset + data_size);
+            if (!reader.is_valid())
+            {
+                return false;
+            }
+
+            if (record.host || !record.canonical_name.empty())
+            {
+                answers.push_back(std::move(record));
+            }
+        }
+
+        return true;
+    }
+
+    /// Read the negative caching TTL from the SOA record of the authority section, if there is one.
+    std::optional<std::uint32_t> read_negative_ttl(message_reader& reader, const std::uint16_t count)
+    {
+        for (auto ix = 0; ix < count; ++ix)
+        {
+            reader.read_name();
+            const auto record_type = static_cast<dns_record_type>(reader.read_u16());
+            reader.read_u16();
+            const auto ttl = reader.read_u32();
+            const auto data_size = reader.read_u16();
+            const auto data_offset = reader.get_offset();
+            if (record_type == dns_record_type::soa)
+            {
+                // MNAME and RNAME, then the serial, refresh, retry and expire fields come before the minimum.
+                reader.read_name();
+                reader.read_name();
+                reader.seek(reader.get_offset() + 16);
+                const auto minimum = reader.read_u32();
+                if (reader.is_valid() && reader.get_offset() <= data_offset + data_size)
+                {
+                    return std::min(ttl, minimum);
+                }
+            }
+
+            reader.seek(data_offset + data_size);
+            if (!reader.is_valid())
+            {
+                break;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<std::variant<ipv4_host, ipv6_host>> parse_host(const std::string_view text)
+    {
+        if (auto bytes = ipv4_host::bytes_type{}; parse_ipv4_bytes(text, bytes))
+        {
+            return ipv4_host{bytes};
+        }
+
+        if (auto bytes = ipv6_host::bytes_type{}; parse_ipv6_bytes(text, bytes))
+        {
+            return ipv6_host{bytes};
+        }
+
+        return std::nullopt;
+    }
+
+} // namespace
+
+namespace jhoyt::asl::detail
+{
+
+    std::string normalize_dns_name(const std::string_view name)
+    {
+        auto normalized = std::string{name.ends_with('.') ? name.substr(0, name.size() - 1) : name};
+        std::ranges::transform(normalized, normalized.begin(), to_lower_ascii);
+        return normalized;
+    }
+
+    bool is_valid_dns_name(std::string_view name)
+    {
+        if (name.ends_with('.'))
+        {
+            name.remove_suffix(1);
+        }
+
+        if (name.empty() || name.size() > k_max_name_size)
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            const auto dot = std::min(name.find('.'), name.size());
+            if (dot == 0 || dot > k_max_label_size)
+            {
+                return false;
+            }
+
+            if (dot == name.size())
+            {
+                return true;
+            }
+
+            name.remove_prefix(dot + 1);
+        }
+    }
+
+    std::size_t write_dns_query(std::string_view name,
+                                const std::uint16_t id,
+                                const dns_record_type type,
+                                const std::span<char, k_max_dns_message_size> out)
+    {
+        if (!is_valid_dns_name(name))
+        {
+            return 0;
+        }
+
+        if (name.ends_with('.'))
+        {
+            name.remove_suffix(1);
+        }
+
+        auto writer = message_writer{out};
+        writer.write_u16(id);
+        writer.write_u16(k_flag_recursion_desired);
+        writer.write_u16(1);
+        writer.write_u16(0);
+        writer.write_u16(0);
+        writer.write_u16(0);
+
+        while (!name.empty())
+        {
+            const auto label = name.substr(0, name.find('.'));
+            writer.write_u8(static_cast<std::uint8_t>(label.size()));
+            writer.write_text(label);
+            name.remove_prefix(std::min(label.size() + 1, name.size()));
+        }
+
+        writer.write_u8(0);
+        writer.write_u16(static_cast<std::uint16_t>(type));
+        writer.write_u16(k_class_internet);
+        return writer.get_size();
+    }
+
+    std::optional<dns_response> parse_dns_response(const std::span<const char> data,
+                                                   const std::uint16_t id,
+                                                   const std::string_view name,
+                                                   const dns_record_type type)
+    {
+        if (data.size() < k_header_size)
+        {
+            return std::nullopt;
+        }
+
+        auto reader = message_reader{data};
+        const auto response_id = reader.read_u16();
+        const auto flags = reader.read_u16();
+        const auto question_count = reader.read_u16();
+        const auto answer_count = reader.read_u16();
+        const auto authority_count = reader.read_u16();
+        reader.read_u16();
+
+        // The response has to be a standard query response that echoes the question, which (along with the
+        // identifier) makes it hard for anyone but the nameserver to inject answers.
+        const auto opcode = (flags >> 11) & 0xf;
+        if (response_id != id || (flags & k_flag_response) == 0 || opcode != 0 || question_count != 1)
+        {
+            return std::nullopt;
+        }
+
+        const auto question_name = reader.read_name();
+        const auto question_type = static_cast<dns_record_type>(reader.read_u16());
+        const auto question_class = reader.read_u16();
+        if (!reader.is_valid() || question_name != normalize_dns_name(name) || question_type != type ||
+            question_class != k_class_internet)
+        {
+            return std::nullopt;
+        }
+
+        auto response = dns_response{};
+        response.code = static_cast<dns_response_code>(flags & 0xf);
+        response.truncated = (flags & k_flag_truncated) != 0;
+
+        // A truncated response keeps the records that made it into the datagram.
+        auto answers = std::vector<answer_record>{};
+        if (!read_answers(reader, answer_count, type, answers) && !response.truncated)
+        {
+            return std::nullopt;
+        }
+
+        auto owner = question_name;
+        auto ttl = UINT32_MAX;
+        for (auto link = 0; link < k_max_cname_chain && response.hosts.empty(); ++link)
+        {
+            for (const auto& record : answers)
+            {
+                if (record.host && record.owner == owner)
+                {
+                    response.hosts.push_back(*record.host);
+                    ttl = std::min(ttl, record.ttl);
+                }
+            }
+
+            if (!response.hosts.empty())
+            {
+                response.ttl = ttl;
+                break;
+            }
+
+            const auto alias = std::ranges::find_if(answers, [&](const answer_record& record) {
+                return !record.canonical_name.empty() && record.owner == owner;
+            });
+            if (alias == answers.end())
+            {
+                break;
+            }
+
+            owner = alias->canonical_name;
+            ttl = std::min(ttl, alias->ttl);
+        }
+
+        if (response.hosts.empty() && reader.is_valid())
+        {
+            response.ttl = read_negative_ttl(reader, authority_count);
+        }
+
+        return response;
+    }
+
+    std::unordered_map<std::string, dns_hosts> parse_hosts_file(std::string_view text)
+    {
+        auto hosts = std::unordered_map<std::string, dns_hosts>{};
+        while (!text.empty())
+        {
+            auto line = take_line(text, "#");
+            const auto host = parse_host(take_word(line));
+            if (!host)
+            {
+                continue;
+            }
+
+            for (auto name = take_word(line); !name.empty(); name = take_word(line))
+            {
+                auto& name_hosts = hosts[normalize_dns_name(name)];
+                if (std::ranges::find(name_hosts, *host) == name_hosts.end())
+                {
+                    name_hosts.push_back(*host);
+                }
+            }
+        }
+
+        return hosts;
+    }
+
+    std::optional<raw_address> parse_resolv_conf(std::string_view text)
+    {
+        while (!text.empty())
+        {
+            auto line = take_line(text, "#;");
+            if (take_word(line) != "nameserver")
+            {
+                continue;
+            }
+
+            const auto host_text = take_word(line);
+            if (auto bytes = ipv4_host::bytes_type{}; parse_ipv4_bytes(host_text, bytes))
+            {
+                return raw_address{ipv4_address{.host = ipv4_host{bytes}, .port = k_nameserver_port}};
+            }
+
+            if (const auto addr = parse_ipv6_address(std::string{"["}.append(host_text).append("]:53")))
+            {
+                return raw_address{*addr};
+            }
+        }
+
+        return std::nullopt;
+    }
+
+} // namespace jhoyt::asl::detail
@@ -0,0 +1,144 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "jhoyt/asl/event_fd.hpp"
+
+#include "detail/error.hpp"
+
+namespace jhoyt::asl
+{
+
+    event_fd::event_fd(const std::uint64_t initial)
+    {
+#if defined(__linux__)
+        read_id_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (read_id_ == k_invalid_socket)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to create eventfd")};
+        }
+
+        // An eventfd is written and read through the same descriptor.
+        write_id_ = read_id_;
+#elif !defined(_WIN32)
+        auto ids = std::array<int, 2>{};
+        if (pipe(ids.data()) == -1)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to create event pipe")};
+        }
+
+        read_id_ = ids[0];
+        write_id_ = ids[1];
+
+        for (const auto id : ids)
+        {
+            const auto flags = fcntl(id, F_GETFL);
+            if (flags == -1 || fcntl(id, F_SETFL, flags | O_NONBLOCK) == -1 || fcntl(id, F_SETFD, FD_CLOEXEC) == -1)
+            {
+                const auto msg = detail::make_socket_error_string("failed to set event pipe flags");
+                close();
+                throw std::runtime_error{msg};
+            }
+        }
+#else
+        assert(false);
+#endif
+
+        if (initial > 0)
+        {
+            signal(initial);
+        }
+    }
+
+    event_fd::~event_fd()
+    {
+        close();
+    }
+
+    event_fd::event_fd(event_fd&& other) noexcept
+        : read_id_(std::exchange(other.read_id_, k_invalid_socket)),
+          write_id_(std::exchange(other.write_id_, k_invalid_socket))
+    {
+    }
+
+    event_fd& event_fd::operator=(event_fd&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            std::swap(read_id_, other.read_id_);
+            std::swap(write_id_, other.write_id_);
+        }
+
+        return *this;
+    }
+
+    void event_fd::signal(const std::uint64_t value) const
+    {
+        assert(write_id_ != k_invalid_socket);
+        assert(value > 0);
+
+#if !defined(_WIN32)
+        // The write can only fail when the counter is already non-zero, so the reader is woken regardless.
+        [[maybe_unused]] const auto result = write(write_id_, &value, sizeof(value));
+#endif
+    }
+
+    std::uint64_t event_fd::consume() const
+    {
+        assert(read_id_ != k_invalid_socket);
+
+        auto total = std::uint64_t{0};
+#if defined(__linux__)
+        if (read(read_id_, &total, sizeof(total)) != sizeof(total))
+        {
+            total = 0;
+        }
+#elif !defined(_WIN32)
+        // Each signal is written as a whole value, and writes of that size to a pipe are atomic.
+        auto values = std::array<std::uint64_t, 64>{};
+        for (auto count = read(read_id_, values.data(), sizeof(values)); count > 0;
+             count = read(read_id_, values.data(), sizeof(values)))
+        {
+            for (auto ix = std::size_t{0}; ix < static_cast<std::size_t>(count) / sizeof(std::uint64_t); ++ix)
+            {
+                total += values[ix];
+            }
+        }
+#endif
+
+        return total;
+    }
+
+    void event_fd::close()
+    {
+#if !defined(_WIN32)
+        if (write_id_ != k_invalid_socket && write_id_ != read_id_)
+        {
+            ::close(write_id_);
+        }
+
+        if (read_id_ != k_invalid_socket)
+        {
+            ::close(read_id_);
+        }
+#endif
+
+        read_id_ = k_invalid_socket;
+        write_id_ = k_invalid_socket;
+    }
+
+} // namespace jhoyt::asl
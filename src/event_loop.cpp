@@ -0,0 +1,586 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cassert>
+
+#include "jhoyt/asl/address_filter.hpp"
+#include "jhoyt/asl/event_loop.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    /// Poller timeout that blocks until a socket is ready.
+    constexpr auto k_infinite_timeout = std::chrono::milliseconds{-1};
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    void event_loop::set_spin_options(const std::optional<spin_options>& options)
+    {
+        assert(!options || options->min_budget <= options->max_budget);
+
+        spin_options_ = options;
+        spin_budget_ = options ? options->max_budget : std::chrono::nanoseconds::zero();
+        average_wait_ = std::chrono::nanoseconds::zero();
+    }
+
+    void event_loop::add_socket(const socket_id id,
+                                const poller::poll_type type,
+                                const io_handler handler,
+                                const poller::trigger_mode mode)
+    {
+        assert(id != k_invalid_socket);
+        assert(handler.on_poll);
+
+        auto& reg = registrations_[id];
+        assert(!reg.handler.on_poll && !reg.reader && !reg.writer);
+        reg.handler = handler;
+        reg.handler_type = type;
+        reg.handler_mode = mode;
+
+        ++handler_count_;
+        dirty_.push_back(id);
+    }
+
+    void event_loop::update_socket(const socket_id id, const poller::poll_type type)
+    {
+        const auto it = registrations_.find(id);
+        if (it == registrations_.end() || !it->second.handler.on_poll)
+        {
+            return;
+        }
+
+        it->second.handler_type = type;
+        dirty_.push_back(id);
+    }
+
+    void event_loop::rearm_socket(const socket_id id)
+    {
+        // A socket that has not been polled yet is armed when it is added to the poller.
+        const auto it = registrations_.find(id);
+        if (it != registrations_.end() && it->second.handler.on_poll && it->second.polled_type)
+        {
+            poller_.rearm_socket(id);
+        }
+    }
+
+    void event_loop::remove_socket(const socket_id id)
+    {
+        const auto it = registrations_.find(id);
+        if (it == registrations_.end() || !it->second.handler.on_poll)
+        {
+            return;
+        }
+
+        --handler_count_;
+        if (it->second.polled_type)
+        {
+            poller_.remove_socket(id);
+        }
+
+        registrations_.erase(it);
+    }
+
+    void event_loop::wait(const socket_id id, const wait_type type, io_waiter& waiter)
+    {
+        assert(id != k_invalid_socket);
+        assert(waiter.on_ready);
+
+        // The socket is marked dirty first: a dirty socket without a registration is skipped, so if registering
+        // throws the loop is left as it was and the caller can report the failure.
+        dirty_.push_back(id);
+        auto& reg = registrations_[id];
+        assert(!reg.handler.on_poll);
+        switch (type)
+        {
+        case wait_type::read:
+            assert(!reg.reader);
+            reg.reader = &waiter;
+            break;
+
+        case wait_type::write:
+            assert(!reg.writer);
+            reg.writer = &waiter;
+            break;
+
+        case wait_type::connect:
+            assert(!reg.writer);
+            reg.writer = &waiter;
+            reg.connecting = true;
+            break;
+
+        default:
+            assert(false);
+        }
+
+        ++waiter_count_;
+    }
+
+    void event_loop::cancel(const socket_id id)
+    {
+        const auto it = registrations_.find(id);
+        if (it == registrations_.end())
+        {
+            return;
+        }
+
+        const auto& reg = it->second;
+        waiter_count_ -= (reg.reader ? 1 : 0) + (reg.writer ? 1 : 0);
+        handler_count_ -= reg.handler.on_poll ? 1 : 0;
+        if (reg.polled_type)
+        {
+            poller_.remove_socket(id);
+        }
+
+        registrations_.erase(it);
+    }
+
+    void event_loop::schedule(timer& t, const std::chrono::steady_clock::time_point deadline)
+    {
+        assert(t.on_expired);
+
+        // A timer scheduled while timers are expiring is not due before the next iteration, even if its deadline has
+        // passed, so that a timer that reschedules itself cannot expire in a loop.
+        t.deadline = expiring_at_ && deadline <= *expiring_at_ ? *expiring_at_ + std::chrono::steady_clock::duration{1}
+                                                                : deadline;
+        if (t.is_scheduled())
+        {
+            sift_up(t.heap_index);
+            sift_down(t.heap_index);
+            return;
+        }
+
+        t.heap_index = timers_.size();
+        timers_.push_back(&t);
+        sift_up(t.heap_index);
+    }
+
+    void event_loop::cancel(timer& t)
+    {
+        if (!t.is_scheduled())
+        {
+            return;
+        }
+
+        const auto ix = t.heap_index;
+        swap_timers(ix, timers_.size() - 1);
+        timers_.pop_back();
+        t.heap_index = timer::k_unscheduled;
+
+        if (ix < timers_.size())
+        {
+            sift_up(ix);
+            sift_down(ix);
+        }
+    }
+
+    void event_loop::post(posted_task& task)
+    {
+        assert(task.run);
+
+        task.next = nullptr;
+        if (posted_tail_)
+        {
+            posted_tail_->next = &task;
+        }
+        else
+        {
+            posted_head_ = &task;
+        }
+
+        posted_tail_ = &task;
+    }
+
+    std::size_t event_loop::run_once(const std::chrono::nanoseconds& timeout)
+    {
+        update_registrations();
+
+        auto poll_timeout = timeout;
+        if (posted_head_)
+        {
+            poll_timeout = std::chrono::nanoseconds::zero();
+        }
+        else if (!timers_.empty())
+        {
+            // Round up so that the poller does not return just before the deadline and leave the loop spinning.
+            const auto until_deadline = std::max(
+                std::chrono::ceil<std::chrono::milliseconds>(timers_.front()->deadline - std::chrono::steady_clock::now()),
+                std::chrono::milliseconds::zero());
+            if (timeout < std::chrono::nanoseconds::zero() || until_deadline < timeout)
+            {
+                poll_timeout = until_deadline;
+            }
+        }
+
+        const auto results = wait_for_events(poll_timeout);
+        const auto start = std::chrono::steady_clock::now();
+
+        const auto events = dispatch(results);
+        const auto timers = expire_timers(start);
+        const auto tasks = run_posted();
+
+        const auto latency = std::chrono::steady_clock::now() - start;
+        ++stats_.iterations;
+        stats_.events += events;
+        stats_.timers += timers;
+        stats_.tasks += tasks;
+        stats_.total_latency += latency;
+        stats_.max_latency = std::max<std::chrono::nanoseconds>(stats_.max_latency, latency);
+        stats_.last_latency = latency;
+
+        return events + timers + tasks;
+    }
+
+    void event_loop::run()
+    {
+        stopped_ = false;
+        while (!stopped_ && has_work())
+        {
+            run_once(k_infinite_timeout);
+        }
+    }
+
+    std::span<const poller::poll_result> event_loop::wait_for_events(const std::chrono::nanoseconds timeout)
+    {
+        if (timeout == std::chrono::nanoseconds::zero())
+        {
+            return poller_.poll(timeout);
+        }
+
+        const auto wait_start = std::chrono::steady_clock::now();
+        auto now = wait_start;
+        if (spin_budget_ > std::chrono::nanoseconds::zero())
+        {
+            // A negative timeout waits forever, so only a positive one limits the spin.
+            auto budget = spin_budget_;
+            if (timeout > std::chrono::nanoseconds::zero())
+            {
+                budget = std::min(budget, timeout);
+            }
+
+            const auto spin_end = wait_start + budget;
+            while (now < spin_end)
+            {
+                const auto results = poller_.poll(std::chrono::nanoseconds::zero());
+                now = std::chrono::steady_clock::now();
+                if (!results.empty())
+                {
+                    ++stats_.spin_hits;
+                    stats_.spin_time += now - wait_start;
+                    adapt_spin_budget(now - wait_start);
+                    return results;
+                }
+            }
+
+            stats_.spin_time += now - wait_start;
+        }
+
+        auto remaining = timeout;
+        if (timeout > std::chrono::nanoseconds::zero())
+        {
+            const auto spun = std::chrono::duration_cast<std::chrono::nanoseconds>(now - wait_start);
+            remaining = std::max(timeout - spun, std::chrono::nanoseconds::zero());
+        }
+
+        const auto results = poller_.poll(remaining);
+        const auto end = std::chrono::steady_clock::now();
+        stats_.blocked_time += end - now;
+        if (spin_options_)
+        {
+            adapt_spin_budget(end - wait_start);
+        }
+
+        return results;
+    }
+
+    void event_loop::adapt_spin_budget(const std::chrono::nanoseconds wait)
+    {
+        // Exponentially weighted moving average of how long the loop waits for something to happen.
+        average_wait_ += (wait - average_wait_) / 8;
+        if (average_wait_ > spin_options_->max_budget)
+        {
+            spin_budget_ = spin_options_->min_budget;
+        }
+        else
+        {
+            spin_budget_ = std::clamp(2 * average_wait_, spin_options_->min_budget, spin_options_->max_budget);
+        }
+    }
+
+    std::optional<bool> detail::accept_operation::operator()() const
+    {
+        // The filter is called through its function pointer, so the event loop does not depend on the filter's code.
+        if (!(filter ? filter->accept_(*filter, *listener, *sock, *addr) : listener->accept(*sock, *addr)))
+        {
+            return std::nullopt;
+        }
+
+        return true;
+    }
+
+    io_awaiter<detail::recv_operation> event_loop::async_recv(socket& sock, const std::span<char> data)
+    {
+        return {*this, sock.get_id(), wait_type::read, detail::recv_operation{&sock, data}};
+    }
+
+    io_awaiter<detail::send_operation> event_loop::async_send(socket& sock, const std::span<const char> data)
+    {
+        return {*this, sock.get_id(), wait_type::write, detail::send_operation{&sock, data}};
+    }
+
+    io_awaiter<detail::accept_operation> event_loop::async_accept(socket& listener, socket& sock, raw_address& addr)
+    {
+        return {*this, listener.get_id(), wait_type::read, detail::accept_operation{&listener, &sock, &addr}};
+    }
+
+    io_awaiter<detail::accept_operation> event_loop::async_accept(socket& listener,
+                                                                  socket& sock,
+                                                                  raw_address& addr,
+                                                                  const address_filter& filter)
+    {
+        return {*this, listener.get_id(), wait_type::read, detail::accept_operation{&listener, &sock, &addr, &filter}};
+    }
+
+    connect_awaiter event_loop::async_connect(socket& sock, const raw_address& addr)
+    {
+        return {*this, sock, addr};
+    }
+
+    void event_loop::update_registrations()
+    {
+        // Polling interest is only reconciled right before polling so that a waiter that is notified and immediately
+        // waits again does not cause the socket to be removed from and re-added to the poller.
+        for (const auto id : dirty_)
+        {
+            const auto it = registrations_.find(id);
+            if (it == registrations_.end())
+            {
+                continue;
+            }
+
+            auto& reg = it->second;
+            auto type = std::optional<poller::poll_type>{};
+            if (reg.handler.on_poll)
+            {
+                type = reg.handler_type;
+            }
+            else if (reg.connecting)
+            {
+                type = poller::poll_type::connect;
+            }
+            else if (reg.reader && reg.writer)
+            {
+                type = poller::poll_type::read_write;
+            }
+            else if (reg.reader)
+            {
+                type = poller::poll_type::read;
+            }
+            else if (reg.writer)
+            {
+                type = poller::poll_type::write;
+            }
+
+            if (type != reg.polled_type)
+            {
+                if (!type)
+                {
+                    poller_.remove_socket(id);
+                }
+                else if (!reg.polled_type)
+                {
+                    poller_.add_socket(id, *type, reg.handler.on_poll ? reg.handler_mode : poller::trigger_mode::level);
+                }
+                else
+                {
+                    poller_.update_socket(id, *type);
+                }
+
+                reg.polled_type = type;
+            }
+
+            if (!type)
+            {
+                registrations_.erase(it);
+            }
+        }
+
+        dirty_.clear();
+    }
+
+    std::size_t event_loop::dispatch(const std::span<const poller::poll_result> results)
+    {
+        auto notified = std::size_t{0};
+        for (const auto& [id, status] : results)
+        {
+            const auto it = registrations_.find(id);
+            if (it == registrations_.end())
+            {
+                continue;
+            }
+
+            auto& reg = it->second;
+            if (reg.handler.on_poll)
+            {
+                reg.handler.on_poll(reg.handler.object, id, status);
+                ++notified;
+                continue;
+            }
+
+            auto* waiter = static_cast<io_waiter*>(nullptr);
+            switch (status)
+            {
+            case poller::poll_status::ready_to_read:
+                waiter = std::exchange(reg.reader, nullptr);
+                break;
+
+            case poller::poll_status::ready_to_write:
+            case poller::poll_status::connection_succeeded:
+            case poller::poll_status::connection_failed:
+                waiter = std::exchange(reg.writer, nullptr);
+                reg.connecting = false;
+                break;
+
+            default:
+                assert(false);
+            }
+
+            if (!waiter)
+            {
+                continue;
+            }
+
+            --waiter_count_;
+            dirty_.push_back(id);
+
+            // The waiter may register again or cancel, so the registration must not be used after this call.
+            waiter->on_ready(*waiter, status);
+            ++notified;
+        }
+
+        return notified;
+    }
+
+    std::size_t event_loop::expire_timers(const std::chrono::steady_clock::time_point now)
+    {
+        // Only the timers that were due when the call started are expired: timers scheduled meanwhile are moved to
+        // just after now (see schedule), so they expire on the next iteration, after the ones that were already due.
+        expiring_at_ = now;
+        auto expired = std::size_t{0};
+        while (!timers_.empty() && timers_.front()->deadline <= now)
+        {
+            auto& t = *timers_.front();
+            cancel(t);
+            t.on_expired(t);
+            ++expired;
+        }
+
+        expiring_at_.reset();
+        return expired;
+    }
+
+    std::size_t event_loop::run_posted()
+    {
+        // Tasks posted while running are left for the next iteration so that they cannot starve the poller.
+        auto* task = std::exchange(posted_head_, nullptr);
+        posted_tail_ = nullptr;
+
+        auto count = std::size_t{0};
+        while (task)
+        {
+            auto* next = task->next;
+            task->run(*task);
+            task = next;
+            ++count;
+        }
+
+        return count;
+    }
+
+    void event_loop::sift_up(std::size_t ix)
+    {
+        while (ix > 0)
+        {
+            const auto parent = (ix - 1) / 2;
+            if (timers_[parent]->deadline <= timers_[ix]->deadline)
+            {
+                break;
+            }
+
+            swap_timers(ix, parent);
+            ix = parent;
+        }
+    }
+
+    void event_loop::sift_down(std::size_t ix)
+    {
+        while (true)
+        {
+            auto smallest = ix;
+            for (const auto child : {2 * ix + 1, 2 * ix + 2})
+            {
+                if (child < timers_.size() && timers_[child]->deadline < timers_[smallest]->deadline)
+                {
+                    smallest = child;
+                }
+            }
+
+            if (smallest == ix)
+            {
+                break;
+            }
+
+            swap_timers(ix, smallest);
+            ix = smallest;
+        }
+    }
+
+    void event_loop::swap_timers(const std::size_t first, const std::size_t second)
+    {
+        std::swap(timers_[first], timers_[second]);
+        timers_[first]->heap_index = first;
+        timers_[second]->heap_index = second;
+    }
+
+    bool connect_awaiter::await_ready()
+    {
+        try
+        {
+            connected_ = sock_.connect(addr_) == socket::connect_status::connected;
+            return connected_;
+        }
+        catch (...)
+        {
+            error_ = std::current_exception();
+            return true;
+        }
+    }
+
+    void connect_awaiter::await_suspend(const std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        loop_.wait(sock_.get_id(), event_loop::wait_type::connect, *this);
+    }
+
+    bool connect_awaiter::await_resume()
+    {
+        if (error_)
+        {
+            std::rethrow_exception(error_);
+        }
+
+        return connected_;
+    }
+
+    void connect_awaiter::notify(io_waiter& self, const poller::poll_status status)
+    {
+        auto& awaiter = static_cast<connect_awaiter&>(self);
+        awaiter.connected_ = status == poller::poll_status::connection_succeeded;
+        awaiter.handle_.resume();
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,187 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <stdexcept>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "jhoyt/asl/pipe.hpp"
+
+#include "detail/error.hpp"
+
+namespace
+{
+
+    bool would_block()
+    {
+#if !defined(_WIN32)
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+#else
+        return false;
+#endif
+    }
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    pipe::pipe()
+    {
+#if defined(__linux__)
+        // Both ends are created with their flags set, so no other thread can fork and inherit them in between.
+        auto ids = std::array<int, 2>{};
+        if (pipe2(ids.data(), O_NONBLOCK | O_CLOEXEC) == -1)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to create pipe")};
+        }
+
+        read_id_ = ids[0];
+        write_id_ = ids[1];
+#elif !defined(_WIN32)
+        auto ids = std::array<int, 2>{};
+        if (::pipe(ids.data()) == -1)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to create pipe")};
+        }
+
+        read_id_ = ids[0];
+        write_id_ = ids[1];
+
+        for (const auto id : ids)
+        {
+            const auto flags = fcntl(id, F_GETFL);
+            if (flags == -1 || fcntl(id, F_SETFL, flags | O_NONBLOCK) == -1 || fcntl(id, F_SETFD, FD_CLOEXEC) == -1)
+            {
+                const auto msg = detail::make_socket_error_string("failed to set pipe flags");
+                close();
+                throw std::runtime_error{msg};
+            }
+        }
+#else
+        assert(false);
+#endif
+    }
+
+    pipe::~pipe()
+    {
+        close();
+    }
+
+    pipe::pipe(pipe&& other) noexcept
+        : read_id_(std::exchange(other.read_id_, k_invalid_socket)),
+          write_id_(std::exchange(other.write_id_, k_invalid_socket))
+    {
+    }
+
+    pipe& pipe::operator=(pipe&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            std::swap(read_id_, other.read_id_);
+            std::swap(write_id_, other.write_id_);
+        }
+
+        return *this;
+    }
+
+    std::pair<socket::transfer_status, std::size_t> pipe::write(const std::span<const char> data) const
+    {
+        assert(write_id_ != k_invalid_socket);
+
+        if (data.empty())
+        {
+            return {socket::transfer_status::success, 0};
+        }
+
+#if !defined(_WIN32)
+        const auto count = ::write(write_id_, data.data(), data.size());
+        if (count == -1)
+        {
+            if (would_block())
+            {
+                return {socket::transfer_status::blocked, 0};
+            }
+
+            if (errno == EPIPE)
+            {
+                return {socket::transfer_status::disconnected, 0};
+            }
+
+            throw std::runtime_error{detail::make_socket_error_string("failed to write to pipe")};
+        }
+
+        return {socket::transfer_status::success, static_cast<std::size_t>(count)};
+#else
+        assert(false);
+        return {socket::transfer_status::disconnected, 0};
+#endif
+    }
+
+    std::pair<socket::transfer_status, std::size_t> pipe::read(const std::span<char> data) const
+    {
+        assert(read_id_ != k_invalid_socket);
+
+        if (data.empty())
+        {
+            return {socket::transfer_status::success, 0};
+        }
+
+#if !defined(_WIN32)
+        const auto count = ::read(read_id_, data.data(), data.size());
+        if (count == -1)
+        {
+            if (would_block())
+            {
+                return {socket::transfer_status::blocked, 0};
+            }
+
+            throw std::runtime_error{detail::make_socket_error_string("failed to read from pipe")};
+        }
+        else if (count == 0)
+        {
+            return {socket::transfer_status::disconnected, 0};
+        }
+
+        return {socket::transfer_status::success, static_cast<std::size_t>(count)};
+#else
+        assert(false);
+        return {socket::transfer_status::disconnected, 0};
+#endif
+    }
+
+    void pipe::close_write()
+    {
+#if !defined(_WIN32)
+        if (write_id_ != k_invalid_socket)
+        {
+            ::close(write_id_);
+        }
+#endif
+
+        write_id_ = k_invalid_socket;
+    }
+
+    void pipe::close()
+    {
+        close_write();
+
+#if !defined(_WIN32)
+        if (read_id_ != k_invalid_socket)
+        {
+            ::close(read_id_);
+        }
+#endif
+
+        read_id_ = k_invalid_socket;
+    }
+
+} // namespace jhoyt::asl
@@ -1,15 +1,21 @@
 // Copyright (c) 2025-present, Jason Hoyt
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
+#include <atomic>
 #include <cassert>
+#include <cerrno>
+#include <thread>
+#include <vector>
 
 #if !defined(_WIN32)
 #include <poll.h>
 #endif
 
+#include "jhoyt/asl/mpsc_queue.hpp"
 #include "jhoyt/asl/poller.hpp"
 
 #include "detail/error.hpp"
+#include "detail/notifier.hpp"
 
 namespace
 {
@@ -33,12 +39,26 @@ namespace
         case poller::poll_type::read_write:
             return POLLIN | POLLOUT;
 
+        case poller::poll_type::write:
+            return POLLOUT;
+
+        case poller::poll_type::event:
+        case poller::poll_type::timer:
+        case poller::poll_type::signal:
+            return POLLIN;
+
         default:
             assert(false);
         }
 
         return 0;
     }
+
+    /// Entries of disarmed sockets hold the complement of the descriptor, which poll() ignores.
+    socket_id get_entry_id(const pollfd& entry)
+    {
+        return entry.fd < 0 ? ~entry.fd : entry.fd;
+    }
 #endif
 
 } // namespace
@@ -48,47 +68,105 @@ namespace jhoyt::asl
 
     struct poller::impl
     {
+        struct command
+        {
+            enum class kind
+            {
+                add,
+                update,
+                rearm,
+                remove
+            };
+
+            kind op = kind::add;
+            socket_id id = k_invalid_socket;
+            poll_type type = poll_type::read;
+            trigger_mode mode = trigger_mode::level;
+        };
+
         std::vector<poll_result> results;
         std::vector<poll_entry_type> entries;
         std::vector<poll_type> entry_types;
+        std::vector<trigger_mode> entry_modes;
+
+        // Only used in thread-safe mode.
+        std::unique_ptr<mpsc_queue<command>> commands;
+        std::unique_ptr<detail::notifier> notifier;
+        std::atomic<bool> pending{false};
+
+        /// The thread of the latest poll, which must not wait for itself when the command queue is full.
+        std::atomic<std::thread::id> polling_thread;
+
+        void add(socket_id id, poll_type type, trigger_mode mode);
+        void update(socket_id id, poll_type type);
+        void rearm(socket_id id);
+        void remove(socket_id id);
+        std::size_t find(socket_id id) const;
+
+        void push(command cmd);
+        void apply_commands();
     };
 
-    poller::poller() : pimpl_(std::make_unique<impl>())
+    void poller::impl::add(const socket_id id, const poll_type type, const trigger_mode mode)
     {
-    }
+#if !defined(_WIN32)
+        entries.emplace_back(id, map_poll_type(type), 0);
+#else
+        assert(false);
+#endif
 
-    poller::~poller() = default;
+        entry_types.emplace_back(type);
+        entry_modes.emplace_back(mode);
+    }
 
-    void poller::add_socket(socket_id id, poll_type type)
+    void poller::impl::update(const socket_id id, const poll_type type)
     {
-        if (!pimpl_)
+        if (const auto ix = find(id); ix < entries.size())
         {
-            return;
+            entry_types[ix] = type;
+            rearm(id);
         }
+    }
 
+    void poller::impl::rearm(const socket_id id)
+    {
+        if (const auto ix = find(id); ix < entries.size())
+        {
 #if !defined(_WIN32)
-        pimpl_->entries.emplace_back(id, map_poll_type(type), 0);
+            entries[ix].fd = id;
+            entries[ix].events = map_poll_type(entry_types[ix]);
 #else
-        assert(false);
+            assert(false);
 #endif
-
-        pimpl_->entry_types.emplace_back(type);
+        }
     }
 
-    void poller::update_socket(socket_id id, poll_type type)
+    void poller::impl::remove(const socket_id id)
     {
-        if (!pimpl_)
+        if (const auto ix = find(id); ix < entries.size())
         {
-            return;
+            if (ix < entries.size() - 1)
+            {
+                // Swap with the last element for faster erase since order is not important for this structure.
+                std::swap(entries[ix], entries.back());
+                entry_types[ix] = entry_types.back();
+                entry_modes[ix] = entry_modes.back();
+            }
+
+            entries.pop_back();
+            entry_types.pop_back();
+            entry_modes.pop_back();
         }
+    }
 
+    std::size_t poller::impl::find(const socket_id id) const
+    {
         auto ix = size_t{0};
-        for (auto& entry : pimpl_->entries)
+        for (const auto& entry : entries)
         {
 #if !defined(_WIN32)
-            if (entry.fd == id)
+            if (get_entry_id(entry) == id)
             {
-                entry.events = map_poll_type(type);
                 break;
             }
 #else
@@ -97,41 +175,145 @@ namespace jhoyt::asl
             ++ix;
         }
 
-        if (ix < pimpl_->entry_types.size())
+        return ix;
+    }
+
+    void poller::impl::push(command cmd)
+    {
+        while (!commands->try_push(cmd))
+        {
+            // A handler run by the polling thread can fill the queue between two polls; waiting would never end, so the
+            // queued commands are applied now, in order, and this one after them.
+            if (polling_thread.load(std::memory_order_relaxed) == std::this_thread::get_id())
+            {
+                apply_commands();
+                continue;
+            }
+
+            // The polling thread is behind; make sure it is awake to apply the queued commands and wait for space.
+            notifier->notify();
+            std::this_thread::yield();
+        }
+
+        // Only the first command after the polling thread has taken the queue needs to wake it.
+        if (!pending.exchange(true))
         {
-            pimpl_->entry_types[ix] = type;
+            notifier->notify();
         }
     }
 
-    void poller::remove_socket(socket_id id)
+    void poller::impl::apply_commands()
+    {
+        // The flag is cleared and the notifier drained before the queue is emptied, so a command pushed at any point
+        // is either applied here or wakes the next poll.
+        pending.store(false);
+        notifier->drain();
+
+        auto cmd = command{};
+        while (commands->try_pop(cmd))
+        {
+            switch (cmd.op)
+            {
+            case command::kind::add:
+                add(cmd.id, cmd.type, cmd.mode);
+                break;
+
+            case command::kind::update:
+                update(cmd.id, cmd.type);
+                break;
+
+            case command::kind::rearm:
+                rearm(cmd.id);
+                break;
+
+            case command::kind::remove:
+                remove(cmd.id);
+                break;
+
+            default:
+                assert(false);
+            }
+        }
+    }
+
+    poller::poller() : pimpl_(std::make_unique<impl>())
+    {
+    }
+
+    poller::poller(const threading_mode mode, const std::size_t command_capacity) : poller()
+    {
+        if (mode == threading_mode::thread_safe)
+        {
+            pimpl_->commands = std::make_unique<mpsc_queue<impl::command>>(command_capacity);
+            pimpl_->notifier = std::make_unique<detail::notifier>();
+            pimpl_->add(pimpl_->notifier->get_id(), poll_type::read, trigger_mode::level);
+        }
+    }
+
+    poller::~poller() = default;
+
+    void poller::add_socket(socket_id id, poll_type type, trigger_mode mode)
     {
         if (!pimpl_)
         {
             return;
         }
 
-        for (auto ix = size_t{0}; ix < pimpl_->entries.size(); ++ix)
+        if (pimpl_->commands)
         {
-            auto& entry = pimpl_->entries[ix];
-#if !defined(_WIN32)
-            if (entry.fd == id)
-#else
-            assert(false);
-#endif
-            {
-                if (ix < pimpl_->entries.size() - 1)
-                {
-                    // Swap with the last element for faster erase since order is not important for this structure.
-                    std::swap(entry, pimpl_->entries.back());
-                    pimpl_->entry_types[ix] = pimpl_->entry_types.back();
-                }
+            pimpl_->push({impl::command::kind::add, id, type, mode});
+            return;
+        }
 
-                pimpl_->entries.pop_back();
-                pimpl_->entry_types.pop_back();
+        pimpl_->add(id, type, mode);
+    }
 
-                break;
-            }
+    void poller::update_socket(socket_id id, poll_type type)
+    {
+        if (!pimpl_)
+        {
+            return;
+        }
+
+        if (pimpl_->commands)
+        {
+            pimpl_->push({impl::command::kind::update, id, type});
+            return;
+        }
+
+        pimpl_->update(id, type);
+    }
+
+    void poller::rearm_socket(socket_id id)
+    {
+        if (!pimpl_)
+        {
+            return;
         }
+
+        if (pimpl_->commands)
+        {
+            pimpl_->push({impl::command::kind::rearm, id});
+            return;
+        }
+
+        pimpl_->rearm(id);
+    }
+
+    void poller::remove_socket(socket_id id)
+    {
+        if (!pimpl_)
+        {
+            return;
+        }
+
+        if (pimpl_->commands)
+        {
+            pimpl_->push({impl::command::kind::remove, id, poll_type::read});
+            return;
+        }
+
+        pimpl_->remove(id);
     }
 
     std::span<const poller::poll_result> poller::poll(const std::chrono::nanoseconds& timeout)
@@ -143,27 +325,55 @@ namespace jhoyt::asl
 
         pimpl_->results.clear();
 
+        if (pimpl_->commands)
+        {
+            pimpl_->polling_thread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+            pimpl_->apply_commands();
+        }
+
 #if !defined(WIN32)
         const auto timeout_ms =
             static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count());
         if (::poll(pimpl_->entries.data(), pimpl_->entries.size(), timeout_ms) == -1)
         {
+            // A signal handler ran during the wait; report it as a wait that ended without updates.
+            if (errno == EINTR)
+            {
+                return {};
+            }
+
             throw std::runtime_error{detail::make_socket_error_string("failed to poll sockets")};
         }
 
         auto ix = size_t{0};
-        for (const auto& entry : pimpl_->entries)
+        for (auto& entry : pimpl_->entries)
         {
+            // The notifier of a thread-safe poller only interrupts the wait; its pipe is drained by the next poll.
+            if (pimpl_->notifier && entry.fd == pimpl_->notifier->get_id())
+            {
+                ++ix;
+                continue;
+            }
+
+            const auto first_result = pimpl_->results.size();
             switch (pimpl_->entry_types[ix])
             {
             case poll_type::connect:
-                if ((entry.revents & POLLOUT) != 0)
+                // A failed connection may also be reported as writable, so errors must be checked first.
+                if ((entry.revents & (POLLERR | POLLHUP)) != 0)
+                {
+                    pimpl_->results.emplace_back(entry.fd, poll_status::connection_failed);
+                }
+                else if ((entry.revents & POLLOUT) != 0)
                 {
                     pimpl_->results.emplace_back(entry.fd, poll_status::connection_succeeded);
                 }
-                else if ((entry.revents & POLLHUP) != 0)
+                break;
+
+            case poll_type::write:
+                if ((entry.revents & POLLOUT) != 0)
                 {
-                    pimpl_->results.emplace_back(entry.fd, poll_status::connection_failed);
+                    pimpl_->results.emplace_back(entry.fd, poll_status::ready_to_write);
                 }
                 break;
 
@@ -175,15 +385,57 @@ namespace jhoyt::asl
                 [[fallthrough]];
 
             case poll_type::read:
-                if ((entry.revents & POLLIN) != 0)
+                // A pipe whose write end has closed only reports a hang-up, but reading it no longer blocks either.
+                if ((entry.revents & (POLLIN | POLLHUP)) != 0)
                 {
                     pimpl_->results.emplace_back(entry.fd, poll_status::ready_to_read);
                 }
                 break;
 
+            case poll_type::event:
+                if ((entry.revents & POLLIN) != 0)
+                {
+                    pimpl_->results.emplace_back(entry.fd, poll_status::event_signaled);
+                }
+                break;
+
+            case poll_type::timer:
+                if ((entry.revents & POLLIN) != 0)
+                {
+                    pimpl_->results.emplace_back(entry.fd, poll_status::timer_expired);
+                }
+                break;
+
+            case poll_type::signal:
+                if ((entry.revents & POLLIN) != 0)
+                {
+                    pimpl_->results.emplace_back(entry.fd, poll_status::signal_received);
+                }
+                break;
+
             default:
                 assert(false);
             }
+
+            if (pimpl_->entry_modes[ix] != trigger_mode::level && pimpl_->results.size() > first_result)
+            {
+                // Disarm what has been reported (or everything for one-shot) until the socket is re-armed. A connection
+                // only completes once, and a hang-up or error is reported whatever the requested events are, so in
+                // those cases the socket is disarmed entirely rather than reported again on every poll.
+                const auto armed = pimpl_->entry_modes[ix] == trigger_mode::edge &&
+                                           pimpl_->entry_types[ix] != poll_type::connect &&
+                                           (entry.revents & (POLLHUP | POLLERR)) == 0
+                                       ? static_cast<short>(entry.events & ~entry.revents)
+                                       : short{0};
+                if (armed == 0)
+                {
+                    entry.fd = ~entry.fd;
+                }
+                else
+                {
+                    entry.events = armed;
+                }
+            }
             ++ix;
         }
 
@@ -1,9 +1,16 @@
 // Copyright (c) 2025-present, Jason Hoyt
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
 #include <format>
 #include <stdexcept>
+#include <string_view>
+#include <utility>
 
 #if !defined(_WIN32)
 #include <arpa/inet.h>
@@ -17,177 +24,370 @@ namespace
 {
     using namespace jhoyt::asl;
 
-    sockaddr_storage storage_from_address(const address& addr)
+    static_assert(std::string_view{"ipv6://"}.size() + INET6_ADDRSTRLEN +
+                      std::string_view{"%4294967295:65535"}.size() <=
+                  raw_address::k_max_string_size);
+    static_assert(std::string_view{"file://"}.size() + sizeof(sockaddr_un::sun_path) <= raw_address::k_max_string_size);
+
+    /// Type that appends text to a fixed buffer that is known to be large enough.
+    class string_writer
+    {
+    public:
+        explicit string_writer(const std::span<char> out) : out_(out)
+        {
+        }
+
+        [[nodiscard]] auto get_size() const
+        {
+            return size_;
+        }
+
+        void append(const std::string_view text)
+        {
+            assert(text.size() <= out_.size() - size_);
+            size_ += text.copy(out_.data() + size_, text.size());
+        }
+
+        void append_host(const int family, const void* host)
+        {
+            const auto remaining = static_cast<socklen_t>(out_.size() - size_);
+            if (!inet_ntop(family, host, out_.data() + size_, remaining))
+            {
+                throw std::runtime_error{family == AF_INET ? "malformed ipv4 raw address host"
+                                                           : "malformed ipv6 raw address host"};
+            }
+
+            size_ += strlen(out_.data() + size_);
+        }
+
+        void append_number(const std::uint32_t value)
+        {
+            const auto result = std::to_chars(out_.data() + size_, out_.data() + out_.size(), value);
+            assert(result.ec == std::errc{});
+            size_ = static_cast<std::size_t>(result.ptr - out_.data());
+        }
+
+        void append_port(const in_port_t port)
+        {
+            append(":");
+            append_number(ntohs(port));
+        }
+
+    private:
+        std::span<char> out_;
+        std::size_t size_ = 0;
+    };
+
+    ipv4_address get_ipv4_address(const sockaddr_in& ipv4_data)
+    {
+        return ipv4_address{.host = ipv4_host{std::bit_cast<ipv4_host::bytes_type>(ipv4_data.sin_addr)},
+                            .port = ntohs(ipv4_data.sin_port)};
+    }
+
+    ipv6_address get_ipv6_address(const sockaddr_in6& ipv6_data)
+    {
+        return ipv6_address{.host = ipv6_host{std::bit_cast<ipv6_host::bytes_type>(ipv6_data.sin6_addr)},
+                            .port = ntohs(ipv6_data.sin6_port),
+                            .scope_id = ipv6_data.sin6_scope_id};
+    }
+
+    /// The path ends at the first NUL or at the end of the OS-level address, whichever comes first.
+    std::string_view get_path(const sockaddr_un& unix_data, const socklen_t size)
+    {
+        const auto max_size = std::min(size - offsetof(sockaddr_un, sun_path), sizeof(unix_data.sun_path));
+        return {unix_data.sun_path, strnlen(unix_data.sun_path, max_size)};
+    }
+
+    /// Read the family of an OS-level address, which every sockaddr type keeps at the same offset.
+    sa_family_t get_data_family(const std::span<const char> data)
+    {
+        if (data.size() < offsetof(sockaddr, sa_family) + sizeof(sa_family_t) || data.size() > sizeof(sockaddr_storage))
+        {
+            throw std::runtime_error{"malformed raw address data"};
+        }
+
+        auto family = sa_family_t{};
+        memcpy(&family, data.data() + offsetof(sockaddr, sa_family), sizeof(family));
+        return family;
+    }
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    raw_address::raw_address()
+    {
+        memset(&ip_, 0, sizeof(ip_));
+    }
+
+    raw_address::raw_address(const address& addr) : raw_address()
     {
-        auto storage = sockaddr_storage{0};
         switch (get_address_type(addr))
         {
 
         case address_type::ipv4: {
             const auto& [host, port] = *std::get_if<ipv4_address>(&addr);
-            auto& ipv4_out = *reinterpret_cast<sockaddr_in*>(&storage);
-            if (const auto status = inet_pton(AF_INET, host.c_str(), &ipv4_out.sin_addr); status != 1)
-            {
-                assert(status != -1);
-                throw std::runtime_error{"malformed ipv4 address host"};
-            }
+            memcpy(&ip_.ipv4.sin_addr, host.get_bytes().data(), host.get_bytes().size());
 
-            ipv4_out.sin_family = AF_INET;
-            ipv4_out.sin_port = htons(port);
+            ip_.ipv4.sin_family = AF_INET;
+            ip_.ipv4.sin_port = htons(port);
 
-            storage.ss_len = sizeof(sockaddr_in);
+            size_ = sizeof(sockaddr_in);
+#if defined(SIN6_LEN)
+            ip_.ipv4.sin_len = sizeof(sockaddr_in);
+#endif
             break;
         }
 
         case address_type::ipv6: {
-            const auto& [host, port] = *std::get_if<ipv6_address>(&addr);
-            auto& ipv6_out = *reinterpret_cast<sockaddr_in6*>(&storage);
-            if (const auto status = inet_pton(AF_INET6, host.c_str(), &ipv6_out.sin6_addr); status != 1)
-            {
-                assert(status != -1);
-                throw std::runtime_error{"malformed ipv6 address host"};
-            }
+            const auto& [host, port, scope_id] = *std::get_if<ipv6_address>(&addr);
+            memcpy(&ip_.ipv6.sin6_addr, host.get_bytes().data(), host.get_bytes().size());
+            ip_.ipv6.sin6_scope_id = scope_id;
 
-            ipv6_out.sin6_family = AF_INET6;
-            ipv6_out.sin6_port = htons(port);
+            ip_.ipv6.sin6_family = AF_INET6;
+            ip_.ipv6.sin6_port = htons(port);
 
-            storage.ss_len = sizeof(sockaddr_in6);
+            size_ = sizeof(sockaddr_in6);
+#if defined(SIN6_LEN)
+            ip_.ipv6.sin6_len = sizeof(sockaddr_in6);
+#endif
             break;
         }
 
         case address_type::file: {
             const auto& [path] = *std::get_if<file_address>(&addr);
-            auto& file_out = *reinterpret_cast<sockaddr_un*>(&storage);
             if (path.empty())
             {
                 throw std::runtime_error{"file address path is empty"};
             }
 
-            if (path.length() > sizeof(file_out.sun_path) - 1)
+            if (path.length() > sizeof(sockaddr_un::sun_path) - 1)
             {
                 throw std::runtime_error{"file address path is too long"};
             }
 
-            memcpy(file_out.sun_path, path.data(), path.length());
+            file_ = std::make_unique<sockaddr_un>();
+            memcpy(file_->sun_path, path.data(), path.length());
 
-            file_out.sun_family = AF_UNIX;
+            file_->sun_family = AF_UNIX;
 
-            storage.ss_len = sizeof(sockaddr_un);
+            size_ = sizeof(sockaddr_un);
+#if defined(SIN6_LEN)
+            file_->sun_len = sizeof(sockaddr_un);
+#endif
             break;
         }
 
         default:
             throw std::runtime_error{std::format("unsupported address type: {}", addr.index())};
         }
-
-        return storage;
     }
 
-    sockaddr_storage storage_from_raw_data(const std::span<const char> data)
+    raw_address::raw_address(const std::span<const char> data) : raw_address()
     {
-        if (data.size() > sizeof(sockaddr_storage))
-        {
-            throw std::runtime_error{"malformed raw address data"};
-        }
-
-        const auto& data_storage = *reinterpret_cast<const sockaddr_storage*>(data.data());
-        switch (data_storage.ss_family)
+        // The length comes from the span (e.g. the length filled in by accept), so a longer span is cut down to the
+        // OS-level address of its family and a shorter one is rejected.
+        switch (const auto family = get_data_family(data))
         {
 
         case AF_INET:
-            if (data_storage.ss_len != sizeof(sockaddr_in))
+            if (data.size() < sizeof(sockaddr_in))
             {
                 throw std::runtime_error{"malformed ipv4 raw address data"};
             }
+
+            memcpy(&ip_.ipv4, data.data(), sizeof(sockaddr_in));
+            size_ = sizeof(sockaddr_in);
             break;
 
         case AF_INET6:
-            if (data_storage.ss_len != sizeof(sockaddr_in6))
+            if (data.size() < sizeof(sockaddr_in6))
             {
                 throw std::runtime_error{"malformed ipv6 raw address data"};
             }
+
+            memcpy(&ip_.ipv6, data.data(), sizeof(sockaddr_in6));
+            size_ = sizeof(sockaddr_in6);
             break;
 
-        case AF_UNIX:
-            if (data_storage.ss_len != sizeof(sockaddr_un))
-            {
-                throw std::runtime_error{"malformed file raw address data"};
-            }
+        case AF_UNIX: {
+            // An unnamed socket (e.g. the peer of an accepted connection) has an address with no path at all.
+            const auto size = std::min(data.size(), sizeof(sockaddr_un));
+            file_ = std::make_unique<sockaddr_un>();
+            memcpy(file_.get(), data.data(), size);
+            size_ = static_cast<socklen_t>(size);
             break;
+        }
 
         default:
-            throw std::runtime_error{std::format("unsupported raw address data: {}", data_storage.ss_family)};
+            throw std::runtime_error{std::format("unsupported raw address data: {}", family)};
         }
+    }
 
-        return data_storage;
+    raw_address::raw_address(const raw_address& other)
+        : ip_(other.ip_), size_(other.size_),
+          file_(other.file_ ? std::make_unique<sockaddr_un>(*other.file_) : nullptr)
+    {
     }
 
-} // namespace
+    raw_address& raw_address::operator=(const raw_address& other)
+    {
+        if (this != &other)
+        {
+            ip_ = other.ip_;
+            size_ = other.size_;
+            file_ = other.file_ ? std::make_unique<sockaddr_un>(*other.file_) : nullptr;
+        }
 
-namespace jhoyt::asl
-{
+        return *this;
+    }
 
-    raw_address::raw_address()
+    raw_address::raw_address(raw_address&& other) noexcept
+        : ip_(other.ip_), size_(std::exchange(other.size_, 0)), file_(std::move(other.file_))
     {
-        memset(&data_, 0, sizeof(data_));
+        memset(&other.ip_, 0, sizeof(other.ip_));
     }
 
-    raw_address::raw_address(const address& addr) : data_(storage_from_address(addr))
+    raw_address& raw_address::operator=(raw_address&& other) noexcept
     {
+        if (this != &other)
+        {
+            ip_ = other.ip_;
+            size_ = std::exchange(other.size_, 0);
+            file_ = std::move(other.file_);
+            memset(&other.ip_, 0, sizeof(other.ip_));
+        }
+
+        return *this;
     }
 
-    raw_address::raw_address(const std::span<const char> data) : data_(storage_from_raw_data(data))
+    raw_address::~raw_address() = default;
+
+    sa_family_t raw_address::get_family() const
     {
+        return file_ ? sa_family_t{AF_UNIX} : ip_.ipv4.sin_family;
     }
 
     std::span<const char> raw_address::get_data() const
     {
-        return {reinterpret_cast<const char*>(&data_), data_.ss_len};
+        if (file_)
+        {
+            return {reinterpret_cast<const char*>(file_.get()), size_};
+        }
+
+        return {reinterpret_cast<const char*>(&ip_), size_};
     }
 
     address raw_address::get_address() const
     {
-        switch (data_.ss_family)
+        switch (get_family())
         {
 
-        case AF_INET: {
-            assert(data_.ss_len == sizeof(sockaddr_in));
-            const auto& ipv4_data = *reinterpret_cast<const sockaddr_in*>(&data_);
-            auto buf = std::array<char, INET_ADDRSTRLEN>{};
-            if (!inet_ntop(AF_INET, &ipv4_data.sin_addr, buf.data(), buf.size()))
-            {
-                throw std::runtime_error{"malformed ipv4 raw address host"};
-            }
+        case AF_INET:
+            return get_ipv4_address(ip_.ipv4);
+
+        case AF_INET6:
+            return get_ipv6_address(ip_.ipv6);
 
-            return ipv4_address{.host = buf.data(), .port = ntohs(ipv4_data.sin_port)};
+        case AF_UNIX:
+            return file_address{.path = std::string{get_path(*file_, size_)}};
+
+        default:
+            throw std::runtime_error{std::format("unsupported raw address type: {}", get_family())};
         }
+    }
 
-        case AF_INET6: {
-            assert(data_.ss_len == sizeof(sockaddr_in6));
-            const auto& ipv6_data = *reinterpret_cast<const sockaddr_in6*>(&data_);
-            auto buf = std::array<char, INET6_ADDRSTRLEN>{};
-            if (!inet_ntop(AF_INET6, &ipv6_data.sin6_addr, buf.data(), buf.size()))
+    std::size_t raw_address::write_string(const std::span<char, k_max_string_size> out) const
+    {
+        auto writer = string_writer{out};
+        switch (get_family())
+        {
+
+        case AF_INET:
+            writer.append("ipv4://");
+            writer.append_host(AF_INET, &ip_.ipv4.sin_addr);
+            writer.append_port(ip_.ipv4.sin_port);
+            break;
+
+        case AF_INET6:
+            writer.append("ipv6://");
+            writer.append_host(AF_INET6, &ip_.ipv6.sin6_addr);
+            if (ip_.ipv6.sin6_scope_id != 0)
             {
-                throw std::runtime_error{"malformed ipv6 raw address host"};
+                writer.append("%");
+                writer.append_number(ip_.ipv6.sin6_scope_id);
             }
 
-            return ipv6_address{.host = buf.data(), .port = ntohs(ipv6_data.sin6_port)};
+            writer.append_port(ip_.ipv6.sin6_port);
+            break;
+
+        case AF_UNIX:
+            writer.append("file://");
+            writer.append(get_path(*file_, size_));
+            break;
+
+        default:
+            throw std::runtime_error{std::format("unsupported raw address type: {}", get_family())};
         }
 
-        case AF_UNIX: {
-            assert(data_.ss_len == sizeof(sockaddr_un));
-            const auto& unix_data = *reinterpret_cast<const sockaddr_un*>(&data_);
-            return file_address{.path = unix_data.sun_path};
+        return writer.get_size();
+    }
+
+    std::size_t raw_address::get_hash() const
+    {
+        // The generic addresses are built on the stack (only the file address would allocate, so its path is hashed
+        // as a string_view, which hashes the same as the std::string of a file_address).
+        switch (get_family())
+        {
+
+        case AF_INET:
+            return std::hash<ipv4_address>{}(get_ipv4_address(ip_.ipv4));
+
+        case AF_INET6:
+            return std::hash<ipv6_address>{}(get_ipv6_address(ip_.ipv6));
+
+        case AF_UNIX:
+            return std::hash<std::string_view>{}(get_path(*file_, size_));
+
+        default:
+            return 0;
         }
+    }
+
+    std::strong_ordering raw_address::operator<=>(const raw_address& other) const
+    {
+        if (const auto order = get_family() <=> other.get_family(); order != 0)
+        {
+            return order;
+        }
+
+        switch (get_family())
+        {
+
+        case AF_INET:
+            return get_ipv4_address(ip_.ipv4) <=> get_ipv4_address(other.ip_.ipv4);
+
+        case AF_INET6:
+            return get_ipv6_address(ip_.ipv6) <=> get_ipv6_address(other.ip_.ipv6);
+
+        case AF_UNIX:
+            return get_path(*file_, size_) <=> get_path(*other.file_, other.size_);
 
         default:
-            throw std::runtime_error{std::format("unsupported raw address type: {}", data_.ss_family)};
+            return std::strong_ordering::equal;
         }
     }
 
+    bool raw_address::operator==(const raw_address& other) const
+    {
+        return *this <=> other == 0;
+    }
+
     std::string to_string(const raw_address& addr)
     {
-        return to_string(addr.get_address());
+        auto buf = std::array<char, raw_address::k_max_string_size>{};
+        return std::string{buf.data(), addr.write_string(buf)};
     }
 
 } // namespace jhoyt::asl
\ No newline at end of file
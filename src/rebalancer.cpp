@@ -0,0 +1,352 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "jhoyt/asl/rebalancer.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    void wait_for_zero(std::atomic<std::size_t>& counter)
+    {
+        for (auto value = counter.load(std::memory_order_acquire); value > 0;
+             value = counter.load(std::memory_order_acquire))
+        {
+            counter.wait(value, std::memory_order_acquire);
+        }
+    }
+
+    /// Request to move a connection, run on the worker that owned it when it was sampled.
+    struct move_task : posted_task
+    {
+        rebalancer* owner = nullptr;
+        tracked_connection* conn = nullptr;
+        std::uint64_t serial = 0;
+        std::size_t source_index = 0;
+        std::size_t target_index = 0;
+        std::atomic<std::size_t>* remaining = nullptr;
+        std::atomic<std::size_t>* moved = nullptr;
+    };
+
+    void count_down(std::atomic<std::size_t>& counter)
+    {
+        if (counter.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            counter.notify_all();
+        }
+    }
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    /// The connections of one worker; only used on that worker's thread, apart from the sample results which are handed
+    /// back to the thread calling rebalance.
+    struct rebalancer::worker_state
+    {
+        tracked_connection* head = nullptr;
+
+        struct sample_task : posted_task
+        {
+            rebalancer* owner = nullptr;
+            worker_state* state = nullptr;
+            std::atomic<std::size_t>* remaining = nullptr;
+            std::uint64_t load = 0;
+            std::vector<candidate> candidates;
+        };
+
+        sample_task sample;
+
+        void link(tracked_connection& conn)
+        {
+            conn.prev = nullptr;
+            conn.next = head;
+            if (head)
+            {
+                head->prev = &conn;
+            }
+
+            head = &conn;
+        }
+
+        void unlink(tracked_connection& conn)
+        {
+            if (conn.prev)
+            {
+                conn.prev->next = conn.next;
+            }
+            else
+            {
+                head = conn.next;
+            }
+
+            if (conn.next)
+            {
+                conn.next->prev = conn.prev;
+            }
+
+            conn.prev = nullptr;
+            conn.next = nullptr;
+        }
+
+        [[nodiscard]] bool contains(const tracked_connection* conn, const std::uint64_t serial) const
+        {
+            // The candidate may have been detached (and destroyed) since it was sampled, so it is only dereferenced
+            // once it has been found in the list.
+            for (auto* it = head; it; it = it->next)
+            {
+                if (it == conn)
+                {
+                    return it->serial == serial;
+                }
+            }
+
+            return false;
+        }
+    };
+
+    rebalancer::rebalancer(runtime& rt, const rebalancer_options& options)
+        : runtime_(rt), options_(options), last_loads_(rt.get_worker_count())
+    {
+        workers_.reserve(rt.get_worker_count());
+        for (auto ix = std::size_t{0}; ix < rt.get_worker_count(); ++ix)
+        {
+            auto& state = *workers_.emplace_back(std::make_unique<worker_state>());
+            state.sample.run = &rebalancer::on_sample;
+            state.sample.owner = this;
+            state.sample.state = &state;
+            state.sample.candidates.reserve(options_.candidates_per_worker);
+        }
+    }
+
+    rebalancer::~rebalancer() = default;
+
+    void rebalancer::attach(tracked_connection& conn)
+    {
+        auto* w = worker::get_current();
+        assert(w);
+        assert(conn.id != k_invalid_socket);
+        assert(conn.handler.on_poll);
+        assert(!conn.owner);
+
+        conn.owner = w;
+        conn.serial = next_serial_.fetch_add(1, std::memory_order_relaxed);
+        conn.sampled_bytes = conn.bytes;
+        conn.sampled_events = conn.events;
+        workers_[w->get_index()]->link(conn);
+        w->get_loop().add_socket(conn.id, conn.type, io_handler{&conn, &rebalancer::on_poll}, conn.mode);
+    }
+
+    void rebalancer::detach(tracked_connection& conn)
+    {
+        assert(conn.owner && conn.owner == worker::get_current());
+
+        conn.owner->get_loop().remove_socket(conn.id);
+        workers_[conn.owner->get_index()]->unlink(conn);
+        conn.owner = nullptr;
+    }
+
+    void rebalancer::update(tracked_connection& conn, const poller::poll_type type)
+    {
+        assert(conn.owner && conn.owner == worker::get_current());
+
+        conn.type = type;
+        conn.owner->get_loop().update_socket(conn.id, type);
+    }
+
+    void rebalancer::migrate(tracked_connection& conn, const std::size_t target_index)
+    {
+        start_migration(conn, target_index, nullptr);
+    }
+
+    std::size_t rebalancer::rebalance()
+    {
+        assert(!worker::get_current());
+
+        if (!runtime_.is_running() || workers_.size() < 2)
+        {
+            return 0;
+        }
+
+        // Collect the load of every worker, and its heaviest connections, on the worker threads themselves.
+        auto remaining = std::atomic<std::size_t>{workers_.size()};
+        for (auto ix = std::size_t{0}; ix < workers_.size(); ++ix)
+        {
+            workers_[ix]->sample.remaining = &remaining;
+            runtime_.post(ix, workers_[ix]->sample);
+        }
+
+        wait_for_zero(remaining);
+
+        auto loads = std::vector<std::uint64_t>(workers_.size());
+        auto total = std::uint64_t{0};
+        for (auto ix = std::size_t{0}; ix < workers_.size(); ++ix)
+        {
+            loads[ix] = workers_[ix]->sample.load;
+            total += loads[ix];
+        }
+
+        last_loads_ = loads;
+
+        // Greedily move the heaviest candidate off the most loaded worker onto the least loaded one, as long as the
+        // move narrows the gap between the two.
+        const auto average = static_cast<double>(total) / static_cast<double>(workers_.size());
+        auto moves = std::vector<move_task>{};
+        auto moved = std::atomic<std::size_t>{0};
+        while (moves.size() < options_.max_migrations)
+        {
+            const auto [min_it, max_it] = std::minmax_element(loads.begin(), loads.end());
+            const auto source = static_cast<std::size_t>(max_it - loads.begin());
+            const auto target = static_cast<std::size_t>(min_it - loads.begin());
+            if (static_cast<double>(*max_it) <= average * (1.0 + options_.imbalance_threshold))
+            {
+                break;
+            }
+
+            auto& candidates = workers_[source]->sample.candidates;
+            const auto gap = *max_it - *min_it;
+            const auto it = std::find_if(candidates.begin(), candidates.end(), [gap](const candidate& c) {
+                return c.load > 0 && c.load < gap;
+            });
+            if (it == candidates.end())
+            {
+                break;
+            }
+
+            auto& task = moves.emplace_back();
+            task.run = &rebalancer::on_move;
+            task.owner = this;
+            task.conn = it->conn;
+            task.serial = it->serial;
+            task.source_index = source;
+            task.target_index = target;
+            task.moved = &moved;
+
+            loads[source] -= it->load;
+            loads[target] += it->load;
+            candidates.erase(it);
+        }
+
+        if (moves.empty())
+        {
+            return 0;
+        }
+
+        remaining.store(moves.size(), std::memory_order_relaxed);
+        for (auto& task : moves)
+        {
+            task.remaining = &remaining;
+            runtime_.post(task.source_index, task);
+        }
+
+        wait_for_zero(remaining);
+        return moved.load(std::memory_order_relaxed);
+    }
+
+    void rebalancer::start_migration(tracked_connection& conn,
+                                     const std::size_t target_index,
+                                     std::atomic<std::size_t>* completion)
+    {
+        assert(conn.owner && conn.owner == worker::get_current());
+        assert(target_index < workers_.size());
+
+        conn.owner->get_loop().remove_socket(conn.id);
+        workers_[conn.owner->get_index()]->unlink(conn);
+        conn.owner = nullptr;
+
+        conn.arrival.run = &rebalancer::on_arrival;
+        conn.arrival.conn = &conn;
+        conn.arrival.owner = this;
+        conn.arrival.target_index = target_index;
+        conn.arrival.completion = completion;
+        runtime_.post(target_index, conn.arrival);
+    }
+
+    void rebalancer::on_poll(void* object, const socket_id id, const poller::poll_status status)
+    {
+        auto& conn = *static_cast<tracked_connection*>(object);
+        ++conn.events;
+        conn.handler.on_poll(conn.handler.object, id, status);
+    }
+
+    void rebalancer::on_arrival(posted_task& self)
+    {
+        auto& task = static_cast<tracked_connection::migration_task&>(self);
+        auto& conn = *task.conn;
+        auto& w = *worker::get_current();
+        assert(w.get_index() == task.target_index);
+
+        conn.owner = &w;
+        task.owner->workers_[w.get_index()]->link(conn);
+        w.get_loop().add_socket(conn.id, conn.type, io_handler{&conn, &rebalancer::on_poll}, conn.mode);
+
+        // The completion must be signalled last: once it reaches zero the rebalance call returns.
+        auto* completion = std::exchange(task.completion, nullptr);
+        if (conn.on_migrated)
+        {
+            conn.on_migrated(conn, w);
+        }
+
+        if (completion)
+        {
+            count_down(*completion);
+        }
+    }
+
+    void rebalancer::on_sample(posted_task& self)
+    {
+        auto& task = static_cast<worker_state::sample_task&>(self);
+        const auto weight = task.owner->options_.event_weight;
+        const auto max_candidates = task.owner->options_.candidates_per_worker;
+
+        task.load = 0;
+        task.candidates.clear();
+        for (auto* conn = task.state->head; conn; conn = conn->next)
+        {
+            const auto load = (conn->bytes - conn->sampled_bytes) + (conn->events - conn->sampled_events) * weight;
+            conn->sampled_bytes = conn->bytes;
+            conn->sampled_events = conn->events;
+            task.load += load;
+
+            // Keep the heaviest connections, sorted heaviest first.
+            if (task.candidates.size() == max_candidates)
+            {
+                if (max_candidates == 0 || task.candidates.back().load >= load)
+                {
+                    continue;
+                }
+
+                task.candidates.pop_back();
+            }
+
+            const auto pos = std::find_if(task.candidates.begin(), task.candidates.end(), [load](const candidate& c) {
+                return c.load < load;
+            });
+            task.candidates.insert(pos, candidate{conn, conn->serial, load});
+        }
+
+        count_down(*task.remaining);
+    }
+
+    void rebalancer::on_move(posted_task& self)
+    {
+        auto& task = static_cast<move_task&>(self);
+        auto& owner = *task.owner;
+        auto& w = *worker::get_current();
+
+        if (!owner.workers_[w.get_index()]->contains(task.conn, task.serial) || w.get_index() == task.target_index)
+        {
+            count_down(*task.remaining);
+            return;
+        }
+
+        task.moved->fetch_add(1, std::memory_order_relaxed);
+        owner.start_migration(*task.conn, task.target_index, task.remaining);
+    }
+
+} // namespace jhoyt::asl
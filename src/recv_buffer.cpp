@@ -0,0 +1,58 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "jhoyt/asl/recv_buffer.hpp"
+
+namespace jhoyt::asl
+{
+
+    recv_buffer::recv_buffer(const std::size_t capacity) : data_(capacity)
+    {
+    }
+
+    std::span<char> recv_buffer::get_writable(const std::size_t min_size)
+    {
+        if (data_.size() - write_pos_ < min_size)
+        {
+            const auto unread = write_pos_ - read_pos_;
+            if (read_pos_ > 0)
+            {
+                // Move the unread tail to the front; this is cheap because frames are usually consumed as soon as they
+                // are complete, leaving at most one partial frame behind.
+                memmove(data_.data(), data_.data() + read_pos_, unread);
+                read_pos_ = 0;
+                write_pos_ = unread;
+            }
+
+            if (data_.size() - write_pos_ < min_size)
+            {
+                data_.resize(std::max(data_.size() * 2, write_pos_ + min_size));
+            }
+        }
+
+        return {data_.data() + write_pos_, data_.size() - write_pos_};
+    }
+
+    void recv_buffer::commit(const std::size_t count)
+    {
+        assert(count <= data_.size() - write_pos_);
+        write_pos_ += count;
+    }
+
+    void recv_buffer::consume(const std::size_t count)
+    {
+        assert(count <= write_pos_ - read_pos_);
+        read_pos_ += count;
+
+        if (read_pos_ == write_pos_)
+        {
+            read_pos_ = 0;
+            write_pos_ = 0;
+        }
+    }
+
+} // namespace jhoyt::asl
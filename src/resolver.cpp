@@ -0,0 +1,658 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "jhoyt/asl/address_parser.hpp"
+#include "jhoyt/asl/dns.hpp"
+#include "jhoyt/asl/resolver.hpp"
+#include "jhoyt/asl/socket.hpp"
+
+namespace jhoyt::asl::detail
+{
+
+    /// A datagram socket that queries are sent from. Once it has been used for queries_per_socket queries it is
+    /// retired in favour of a new one (with a new source port), and closed once the queries sent from it are done.
+    struct query_socket
+    {
+        socket sock;
+        std::size_t queries = 0;
+        std::size_t in_flight = 0;
+    };
+
+    /// A query in flight for one name, which every request for the name joins. It is its own retry timer.
+    struct resolve_query : timer
+    {
+        struct question
+        {
+            dns_record_type type = dns_record_type::a;
+            std::uint16_t id = 0;
+            std::optional<dns_response> response;
+        };
+
+        void* owner = nullptr;
+        query_socket* source = nullptr;
+        std::string name;
+        std::array<question, 2> questions;
+        std::size_t question_count = 0;
+        std::size_t attempts = 0;
+        resolve_request* head = nullptr;
+        resolve_request* tail = nullptr;
+
+        [[nodiscard]] std::span<question> get_questions()
+        {
+            return std::span{questions}.first(question_count);
+        }
+    };
+
+} // namespace jhoyt::asl::detail
+
+namespace
+{
+    using namespace jhoyt::asl;
+    using namespace jhoyt::asl::detail;
+
+    constexpr auto k_default_nameserver = ipv4_address{.host = "127.0.0.1", .port = 53};
+
+    /// Number of distinct ids a DNS message can carry.
+    constexpr auto k_dns_id_count = std::size_t{std::numeric_limits<std::uint16_t>::max()} + 1;
+
+    std::string read_file(const std::string& path)
+    {
+        if (path.empty())
+        {
+            return {};
+        }
+
+        const auto file = std::ifstream{path};
+        auto text = std::ostringstream{};
+        text << file.rdbuf();
+        return std::move(text).str();
+    }
+
+    raw_address select_nameserver(const resolver_options& options)
+    {
+        if (options.nameserver)
+        {
+            return *options.nameserver;
+        }
+
+        return parse_resolv_conf(read_file(options.resolv_conf_path)).value_or(raw_address{k_default_nameserver});
+    }
+
+    std::vector<raw_address> make_addresses(const dns_hosts& hosts, const std::uint16_t port)
+    {
+        auto addrs = std::vector<raw_address>{};
+        addrs.reserve(hosts.size());
+        for (const auto& host : hosts)
+        {
+            if (const auto* ipv4 = std::get_if<ipv4_host>(&host))
+            {
+                addrs.emplace_back(ipv4_address{.host = *ipv4, .port = port});
+            }
+            else
+            {
+                addrs.emplace_back(ipv6_address{.host = std::get<ipv6_host>(host), .port = port});
+            }
+        }
+
+        return addrs;
+    }
+
+    std::optional<std::variant<ipv4_host, ipv6_host>> parse_numeric_host(const std::string_view name)
+    {
+        if (auto bytes = ipv4_host::bytes_type{}; parse_ipv4_bytes(name, bytes))
+        {
+            return ipv4_host{bytes};
+        }
+
+        if (auto bytes = ipv6_host::bytes_type{}; parse_ipv6_bytes(name, bytes))
+        {
+            return ipv6_host{bytes};
+        }
+
+        return std::nullopt;
+    }
+
+    void complete(resolve_request& request, const resolve_status status, const dns_hosts& hosts)
+    {
+        const auto addrs = make_addresses(hosts, request.port);
+        request.on_resolved(request, status, addrs);
+    }
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    struct resolver::impl
+    {
+        struct cache_entry
+        {
+            resolve_status status = resolve_status::not_found;
+            dns_hosts hosts;
+            std::chrono::steady_clock::time_point expires;
+        };
+
+        event_loop& loop;
+        resolver_options options;
+        raw_address nameserver;
+        socket_domain domain = socket_domain::ipv4;
+
+        /// The sockets queries are sent from; the last one is used for new queries and the others are retired.
+        std::vector<std::unique_ptr<query_socket>> sockets;
+        std::unordered_map<std::string, dns_hosts> hosts;
+        std::unordered_map<std::string, cache_entry> cache;
+        std::unordered_map<std::string, std::unique_ptr<resolve_query>> queries;
+        std::unordered_map<std::uint16_t, resolve_query*> questions_by_id;
+        std::mt19937 random{std::random_device{}()};
+        std::array<char, k_max_dns_message_size> buffer{};
+        resolver::stats counters;
+
+        impl(event_loop& l, resolver_options opts)
+            : loop(l), options(std::move(opts)), nameserver(select_nameserver(options)),
+              hosts(parse_hosts_file(read_file(options.hosts_path)))
+        {
+            switch (get_address_type(nameserver.get_address()))
+            {
+
+            case address_type::ipv4:
+                domain = socket_domain::ipv4;
+                break;
+
+            case address_type::ipv6:
+                domain = socket_domain::ipv6;
+                break;
+
+            default:
+                throw std::runtime_error{"resolver nameserver must be an ip address"};
+            }
+
+            open_socket();
+        }
+
+        ~impl()
+        {
+            for (const auto& source : sockets)
+            {
+                loop.remove_socket(source->sock.get_id());
+            }
+        }
+
+        impl(const impl&) = delete;
+        impl& operator=(const impl&) = delete;
+
+        void open_socket()
+        {
+            auto source = std::make_unique<query_socket>();
+            source->sock.open(domain, socket_type::datagram);
+            sockets.reserve(sockets.size() + 1);
+            loop.add_socket(source->sock.get_id(), poller::poll_type::read, *this);
+            sockets.push_back(std::move(source));
+        }
+
+        /// Retrieve the socket to send a new query from, replacing the current one once it has sent its share.
+        query_socket& select_socket()
+        {
+            close_retired_sockets();
+            if (options.queries_per_socket > 0 && sockets.back()->queries >= options.queries_per_socket)
+            {
+                try
+                {
+                    open_socket();
+                    close_retired_sockets();
+                }
+                catch (const std::runtime_error&)
+                {
+                    // The current socket carries on (and a new one is tried for the next query) rather than failing
+                    // the lookup.
+                }
+            }
+
+            return *sockets.back();
+        }
+
+        /// Close the retired sockets that no query is waiting on anymore.
+        void close_retired_sockets()
+        {
+            for (auto it = sockets.begin(); it != std::prev(sockets.end());)
+            {
+                if ((*it)->in_flight > 0)
+                {
+                    ++it;
+                    continue;
+                }
+
+                loop.remove_socket((*it)->sock.get_id());
+                it = sockets.erase(it);
+            }
+        }
+
+        void start(std::string name, resolve_request& request)
+        {
+            auto query = std::make_unique<resolve_query>();
+            query->on_expired = &impl::on_expired;
+            query->owner = this;
+            query->name = std::move(name);
+
+            // The AAAA question comes first, so its addresses are listed first.
+            if (options.query_ipv6)
+            {
+                query->questions[query->question_count++].type = dns_record_type::aaaa;
+            }
+
+            query->questions[query->question_count++].type = dns_record_type::a;
+
+            // Every question in flight needs an id of its own; once they are all taken no free one could be picked.
+            if (questions_by_id.size() + query->question_count > k_dns_id_count)
+            {
+                complete(request, resolve_status::failed, {});
+                return;
+            }
+
+            for (auto& question : query->get_questions())
+            {
+                do
+                {
+                    question.id = static_cast<std::uint16_t>(random());
+                } while (questions_by_id.contains(question.id));
+
+                questions_by_id.emplace(question.id, query.get());
+            }
+
+            auto& source = select_socket();
+            ++source.queries;
+            ++source.in_flight;
+            query->source = &source;
+
+            query->head = query->tail = &request;
+            request.query = query.get();
+
+            auto& started = *queries.emplace(query->name, std::move(query)).first->second;
+            if (!send(started))
+            {
+                finish(started, resolve_status::failed);
+                return;
+            }
+
+            loop.schedule_after(started, options.timeout);
+        }
+
+        /// Send the questions that have not been answered yet; returns false if the nameserver cannot be reached.
+        bool send(resolve_query& query)
+        {
+            ++query.attempts;
+            for (auto& question : query.get_questions())
+            {
+                if (question.response)
+                {
+                    continue;
+                }
+
+                const auto size = write_dns_query(query.name, question.id, question.type, buffer);
+                try
+                {
+                    // A datagram that would block is as good as lost and is sent again on timeout.
+                    query.source->sock.send_to(std::span{buffer.data(), size}, nameserver);
+                    ++counters.queries;
+                }
+                catch (const std::runtime_error&)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void on_poll(const socket_id id, poller::poll_status)
+        {
+            const auto found = std::ranges::find(sockets, id, [](const auto& s) { return s->sock.get_id(); });
+            if (found == sockets.end())
+            {
+                return;
+            }
+
+            // The socket counts as in use while its queue is drained, so that a request completed from here that
+            // starts another query does not close it if it has been retired.
+            auto& source = **found;
+            ++source.in_flight;
+            while (true)
+            {
+                auto from = raw_address{};
+                auto result = std::pair<socket::transfer_status, std::size_t>{};
+                try
+                {
+                    result = source.sock.recv_from(buffer, from);
+                }
+                catch (const std::runtime_error&)
+                {
+                    // An error reported for an earlier datagram (e.g. an ICMP port unreachable) is left to the retry
+                    // timer; datagrams still queued are reported again by the level-triggered poll.
+                    break;
+                }
+
+                if (result.first != socket::transfer_status::success)
+                {
+                    break;
+                }
+
+                if (from == nameserver && result.second >= sizeof(std::uint16_t))
+                {
+                    receive(source, std::span{buffer.data(), result.second});
+                }
+            }
+
+            --source.in_flight;
+            close_retired_sockets();
+        }
+
+        void receive(const query_socket& source, const std::span<const char> data)
+        {
+            const auto id = static_cast<std::uint16_t>(static_cast<std::uint8_t>(data[0]) << 8 |
+                                                       static_cast<std::uint8_t>(data[1]));
+            const auto found = questions_by_id.find(id);
+            if (found == questions_by_id.end())
+            {
+                return;
+            }
+
+            // An answer only counts on the socket the question was sent from.
+            auto& query = *found->second;
+            if (query.source != &source)
+            {
+                return;
+            }
+
+            auto& question = *std::ranges::find(query.get_questions(), id, &resolve_query::question::id);
+            question.response = parse_dns_response(data, id, query.name, question.type);
+            if (!question.response)
+            {
+                // Whatever this is, it does not answer the question, which is still waiting for the real answer.
+                return;
+            }
+
+            questions_by_id.erase(found);
+            if (std::ranges::all_of(query.get_questions(), [](const auto& q) { return q.response.has_value(); }))
+            {
+                finish(query, resolve_status::timed_out);
+            }
+        }
+
+        static void on_expired(timer& self)
+        {
+            auto& query = static_cast<resolve_query&>(self);
+            auto& owner = *static_cast<impl*>(query.owner);
+            if (query.attempts < owner.options.attempts)
+            {
+                if (owner.send(query))
+                {
+                    owner.loop.schedule_after(query, owner.options.timeout);
+                }
+                else
+                {
+                    owner.finish(query, resolve_status::failed);
+                }
+
+                return;
+            }
+
+            ++owner.counters.timeouts;
+            owner.finish(query, resolve_status::timed_out);
+            owner.close_retired_sockets();
+        }
+
+        /// Work out the outcome of a query from the answers it got, cache it and complete every request for the name.
+        /// @param unanswered_status The outcome if a question is still unanswered and there are no addresses.
+        void finish(resolve_query& query, const resolve_status unanswered_status)
+        {
+            auto found_hosts = dns_hosts{};
+            auto answered = true;
+            auto failed = false;
+            auto answer_ttl = UINT32_MAX;
+            auto negative_ttl = UINT32_MAX;
+            for (auto& question : query.get_questions())
+            {
+                if (!question.response)
+                {
+                    questions_by_id.erase(question.id);
+                    answered = false;
+                    continue;
+                }
+
+                const auto& response = *question.response;
+                failed = failed ||
+                         (response.code != dns_response_code::no_error &&
+                          response.code != dns_response_code::name_error) ||
+                         (response.truncated && response.hosts.empty());
+
+                found_hosts.insert(found_hosts.end(), response.hosts.begin(), response.hosts.end());
+                auto& ttl = response.hosts.empty() ? negative_ttl : answer_ttl;
+                ttl = std::min(ttl, response.ttl.value_or(UINT32_MAX));
+            }
+
+            // Addresses for one family are good enough, even if the question for the other one went unanswered.
+            auto status = resolve_status::success;
+            if (!found_hosts.empty())
+            {
+                store(query.name, status, found_hosts, std::min(std::chrono::seconds{answer_ttl}, options.max_ttl));
+            }
+            else if (!answered)
+            {
+                status = unanswered_status;
+            }
+            else if (failed)
+            {
+                status = resolve_status::failed;
+            }
+            else
+            {
+                status = resolve_status::not_found;
+                store(query.name,
+                      status,
+                      found_hosts,
+                      std::min(std::chrono::seconds{negative_ttl}, options.negative_ttl));
+            }
+
+            loop.cancel(query);
+            --query.source->in_flight;
+
+            // The extracted node keeps the query alive while its requests are completed; a request completed here may
+            // cancel others that are still linked to it.
+            const auto node = queries.extract(query.name);
+            for (auto* request = query.head; request; request = query.head)
+            {
+                query.head = request->next;
+                request->next = nullptr;
+                request->query = nullptr;
+                complete(*request, status, found_hosts);
+            }
+        }
+
+        void store(const std::string& name,
+                   const resolve_status status,
+                   const dns_hosts& name_hosts,
+                   const std::chrono::seconds ttl)
+        {
+            if (options.cache_capacity == 0 || ttl == std::chrono::seconds::zero())
+            {
+                return;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (cache.size() >= options.cache_capacity && !cache.contains(name))
+            {
+                std::erase_if(cache, [&](const auto& entry) { return entry.second.expires <= now; });
+                if (cache.size() >= options.cache_capacity)
+                {
+                    cache.erase(cache.begin());
+                }
+            }
+
+            cache.insert_or_assign(name, cache_entry{.status = status, .hosts = name_hosts, .expires = now + ttl});
+        }
+    };
+
+    resolver::resolver(event_loop& loop, resolver_options options)
+        : pimpl_(std::make_unique<impl>(loop, std::move(options)))
+    {
+    }
+
+    resolver::~resolver()
+    {
+        for (auto& [name, query] : pimpl_->queries)
+        {
+            pimpl_->loop.cancel(*query);
+            for (auto* request = query->head; request; request = request->next)
+            {
+                request->query = nullptr;
+            }
+        }
+    }
+
+    const resolver::stats& resolver::get_stats() const
+    {
+        return pimpl_->counters;
+    }
+
+    void resolver::resolve(const std::string_view name, const std::uint16_t port, resolve_request& request)
+    {
+        assert(request.on_resolved && !request.query);
+
+        ++pimpl_->counters.lookups;
+        request.port = port;
+        request.next = nullptr;
+
+        if (const auto host = parse_numeric_host(name))
+        {
+            complete(request, resolve_status::success, dns_hosts{*host});
+            return;
+        }
+
+        if (!is_valid_dns_name(name))
+        {
+            complete(request, resolve_status::not_found, {});
+            return;
+        }
+
+        auto key = normalize_dns_name(name);
+        if (const auto found = pimpl_->hosts.find(key); found != pimpl_->hosts.end())
+        {
+            ++pimpl_->counters.hosts_hits;
+            complete(request, resolve_status::success, found->second);
+            return;
+        }
+
+        if (const auto found = pimpl_->cache.find(key); found != pimpl_->cache.end())
+        {
+            if (found->second.expires > std::chrono::steady_clock::now())
+            {
+                ++pimpl_->counters.cache_hits;
+                complete(request, found->second.status, found->second.hosts);
+                return;
+            }
+
+            pimpl_->cache.erase(found);
+        }
+
+        if (const auto found = pimpl_->queries.find(key); found != pimpl_->queries.end())
+        {
+            ++pimpl_->counters.joined;
+            auto& query = *found->second;
+            query.tail->next = &request;
+            query.tail = &request;
+            request.query = &query;
+            return;
+        }
+
+        pimpl_->start(std::move(key), request);
+    }
+
+    void resolver::cancel(resolve_request& request)
+    {
+        auto* query = request.query;
+        if (!query)
+        {
+            return;
+        }
+
+        auto* prev = static_cast<resolve_request*>(nullptr);
+        for (auto* current = query->head; current != &request; current = current->next)
+        {
+            prev = current;
+        }
+
+        (prev ? prev->next : query->head) = request.next;
+        if (query->tail == &request)
+        {
+            query->tail = prev;
+        }
+
+        request.next = nullptr;
+        request.query = nullptr;
+    }
+
+    resolve_awaiter resolver::async_resolve(const std::string_view name, const std::uint16_t port)
+    {
+        return resolve_awaiter{*this, name, port};
+    }
+
+    std::size_t resolver::get_cache_size() const
+    {
+        return pimpl_->cache.size();
+    }
+
+    void resolver::clear_cache()
+    {
+        pimpl_->cache.clear();
+    }
+
+    resolve_awaiter::resolve_awaiter(resolver& owner, const std::string_view name, const std::uint16_t port)
+        : resolve_request{&resolve_awaiter::notify}, owner_(owner), name_(name), port_(port)
+    {
+    }
+
+    resolve_awaiter::~resolve_awaiter()
+    {
+        owner_.cancel(*this);
+    }
+
+    bool resolve_awaiter::await_suspend(const std::coroutine_handle<> handle)
+    {
+        // A name that resolves right away completes the request before resolve returns, and the coroutine carries on
+        // without suspending.
+        owner_.resolve(name_, port_, *this);
+        if (completed_)
+        {
+            return false;
+        }
+
+        handle_ = handle;
+        return true;
+    }
+
+    void resolve_awaiter::notify(resolve_request& self, const resolve_status status, std::span<const raw_address> addrs)
+    {
+        auto& awaiter = static_cast<resolve_awaiter&>(self);
+        awaiter.result_ = resolve_result{.status = status, .addrs = {addrs.begin(), addrs.end()}};
+        awaiter.completed_ = true;
+        if (awaiter.handle_)
+        {
+            awaiter.handle_.resume();
+        }
+    }
+
+} // namespace jhoyt::asl
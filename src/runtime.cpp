@@ -0,0 +1,350 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "jhoyt/asl/runtime.hpp"
+
+#include "detail/error.hpp"
+#include "detail/notifier.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+
+    /// Poller timeout that blocks until a socket is ready; workers are woken through their notifier.
+    constexpr auto k_infinite_timeout = std::chrono::milliseconds{-1};
+
+    thread_local worker* current_worker = nullptr;
+
+    /// Retrieve the CPUs the process may run on, in ascending order. Elsewhere than Linux (or if the affinity mask
+    /// cannot be read) every hardware thread is assumed to be available.
+    std::vector<std::size_t> get_allowed_cpus()
+    {
+        auto cpus = std::vector<std::size_t>{};
+#if defined(__linux__)
+        auto set = cpu_set_t{};
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (auto cpu = std::size_t{0}; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &set))
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+
+        if (cpus.empty())
+        {
+            const auto hardware_count = std::max(std::thread::hardware_concurrency(), 1u);
+            for (auto cpu = std::size_t{0}; cpu < hardware_count; ++cpu)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+
+        return cpus;
+    }
+
+    void pin_thread([[maybe_unused]] std::thread& thread, [[maybe_unused]] const std::size_t cpu)
+    {
+#if defined(__linux__)
+        auto set = cpu_set_t{};
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+
+        // pthread functions return the error code rather than setting errno.
+        if (const auto result = pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set); result != 0)
+        {
+            errno = result;
+            throw std::runtime_error{detail::make_socket_error_string("failed to set worker thread affinity")};
+        }
+#endif
+    }
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    worker::worker(runtime& rt,
+                   const std::size_t index,
+                   const std::optional<std::size_t> cpu,
+                   const std::size_t buffer_size,
+                   const std::size_t compute_batch)
+        : runtime_(rt), index_(index), cpu_(cpu), compute_batch_(compute_batch), buffers_(buffer_size),
+          notifier_(std::make_unique<detail::notifier>()), next_victim_(index)
+    {
+        loop_.add_socket(notifier_->get_id(), poller::poll_type::read, io_handler{this, &worker::on_wake});
+    }
+
+    worker::~worker()
+    {
+        stop();
+    }
+
+    worker* worker::get_current()
+    {
+        return current_worker;
+    }
+
+    void worker::post(posted_task& task)
+    {
+        assert(task.run);
+
+        // The inbox is a lock-free stack; run_inbox restores the posting order. Only the first task pushed onto an
+        // empty inbox needs to wake the worker, as the worker takes the whole inbox at once.
+        auto* head = inbox_.load(std::memory_order_relaxed);
+        do
+        {
+            task.next = head;
+        } while (!inbox_.compare_exchange_weak(head, &task, std::memory_order_release, std::memory_order_relaxed));
+
+        if (!head)
+        {
+            notifier_->notify();
+        }
+    }
+
+    void worker::submit(compute_task& task)
+    {
+        assert(task.run);
+        assert(get_current() == this);
+
+        compute_.push(&task);
+
+        // Pairs with the fence in run: either this thread sees a worker that is about to block, or that worker sees
+        // the task and does not block.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake_sleeper();
+    }
+
+    void worker::start()
+    {
+        assert(!thread_.joinable());
+
+        stopping_.store(false, std::memory_order_relaxed);
+        thread_ = std::thread{&worker::run, this};
+
+        if (cpu_)
+        {
+            try
+            {
+                pin_thread(thread_, *cpu_);
+            }
+            catch (...)
+            {
+                stop();
+                throw;
+            }
+        }
+    }
+
+    void worker::stop()
+    {
+        if (!thread_.joinable())
+        {
+            return;
+        }
+
+        stopping_.store(true, std::memory_order_release);
+        notifier_->notify();
+        thread_.join();
+    }
+
+    void worker::run()
+    {
+        current_worker = this;
+        while (!stopping_.load(std::memory_order_acquire))
+        {
+            // Only block in the poller when no worker has compute tasks waiting; a worker that submits a task wakes
+            // one that is sleeping.
+            auto timeout = std::chrono::nanoseconds{k_infinite_timeout};
+            if (has_compute_work())
+            {
+                timeout = std::chrono::nanoseconds::zero();
+            }
+            else
+            {
+                sleeping_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (has_compute_work())
+                {
+                    sleeping_.store(false, std::memory_order_relaxed);
+                    timeout = std::chrono::nanoseconds::zero();
+                }
+            }
+
+            loop_.run_once(timeout);
+            sleeping_.store(false, std::memory_order_relaxed);
+
+            run_compute();
+        }
+
+        current_worker = nullptr;
+    }
+
+    void worker::run_inbox()
+    {
+        // The notifier must be drained before the inbox is taken, otherwise the wakeup for a task posted in between
+        // could be lost.
+        notifier_->drain();
+
+        auto* task = inbox_.exchange(nullptr, std::memory_order_acquire);
+        auto* ordered = static_cast<posted_task*>(nullptr);
+        while (task)
+        {
+            auto* next = task->next;
+            task->next = ordered;
+            ordered = task;
+            task = next;
+        }
+
+        while (ordered)
+        {
+            auto* next = ordered->next;
+            ordered->run(*ordered);
+            ordered = next;
+        }
+    }
+
+    void worker::run_compute()
+    {
+        const auto& workers = runtime_.workers_;
+        for (auto count = std::size_t{0}; count < compute_batch_; ++count)
+        {
+            auto task = compute_.pop();
+            for (auto attempt = std::size_t{1}; !task && attempt < workers.size(); ++attempt)
+            {
+                // Try each of the other workers once, starting where the last steal left off.
+                next_victim_ = (next_victim_ + 1) % workers.size();
+                if (next_victim_ == index_)
+                {
+                    next_victim_ = (next_victim_ + 1) % workers.size();
+                }
+
+                auto& victim = *workers[next_victim_];
+
+                task = victim.compute_.steal();
+                compute_stats_.stolen += task ? 1 : 0;
+            }
+
+            if (!task)
+            {
+                break;
+            }
+
+            ++compute_stats_.tasks;
+            (*task)->run(**task);
+        }
+
+        // Work is left in this deque, so another (idle) worker may help.
+        if (!compute_.empty())
+        {
+            wake_sleeper();
+        }
+    }
+
+    bool worker::has_compute_work() const
+    {
+        return std::ranges::any_of(runtime_.workers_, [](const auto& w) { return !w->compute_.empty(); });
+    }
+
+    void worker::wake_sleeper()
+    {
+        for (const auto& w : runtime_.workers_)
+        {
+            if (w.get() != this && w->sleeping_.load(std::memory_order_relaxed) &&
+                w->sleeping_.exchange(false, std::memory_order_relaxed))
+            {
+                w->notifier_->notify();
+                return;
+            }
+        }
+    }
+
+    void worker::on_wake(void* object, socket_id, poller::poll_status)
+    {
+        static_cast<worker*>(object)->run_inbox();
+    }
+
+    runtime::runtime(const runtime_options& options)
+    {
+        // Pinning to a CPU outside the affinity mask fails, so workers are pinned (and counted) by the allowed CPUs
+        // rather than by the hardware threads, which differ in a container restricted to a cpuset.
+        const auto cpus = get_allowed_cpus();
+        const auto worker_count = options.worker_count > 0 ? options.worker_count : cpus.size();
+
+        workers_.reserve(worker_count);
+        for (auto ix = std::size_t{0}; ix < worker_count; ++ix)
+        {
+            auto cpu = std::optional<std::size_t>{};
+            if (options.pin_threads)
+            {
+                cpu = cpus[(options.first_cpu + ix) % cpus.size()];
+            }
+
+            // The constructor is private, so make_unique cannot be used.
+            workers_.push_back(
+                std::unique_ptr<worker>{new worker{*this, ix, cpu, options.buffer_size, options.compute_batch}});
+            workers_.back()->loop_.set_spin_options(options.spin);
+        }
+    }
+
+    runtime::~runtime()
+    {
+        stop();
+    }
+
+    void runtime::start()
+    {
+        if (running_)
+        {
+            return;
+        }
+
+        try
+        {
+            for (const auto& w : workers_)
+            {
+                w->start();
+            }
+        }
+        catch (...)
+        {
+            for (const auto& w : workers_)
+            {
+                w->stop();
+            }
+
+            throw;
+        }
+
+        running_ = true;
+    }
+
+    void runtime::stop()
+    {
+        for (const auto& w : workers_)
+        {
+            w->stop();
+        }
+
+        running_ = false;
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,54 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "jhoyt/asl/send_queue.hpp"
+
+namespace jhoyt::asl
+{
+
+    void send_queue::push(shared_buffer buf)
+    {
+        if (!buf)
+        {
+            return;
+        }
+
+        entries_.push_back({std::move(buf), 0});
+    }
+
+    socket::transfer_status send_queue::flush(socket& sock)
+    {
+        while (!entries_.empty())
+        {
+            auto& [buf, offset] = entries_.front();
+            const auto [status, count] = sock.send(buf.get_data().subspan(offset));
+            if (status != socket::transfer_status::success)
+            {
+                return status;
+            }
+
+            offset += count;
+            if (offset < buf.get_data().size())
+            {
+                // A partial send means the socket's send buffer is full.
+                return socket::transfer_status::blocked;
+            }
+
+            entries_.pop_front();
+        }
+
+        return socket::transfer_status::success;
+    }
+
+    std::size_t send_queue::get_pending_bytes() const
+    {
+        auto total = std::size_t{0};
+        for (const auto& [buf, offset] : entries_)
+        {
+            total += buf.get_data().size() - offset;
+        }
+
+        return total;
+    }
+
+} // namespace jhoyt::asl
@@ -0,0 +1,91 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "jhoyt/asl/shared_buffer.hpp"
+
+namespace jhoyt::asl
+{
+
+    shared_buffer::shared_buffer(const std::span<const char> data)
+    {
+        if (data.empty())
+        {
+            return;
+        }
+
+        // The bytes are stored directly after the block header so the whole buffer is a single allocation.
+        auto* memory = ::operator new(sizeof(block) + data.size());
+        block_ = new (memory) block{1, data.size()};
+        memcpy(reinterpret_cast<char*>(block_ + 1), data.data(), data.size());
+    }
+
+    shared_buffer::~shared_buffer()
+    {
+        release();
+    }
+
+    shared_buffer::shared_buffer(const shared_buffer& other) noexcept : block_(other.block_)
+    {
+        if (block_)
+        {
+            block_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    shared_buffer& shared_buffer::operator=(const shared_buffer& other) noexcept
+    {
+        if (this != &other)
+        {
+            auto tmp = other;
+            std::swap(block_, tmp.block_);
+        }
+
+        return *this;
+    }
+
+    shared_buffer::shared_buffer(shared_buffer&& other) noexcept : block_(std::exchange(other.block_, nullptr))
+    {
+    }
+
+    shared_buffer& shared_buffer::operator=(shared_buffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            block_ = std::exchange(other.block_, nullptr);
+        }
+
+        return *this;
+    }
+
+    std::span<const char> shared_buffer::get_data() const
+    {
+        if (!block_)
+        {
+            return {};
+        }
+
+        return {reinterpret_cast<const char*>(block_ + 1), block_->size};
+    }
+
+    std::size_t shared_buffer::get_use_count() const
+    {
+        return block_ ? block_->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    void shared_buffer::release() noexcept
+    {
+        if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            block_->~block();
+            ::operator delete(block_);
+        }
+
+        block_ = nullptr;
+    }
+
+} // namespace jhoyt::asl
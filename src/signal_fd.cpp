@@ -0,0 +1,98 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cassert>
+#include <cerrno>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <signal.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+#endif
+
+#include "jhoyt/asl/signal_fd.hpp"
+
+#include "detail/error.hpp"
+
+namespace jhoyt::asl
+{
+
+    signal_fd::signal_fd([[maybe_unused]] const std::initializer_list<int> signals)
+    {
+#if defined(__linux__)
+        auto mask = sigset_t{};
+        sigemptyset(&mask);
+        for (const auto signal : signals)
+        {
+            if (sigaddset(&mask, signal) == -1)
+            {
+                throw std::runtime_error{detail::make_socket_error_string("failed to add signal to signalfd mask")};
+            }
+        }
+
+        // pthread functions return the error code rather than setting errno.
+        if (const auto result = pthread_sigmask(SIG_BLOCK, &mask, nullptr); result != 0)
+        {
+            errno = result;
+            throw std::runtime_error{detail::make_socket_error_string("failed to block signals for signalfd")};
+        }
+
+        id_ = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+        if (id_ == k_invalid_socket)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to create signalfd")};
+        }
+#else
+        throw std::runtime_error{"signal_fd is not supported on this platform"};
+#endif
+    }
+
+    signal_fd::~signal_fd()
+    {
+#if defined(__linux__)
+        if (id_ != k_invalid_socket)
+        {
+            ::close(id_);
+        }
+#endif
+    }
+
+    signal_fd::signal_fd(signal_fd&& other) noexcept : id_(std::exchange(other.id_, k_invalid_socket))
+    {
+    }
+
+    signal_fd& signal_fd::operator=(signal_fd&& other) noexcept
+    {
+        if (this != &other)
+        {
+#if defined(__linux__)
+            if (id_ != k_invalid_socket)
+            {
+                ::close(id_);
+            }
+#endif
+            id_ = std::exchange(other.id_, k_invalid_socket);
+        }
+
+        return *this;
+    }
+
+    std::optional<int> signal_fd::consume() const
+    {
+        assert(id_ != k_invalid_socket);
+
+#if defined(__linux__)
+        auto info = signalfd_siginfo{};
+        if (read(id_, &info, sizeof(info)) == sizeof(info))
+        {
+            return static_cast<int>(info.ssi_signo);
+        }
+#endif
+
+        return std::nullopt;
+    }
+
+} // namespace jhoyt::asl
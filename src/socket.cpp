@@ -52,6 +52,9 @@ namespace
         case socket_type::stream:
             return SOCK_STREAM;
 
+        case socket_type::datagram:
+            return SOCK_DGRAM;
+
         default:
             assert(false);
         }
@@ -79,6 +82,27 @@ namespace
         return 0;
     }
 
+    void set_non_blocking(const socket_id sock)
+    {
+#if !defined(_WIN32)
+        auto flags = fcntl(sock, F_GETFL);
+        if (flags == -1)
+        {
+            ::close(sock);
+            throw std::runtime_error{detail::make_socket_error_string("failed to get socket flags")};
+        }
+
+        flags |= O_NONBLOCK;
+        if (fcntl(sock, F_SETFL, flags) == -1)
+        {
+            ::close(sock);
+            throw std::runtime_error{detail::make_socket_error_string("failed to set socket flags")};
+        }
+#else
+        assert(false);
+#endif
+    }
+
     bool would_block()
     {
 #if !defined(_WIN32)
@@ -96,7 +120,7 @@ namespace jhoyt::asl
         close();
     }
 
-    socket::socket(socket& other) noexcept : sock_(other.sock_)
+    socket::socket(socket&& other) noexcept : sock_(other.sock_)
     {
         other.sock_ = k_invalid_socket;
     }
@@ -122,23 +146,7 @@ namespace jhoyt::asl
             throw std::runtime_error{detail::make_socket_error_string("failed to open socket")};
         }
 
-#if !defined(_WIN32)
-        auto flags = fcntl(tmp_sock, F_GETFL);
-        if (flags == -1)
-        {
-            ::close(tmp_sock);
-            throw std::runtime_error{detail::make_socket_error_string("failed to get socket flags")};
-        }
-
-        flags |= O_NONBLOCK;
-        if (fcntl(tmp_sock, F_SETFL, flags) == -1)
-        {
-            ::close(tmp_sock);
-            throw std::runtime_error{detail::make_socket_error_string("failed to set socket flags")};
-        }
-#else
-        assert(false);
-#endif
+        set_non_blocking(tmp_sock);
 
         sock_ = tmp_sock;
     }
@@ -168,6 +176,55 @@ namespace jhoyt::asl
         }
     }
 
+    std::optional<std::size_t> socket::get_incoming_cpu_option() const
+    {
+        assert(sock_ != k_invalid_socket);
+
+#if defined(SO_INCOMING_CPU)
+        auto cpu = -1;
+        auto cpu_size = static_cast<socklen_t>(sizeof(cpu));
+        if (getsockopt(sock_, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &cpu_size) == k_socket_error)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to get socket option for incoming cpu")};
+        }
+
+        if (cpu >= 0)
+        {
+            return static_cast<std::size_t>(cpu);
+        }
+#endif
+
+        return std::nullopt;
+    }
+
+    bool socket::set_busy_poll_option([[maybe_unused]] const std::chrono::microseconds duration,
+                                      [[maybe_unused]] const bool prefer_busy_poll)
+    {
+        assert(sock_ != k_invalid_socket);
+        assert(duration >= std::chrono::microseconds::zero());
+
+#if defined(SO_BUSY_POLL)
+        auto usecs = static_cast<int>(duration.count());
+        if (setsockopt(sock_, SOL_SOCKET, SO_BUSY_POLL, &usecs, sizeof(usecs)) == k_socket_error)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to set socket option for busy poll")};
+        }
+
+#if defined(SO_PREFER_BUSY_POLL)
+        auto prefer = prefer_busy_poll ? 1 : 0;
+        if (setsockopt(sock_, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer, sizeof(prefer)) == k_socket_error)
+        {
+            throw std::runtime_error{
+                detail::make_socket_error_string("failed to set socket option for preferring busy poll")};
+        }
+#endif
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
     void socket::shutdown(const shutdown_type type)
     {
         assert(sock_ != k_invalid_socket);
@@ -222,7 +279,7 @@ namespace jhoyt::asl
         assert(sock_ != k_invalid_socket);
 
         auto addr_storage = sockaddr_storage{0};
-        auto addr_len = static_cast<socklen_t>(sizeof(addr));
+        auto addr_len = static_cast<socklen_t>(sizeof(addr_storage));
         const auto new_sock = ::accept(sock_, reinterpret_cast<sockaddr*>(&addr_storage), &addr_len);
         if (new_sock == k_invalid_socket)
         {
@@ -234,6 +291,9 @@ namespace jhoyt::asl
             throw std::runtime_error{detail::make_socket_error_string("failed to accept socket")};
         }
 
+        // Accepted sockets do not inherit the non-blocking flag on every platform (e.g. Linux).
+        set_non_blocking(new_sock);
+
         sock.close();
         sock.sock_ = new_sock;
 
@@ -296,4 +356,51 @@ namespace jhoyt::asl
         return {socket::transfer_status::success, count};
     }
 
+    std::pair<socket::transfer_status, size_t> socket::send_to(const std::span<const char> data, const raw_address& addr)
+    {
+        assert(sock_ != k_invalid_socket);
+
+        const auto& addr_data = addr.get_data();
+        const auto count = ::sendto(sock_,
+                                    data.data(),
+                                    data.size(),
+                                    0,
+                                    reinterpret_cast<const sockaddr*>(addr_data.data()),
+                                    addr_data.size());
+        if (count == k_socket_error)
+        {
+            if (would_block())
+            {
+                return {socket::transfer_status::blocked, 0};
+            }
+
+            throw std::runtime_error{detail::make_socket_error_string("failed to send datagram on socket")};
+        }
+
+        return {socket::transfer_status::success, count};
+    }
+
+    std::pair<socket::transfer_status, size_t> socket::recv_from(std::span<char> data, raw_address& addr)
+    {
+        assert(sock_ != k_invalid_socket);
+
+        auto addr_storage = sockaddr_storage{};
+        auto addr_len = static_cast<socklen_t>(sizeof(addr_storage));
+        const auto count =
+            ::recvfrom(sock_, data.data(), data.size(), 0, reinterpret_cast<sockaddr*>(&addr_storage), &addr_len);
+        if (count == k_socket_error)
+        {
+            if (would_block())
+            {
+                return {socket::transfer_status::blocked, 0};
+            }
+
+            throw std::runtime_error{detail::make_socket_error_string("failed to recv datagram on socket")};
+        }
+
+        addr = raw_address{std::span{reinterpret_cast<const char*>(&addr_storage), static_cast<size_t>(addr_len)}};
+
+        return {socket::transfer_status::success, count};
+    }
+
 } // namespace jhoyt::asl
\ No newline at end of file
@@ -0,0 +1,85 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <bit>
+#include <new>
+
+#include "jhoyt/asl/task.hpp"
+
+namespace
+{
+
+    constexpr auto k_min_class_shift = 6;
+    constexpr auto k_max_class_shift = 12;
+    constexpr auto k_class_count = k_max_class_shift - k_min_class_shift + 1;
+
+    struct free_frame
+    {
+        free_frame* next;
+    };
+
+    struct frame_pool
+    {
+        std::array<free_frame*, k_class_count> heads{};
+
+        frame_pool() = default;
+
+        ~frame_pool()
+        {
+            for (auto* head : heads)
+            {
+                while (head)
+                {
+                    ::operator delete(std::exchange(head, head->next));
+                }
+            }
+        }
+
+        frame_pool(const frame_pool&) = delete;
+        frame_pool& operator=(const frame_pool&) = delete;
+    };
+
+    thread_local auto g_frame_pool = frame_pool{};
+
+    std::size_t class_index(const std::size_t size)
+    {
+        const auto shift = std::bit_width(size - 1);
+        return shift <= k_min_class_shift ? 0 : shift - k_min_class_shift;
+    }
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    void* allocate_frame(const std::size_t size)
+    {
+        if (size > (std::size_t{1} << k_max_class_shift))
+        {
+            return ::operator new(size);
+        }
+
+        const auto ix = class_index(size);
+        if (auto* frame = g_frame_pool.heads[ix])
+        {
+            g_frame_pool.heads[ix] = frame->next;
+            return frame;
+        }
+
+        return ::operator new(std::size_t{1} << (ix + k_min_class_shift));
+    }
+
+    void deallocate_frame(void* ptr, const std::size_t size) noexcept
+    {
+        if (size > (std::size_t{1} << k_max_class_shift))
+        {
+            ::operator delete(ptr);
+            return;
+        }
+
+        const auto ix = class_index(size);
+        g_frame_pool.heads[ix] = new (ptr) free_frame{g_frame_pool.heads[ix]};
+    }
+
+} // namespace jhoyt::asl
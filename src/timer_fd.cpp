@@ -0,0 +1,120 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+#include "jhoyt/asl/timer_fd.hpp"
+
+#include "detail/error.hpp"
+
+namespace
+{
+
+#if defined(__linux__)
+    timespec to_timespec(const std::chrono::nanoseconds value)
+    {
+        const auto secs = std::chrono::duration_cast<std::chrono::seconds>(value);
+        return {static_cast<time_t>(secs.count()), static_cast<long>((value - secs).count())};
+    }
+#endif
+
+} // namespace
+
+namespace jhoyt::asl
+{
+
+    timer_fd::timer_fd()
+    {
+#if defined(__linux__)
+        id_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (id_ == k_invalid_socket)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to create timerfd")};
+        }
+#else
+        throw std::runtime_error{"timer_fd is not supported on this platform"};
+#endif
+    }
+
+    timer_fd::~timer_fd()
+    {
+#if defined(__linux__)
+        if (id_ != k_invalid_socket)
+        {
+            ::close(id_);
+        }
+#endif
+    }
+
+    timer_fd::timer_fd(timer_fd&& other) noexcept : id_(std::exchange(other.id_, k_invalid_socket))
+    {
+    }
+
+    timer_fd& timer_fd::operator=(timer_fd&& other) noexcept
+    {
+        if (this != &other)
+        {
+#if defined(__linux__)
+            if (id_ != k_invalid_socket)
+            {
+                ::close(id_);
+            }
+#endif
+            id_ = std::exchange(other.id_, k_invalid_socket);
+        }
+
+        return *this;
+    }
+
+    void timer_fd::arm([[maybe_unused]] const std::chrono::nanoseconds initial,
+                       [[maybe_unused]] const std::chrono::nanoseconds interval)
+    {
+        assert(id_ != k_invalid_socket);
+        assert(initial > std::chrono::nanoseconds::zero());
+        assert(interval >= std::chrono::nanoseconds::zero());
+
+#if defined(__linux__)
+        const auto spec = itimerspec{to_timespec(interval), to_timespec(initial)};
+        if (timerfd_settime(id_, 0, &spec, nullptr) == -1)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to arm timerfd")};
+        }
+#endif
+    }
+
+    void timer_fd::disarm()
+    {
+        assert(id_ != k_invalid_socket);
+
+#if defined(__linux__)
+        const auto spec = itimerspec{};
+        if (timerfd_settime(id_, 0, &spec, nullptr) == -1)
+        {
+            throw std::runtime_error{detail::make_socket_error_string("failed to disarm timerfd")};
+        }
+#endif
+    }
+
+    std::uint64_t timer_fd::consume() const
+    {
+        assert(id_ != k_invalid_socket);
+
+        auto expirations = std::uint64_t{0};
+#if defined(__linux__)
+        if (read(id_, &expirations, sizeof(expirations)) != sizeof(expirations))
+        {
+            expirations = 0;
+        }
+#endif
+
+        return expirations;
+    }
+
+} // namespace jhoyt::asl
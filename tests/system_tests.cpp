@@ -1,8 +1,27 @@
 // Copyright (c) 2025-present, Jason Hoyt
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#endif
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 #include <catch.hpp>
 
@@ -204,4 +223,1220 @@ TEST_CASE("Write Ready")
     CHECK(connected);
     CHECK(write_succeeded);
     CHECK(read_succeeded);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Edge Triggered And One Shot Polling")
+{
+    auto ctx = jhoyt::asl::context{};
+
+    const auto raw_address = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    auto server = jhoyt::asl::socket{};
+    server.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    server.set_reuse_address_option(true);
+    server.bind(raw_address);
+    server.listen(1);
+
+    auto client = jhoyt::asl::socket{};
+    client.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    client.connect(raw_address);
+
+    auto incoming_socket = jhoyt::asl::socket{};
+    auto incoming_address = jhoyt::asl::raw_address{};
+    const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (!server.accept(incoming_socket, incoming_address) && std::chrono::steady_clock::now() < end_time)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    REQUIRE(incoming_socket);
+
+    auto poller = jhoyt::asl::poller{};
+    poller.add_socket(incoming_socket.get_id(),
+                      jhoyt::asl::poller::poll_type::read,
+                      jhoyt::asl::poller::trigger_mode::edge);
+    poller.add_socket(client.get_id(),
+                      jhoyt::asl::poller::poll_type::write,
+                      jhoyt::asl::poller::trigger_mode::one_shot);
+
+    const auto count_ready = [&](const jhoyt::asl::socket& sock, const jhoyt::asl::poller::poll_status status) {
+        auto count = 0;
+        for (const auto& [id, result_status] : poller.poll(std::chrono::milliseconds{150}))
+        {
+            count += id == sock.get_id() && result_status == status ? 1 : 0;
+        }
+
+        return count;
+    };
+
+    auto msg = std::string_view{"Hello, world"};
+    client.send({msg.data(), msg.size()});
+    CHECK(count_ready(incoming_socket, jhoyt::asl::poller::poll_status::ready_to_read) == 1);
+
+    // The data has not been read, but the edge has been reported and the socket has not been re-armed.
+    CHECK(count_ready(incoming_socket, jhoyt::asl::poller::poll_status::ready_to_read) == 0);
+
+    auto buf = std::array<char, 64>{};
+    while (incoming_socket.recv(buf).first == jhoyt::asl::socket::transfer_status::success)
+    {
+    }
+
+    poller.rearm_socket(incoming_socket.get_id());
+    client.send({msg.data(), msg.size()});
+    CHECK(count_ready(incoming_socket, jhoyt::asl::poller::poll_status::ready_to_read) == 1);
+
+    // The client stays writable, but a one-shot socket is only reported again once re-armed.
+    CHECK(count_ready(client, jhoyt::asl::poller::poll_status::ready_to_write) == 0);
+    poller.rearm_socket(client.get_id());
+    CHECK(count_ready(client, jhoyt::asl::poller::poll_status::ready_to_write) == 1);
+    CHECK(count_ready(client, jhoyt::asl::poller::poll_status::ready_to_write) == 0);
+    poller.update_socket(client.get_id(), jhoyt::asl::poller::poll_type::write);
+    CHECK(count_ready(client, jhoyt::asl::poller::poll_status::ready_to_write) == 1);
+
+    // Once the peer has gone away (and this end has shut down its side too) the hang-up is reported once, not on
+    // every poll.
+    poller.remove_socket(client.get_id());
+    while (incoming_socket.recv(buf).first == jhoyt::asl::socket::transfer_status::success)
+    {
+    }
+
+    poller.rearm_socket(incoming_socket.get_id());
+    client.close();
+    incoming_socket.shutdown(jhoyt::asl::socket::shutdown_type::write);
+    CHECK(count_ready(incoming_socket, jhoyt::asl::poller::poll_status::ready_to_read) == 1);
+    CHECK(count_ready(incoming_socket, jhoyt::asl::poller::poll_status::ready_to_read) == 0);
+
+    // The same goes for a pipe whose write end has been closed, which only reports a hang-up.
+    auto p = jhoyt::asl::pipe{};
+    poller.add_socket(p.get_read_id(), jhoyt::asl::poller::poll_type::read, jhoyt::asl::poller::trigger_mode::edge);
+    p.close_write();
+    const auto count_pipe_ready = [&] {
+        const auto results = poller.poll(std::chrono::milliseconds{150});
+        return std::count_if(results.begin(), results.end(), [&](const auto& result) {
+            return result.id == p.get_read_id() && result.status == jhoyt::asl::poller::poll_status::ready_to_read;
+        });
+    };
+
+    CHECK(count_pipe_ready() == 1);
+    CHECK(count_pipe_ready() == 0);
+}
+
+#if defined(__linux__)
+TEST_CASE("Moving Onto Event Sources Closes Their Descriptors")
+{
+    const auto is_open = [](const jhoyt::asl::socket_id id) { return fcntl(id, F_GETFD) != -1; };
+
+    // The descriptor that is replaced is closed right away rather than handed to the moved-from object.
+    auto timer = jhoyt::asl::timer_fd{};
+    auto other_timer = jhoyt::asl::timer_fd{};
+    const auto timer_id = timer.get_id();
+    timer = std::move(other_timer);
+    CHECK(!is_open(timer_id));
+    CHECK(is_open(timer.get_id()));
+
+    auto signal = jhoyt::asl::signal_fd{SIGUSR2};
+    auto other_signal = jhoyt::asl::signal_fd{SIGUSR2};
+    const auto signal_id = signal.get_id();
+    signal = std::move(other_signal);
+    CHECK(!is_open(signal_id));
+    CHECK(is_open(signal.get_id()));
+}
+#endif
+
+#if !defined(_WIN32)
+TEST_CASE("Pipe Ends Are Non-Blocking And Closed On Exec")
+{
+    // Event descriptors back the notifier of every thread-safe poller, so they must not leak into child processes
+    // either.
+    const auto p = jhoyt::asl::pipe{};
+    const auto event = jhoyt::asl::event_fd{};
+    for (const auto id : {p.get_read_id(), p.get_write_id(), event.get_id()})
+    {
+        CHECK((fcntl(id, F_GETFL) & O_NONBLOCK) != 0);
+        CHECK((fcntl(id, F_GETFD) & FD_CLOEXEC) != 0);
+    }
+}
+#endif
+
+TEST_CASE("Poller Waits On Events, Timers, Signals And Pipes")
+{
+    auto event = jhoyt::asl::event_fd{};
+    auto timer = jhoyt::asl::timer_fd{};
+    auto signal = jhoyt::asl::signal_fd{SIGUSR1};
+    auto pipe = jhoyt::asl::pipe{};
+
+    auto poller = jhoyt::asl::poller{};
+    poller.add_socket(event.get_id(), jhoyt::asl::poller::poll_type::event);
+    poller.add_socket(timer.get_id(), jhoyt::asl::poller::poll_type::timer);
+    poller.add_socket(signal.get_id(), jhoyt::asl::poller::poll_type::signal);
+    poller.add_socket(pipe.get_read_id(), jhoyt::asl::poller::poll_type::read);
+    CHECK(poller.poll(std::chrono::milliseconds{0}).empty());
+
+    auto signaler = std::thread{[&event] { event.signal(3); }};
+    timer.arm(std::chrono::milliseconds{5});
+    std::raise(SIGUSR1);
+
+    auto msg = std::string_view{"Hello, world"};
+    CHECK(pipe.write({msg.data(), msg.size()}).second == msg.size());
+
+    auto event_signaled = false;
+    auto timer_expired = false;
+    auto signal_received = false;
+    auto pipe_readable = false;
+    const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (!(event_signaled && timer_expired && signal_received && pipe_readable) &&
+           std::chrono::steady_clock::now() < end_time)
+    {
+        for (const auto& [id, status] : poller.poll(std::chrono::milliseconds{150}))
+        {
+            event_signaled |= id == event.get_id() && status == jhoyt::asl::poller::poll_status::event_signaled;
+            timer_expired |= id == timer.get_id() && status == jhoyt::asl::poller::poll_status::timer_expired;
+            signal_received |= id == signal.get_id() && status == jhoyt::asl::poller::poll_status::signal_received;
+            pipe_readable |= id == pipe.get_read_id() && status == jhoyt::asl::poller::poll_status::ready_to_read;
+        }
+    }
+
+    signaler.join();
+    CHECK(event_signaled);
+    CHECK(timer_expired);
+    CHECK(signal_received);
+    CHECK(pipe_readable);
+
+    CHECK(event.consume() == 3);
+    CHECK(event.consume() == 0);
+    CHECK(timer.consume() == 1);
+    CHECK(signal.consume() == SIGUSR1);
+    CHECK(!signal.consume());
+
+    auto buf = std::array<char, 64>{};
+    const auto [read_status, count] = pipe.read(buf);
+    CHECK(read_status == jhoyt::asl::socket::transfer_status::success);
+    CHECK(std::string_view{buf.data(), count} == msg);
+    CHECK(pipe.read(buf).first == jhoyt::asl::socket::transfer_status::blocked);
+
+    pipe.close_write();
+    CHECK(pipe.read(buf).first == jhoyt::asl::socket::transfer_status::disconnected);
+
+    // Everything has been consumed, so only the closed pipe is still reported.
+    const auto results = poller.poll(std::chrono::milliseconds{0});
+    REQUIRE(results.size() == 1);
+    CHECK(results[0].id == pipe.get_read_id());
+}
+
+TEST_CASE("Broadcast")
+{
+    auto ctx = jhoyt::asl::context{};
+
+    const auto raw_address = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    auto server = jhoyt::asl::socket{};
+    server.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    server.set_reuse_address_option(true);
+    server.bind(raw_address);
+    server.listen(2);
+
+    auto clients = std::array<jhoyt::asl::socket, 2>{};
+    for (auto& client : clients)
+    {
+        client.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+        client.connect(raw_address);
+    }
+
+    auto poller = jhoyt::asl::poller{};
+    poller.add_socket(server.get_id(), jhoyt::asl::poller::poll_type::read);
+    for (auto& client : clients)
+    {
+        poller.add_socket(client.get_id(), jhoyt::asl::poller::poll_type::read);
+    }
+
+    const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    auto incoming_sockets = std::array<jhoyt::asl::socket, 2>{};
+    auto incoming_count = size_t{0};
+    auto incoming_address = jhoyt::asl::raw_address{};
+    auto broadcaster = jhoyt::asl::broadcaster{};
+    auto msg = std::string_view{"Hello, world"};
+    const auto buf = jhoyt::asl::shared_buffer{msg};
+    auto read_count = size_t{0};
+    while (read_count < clients.size() && std::chrono::steady_clock::now() < end_time)
+    {
+        for (auto events = poller.poll(std::chrono::milliseconds{150}); const auto& [id, status] : events)
+        {
+            if (id == server.get_id() && status == jhoyt::asl::poller::poll_status::ready_to_read)
+            {
+                while (incoming_count < incoming_sockets.size() &&
+                       server.accept(incoming_sockets[incoming_count], incoming_address))
+                {
+                    ++incoming_count;
+                }
+
+                if (incoming_count == incoming_sockets.size())
+                {
+                    auto targets = std::array{&incoming_sockets[0], &incoming_sockets[1]};
+                    CHECK(broadcaster.broadcast(targets, buf) == 0);
+                    CHECK(buf.get_use_count() == 1);
+                }
+            }
+            else if (status == jhoyt::asl::poller::poll_status::ready_to_read)
+            {
+                for (auto& client : clients)
+                {
+                    if (id == client.get_id())
+                    {
+                        auto recv_buf = std::string{};
+                        recv_buf.resize(64);
+                        auto [recv_status, count] = client.recv({recv_buf.data(), recv_buf.size()});
+                        CHECK(recv_status == jhoyt::asl::socket::transfer_status::success);
+
+                        recv_buf.resize(count);
+                        CHECK(recv_buf == msg);
+                        ++read_count;
+                    }
+                }
+            }
+        }
+    }
+
+    CHECK(read_count == clients.size());
+}
+
+TEST_CASE("Coroutine Echo")
+{
+    auto ctx = jhoyt::asl::context{};
+
+    const auto raw_address = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    auto server = jhoyt::asl::socket{};
+    server.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    server.set_reuse_address_option(true);
+    server.bind(raw_address);
+    server.listen(1);
+
+    auto loop = jhoyt::asl::event_loop{};
+    auto msg = std::string_view{"Hello, world"};
+    auto echoed = std::string{};
+
+    auto serve = [&]() -> jhoyt::asl::task<> {
+        auto incoming_socket = jhoyt::asl::socket{};
+        auto incoming_address = jhoyt::asl::raw_address{};
+        co_await loop.async_accept(server, incoming_socket, incoming_address);
+
+        auto buf = std::array<char, 64>{};
+        const auto [recv_status, count] = co_await loop.async_recv(incoming_socket, buf);
+        CHECK(recv_status == jhoyt::asl::socket::transfer_status::success);
+
+        const auto [send_status, sent] = co_await loop.async_send(incoming_socket, std::span{buf.data(), count});
+        CHECK(send_status == jhoyt::asl::socket::transfer_status::success);
+        CHECK(sent == count);
+    };
+
+    auto connect = [&]() -> jhoyt::asl::task<> {
+        auto client = jhoyt::asl::socket{};
+        client.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+        CHECK(co_await loop.async_connect(client, raw_address));
+
+        const auto [send_status, sent] = co_await loop.async_send(client, msg);
+        CHECK(send_status == jhoyt::asl::socket::transfer_status::success);
+        CHECK(sent == msg.size());
+
+        echoed.resize(64);
+        const auto [recv_status, count] = co_await loop.async_recv(client, echoed);
+        CHECK(recv_status == jhoyt::asl::socket::transfer_status::success);
+        echoed.resize(count);
+    };
+
+    jhoyt::asl::spawn(serve());
+    jhoyt::asl::spawn(connect());
+
+    const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (loop.has_waiters() && std::chrono::steady_clock::now() < end_time)
+    {
+        loop.run_once(std::chrono::milliseconds{150});
+    }
+
+    CHECK(echoed == msg);
+}
+
+TEST_CASE("Address Filter Closes Denied Connections")
+{
+    auto ctx = jhoyt::asl::context{};
+
+    const auto raw_address = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    auto server = jhoyt::asl::socket{};
+    server.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    server.set_reuse_address_option(true);
+    server.bind(raw_address);
+    server.listen(4);
+
+    const auto loopback_rule = jhoyt::asl::parse_cidr_rule("127.0.0.0/8", jhoyt::asl::filter_action::deny);
+    REQUIRE(loopback_rule);
+    auto filter = jhoyt::asl::address_filter{jhoyt::asl::cidr_table{std::span{&*loopback_rule, 1}}};
+
+    auto incoming_socket = jhoyt::asl::socket{};
+    auto incoming_address = jhoyt::asl::raw_address{};
+
+    auto denied_client = jhoyt::asl::socket{};
+    denied_client.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    denied_client.connect(raw_address);
+
+    // The denied connection is accepted and closed right away, so its client is disconnected.
+    auto disconnected = false;
+    auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (!disconnected && std::chrono::steady_clock::now() < end_time)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        CHECK_FALSE(filter.accept(server, incoming_socket, incoming_address));
+
+        auto buf = std::array<char, 16>{};
+        disconnected = denied_client.recv(buf).first == jhoyt::asl::socket::transfer_status::disconnected;
+    }
+
+    CHECK(disconnected);
+    CHECK_FALSE(incoming_socket);
+
+    filter.update(jhoyt::asl::cidr_table{});
+
+    auto allowed_client = jhoyt::asl::socket{};
+    allowed_client.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    allowed_client.connect(raw_address);
+
+    end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (!filter.accept(server, incoming_socket, incoming_address) && std::chrono::steady_clock::now() < end_time)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    REQUIRE(incoming_socket);
+    CHECK(std::get<jhoyt::asl::ipv4_address>(incoming_address.get_address()).host == "127.0.0.1");
+}
+
+TEST_CASE("Runtime Runs Posted Tasks On Workers")
+{
+    auto rt = jhoyt::asl::runtime{{.worker_count = 2, .pin_threads = false}};
+    REQUIRE(rt.get_worker_count() == 2);
+    rt.start();
+    CHECK(rt.is_running());
+
+    struct worker_task : jhoyt::asl::posted_task
+    {
+        std::atomic<std::size_t>* remaining = nullptr;
+        const jhoyt::asl::worker* ran_on = nullptr;
+        std::thread::id thread_id;
+    };
+
+    auto remaining = std::atomic<std::size_t>{4};
+    auto tasks = std::array<worker_task, 4>{};
+    for (auto ix = std::size_t{0}; ix < tasks.size(); ++ix)
+    {
+        tasks[ix].run = [](jhoyt::asl::posted_task& self) {
+            auto& t = static_cast<worker_task&>(self);
+            t.ran_on = jhoyt::asl::worker::get_current();
+            t.thread_id = std::this_thread::get_id();
+            t.remaining->fetch_sub(1, std::memory_order_release);
+        };
+        tasks[ix].remaining = &remaining;
+        rt.post(ix % 2, tasks[ix]);
+    }
+
+    const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (remaining.load(std::memory_order_acquire) > 0 && std::chrono::steady_clock::now() < end_time)
+    {
+        std::this_thread::yield();
+    }
+
+    rt.stop();
+    CHECK(!rt.is_running());
+    CHECK(jhoyt::asl::worker::get_current() == nullptr);
+
+    for (auto ix = std::size_t{0}; ix < tasks.size(); ++ix)
+    {
+        CHECK(tasks[ix].ran_on == &rt.get_worker(ix % 2));
+        CHECK(tasks[ix].thread_id != std::this_thread::get_id());
+    }
+
+    CHECK(tasks[0].thread_id == tasks[2].thread_id);
+    CHECK(tasks[0].thread_id != tasks[1].thread_id);
+}
+
+TEST_CASE("Runtime Pins Workers To The CPUs The Process May Run On")
+{
+    // Pinning by default must work wherever the process runs, including in a container restricted to a cpuset.
+    auto rt = jhoyt::asl::runtime{{.worker_count = 2}};
+    REQUIRE(rt.get_worker_count() == 2);
+
+#if defined(__linux__)
+    auto allowed = cpu_set_t{};
+    REQUIRE(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+    for (auto ix = std::size_t{0}; ix < rt.get_worker_count(); ++ix)
+    {
+        const auto cpu = rt.get_worker(ix).get_cpu();
+        REQUIRE(cpu);
+        CHECK(CPU_ISSET(*cpu, &allowed));
+    }
+#endif
+
+    CHECK_NOTHROW(rt.start());
+    CHECK(rt.is_running());
+    rt.stop();
+}
+
+TEST_CASE("Runtime Steals Compute Tasks And Resumes Offloaded Coroutines")
+{
+    auto rt = jhoyt::asl::runtime{{.worker_count = 2, .pin_threads = false}};
+    rt.start();
+
+    struct busy_task : jhoyt::asl::compute_task
+    {
+        std::atomic<std::size_t>* remaining = nullptr;
+        const jhoyt::asl::worker* ran_on = nullptr;
+    };
+
+    struct submit_task : jhoyt::asl::posted_task
+    {
+        std::array<busy_task, 8>* tasks = nullptr;
+    };
+
+    // Worker 0 submits every task itself, so worker 1 only runs the ones it steals.
+    auto remaining = std::atomic<std::size_t>{8};
+    auto tasks = std::array<busy_task, 8>{};
+    for (auto& t : tasks)
+    {
+        t.run = [](jhoyt::asl::compute_task& self) {
+            auto& t = static_cast<busy_task&>(self);
+            t.ran_on = jhoyt::asl::worker::get_current();
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            t.remaining->fetch_sub(1, std::memory_order_release);
+        };
+        t.remaining = &remaining;
+    }
+
+    auto submit = submit_task{};
+    submit.tasks = &tasks;
+    submit.run = [](jhoyt::asl::posted_task& self) {
+        for (auto& t : *static_cast<submit_task&>(self).tasks)
+        {
+            jhoyt::asl::worker::get_current()->submit(t);
+        }
+    };
+
+    rt.post(0, submit);
+
+    const auto* resumed_on = static_cast<const jhoyt::asl::worker*>(nullptr);
+    auto offloaded_on = std::thread::id{};
+    auto result = std::atomic<int>{0};
+    auto offload = [&]() -> jhoyt::asl::task<> {
+        const auto value = co_await jhoyt::asl::offload([&] {
+            offloaded_on = std::this_thread::get_id();
+            return 42;
+        });
+
+        resumed_on = jhoyt::asl::worker::get_current();
+        result.store(value, std::memory_order_release);
+    };
+
+    struct spawn_task : jhoyt::asl::posted_task
+    {
+        decltype(offload)* coroutine = nullptr;
+    };
+
+    auto start = spawn_task{};
+    start.coroutine = &offload;
+    start.run = [](jhoyt::asl::posted_task& self) {
+        jhoyt::asl::spawn((*static_cast<spawn_task&>(self).coroutine)());
+    };
+
+    rt.post(1, start);
+
+    const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while ((remaining.load(std::memory_order_acquire) > 0 || result.load(std::memory_order_acquire) == 0) &&
+           std::chrono::steady_clock::now() < end_time)
+    {
+        std::this_thread::yield();
+    }
+
+    rt.stop();
+
+    CHECK(remaining.load() == 0);
+    CHECK(result.load() == 42);
+    CHECK(resumed_on == &rt.get_worker(1));
+    CHECK(offloaded_on != std::thread::id{});
+
+    const auto& stats0 = rt.get_worker(0).get_compute_stats();
+    const auto& stats1 = rt.get_worker(1).get_compute_stats();
+    CHECK(stats0.tasks + stats1.tasks == 9);
+    CHECK(stats0.stolen + stats1.stolen > 0);
+    CHECK(std::ranges::any_of(tasks, [&](const auto& t) { return t.ran_on == &rt.get_worker(1); }));
+}
+
+TEST_CASE("Dispatcher Hands Connections To Workers")
+{
+    auto ctx = jhoyt::asl::context{};
+
+    const auto raw_address = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    auto server = jhoyt::asl::socket{};
+    server.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    server.set_reuse_address_option(true);
+    server.bind(raw_address);
+    server.listen(4);
+
+    auto clients = std::array<jhoyt::asl::socket, 4>{};
+    for (auto& client : clients)
+    {
+        client.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+        client.connect(raw_address);
+    }
+
+    struct handler
+    {
+        // Each worker only touches its own entry, so the connections never cross threads once handed over.
+        std::array<std::vector<jhoyt::asl::socket>, 2> connections;
+        std::atomic<std::size_t> received{0};
+        std::atomic<bool> on_worker_thread{true};
+
+        void on_connection(jhoyt::asl::worker& w, jhoyt::asl::socket& sock, const jhoyt::asl::raw_address&)
+        {
+            on_worker_thread = on_worker_thread && jhoyt::asl::worker::get_current() == &w;
+            connections[w.get_index()].push_back(std::move(sock));
+            received.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    auto rt = jhoyt::asl::runtime{{.worker_count = 2, .pin_threads = false}};
+    auto h = handler{};
+    auto d = jhoyt::asl::dispatcher{rt, h};
+    rt.start();
+
+    auto poller = jhoyt::asl::poller{};
+    poller.add_socket(server.get_id(), jhoyt::asl::poller::poll_type::read);
+
+    const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    auto accepted = size_t{0};
+    while (h.received.load(std::memory_order_acquire) < clients.size() && std::chrono::steady_clock::now() < end_time)
+    {
+        poller.poll(std::chrono::milliseconds{50});
+
+        auto incoming_socket = jhoyt::asl::socket{};
+        auto incoming_address = jhoyt::asl::raw_address{};
+        while (server.accept(incoming_socket, incoming_address))
+        {
+            CHECK(d.dispatch(incoming_socket, incoming_address) == accepted % 2);
+            CHECK(!incoming_socket);
+            ++accepted;
+        }
+    }
+
+    rt.stop();
+
+    CHECK(h.received == clients.size());
+    CHECK(h.on_worker_thread);
+    CHECK(h.connections[0].size() == 2);
+    CHECK(h.connections[1].size() == 2);
+    CHECK(d.get_load(0) == 2);
+    CHECK(d.get_load(1) == 2);
+}
+
+TEST_CASE("Thread Safe Poller Applies Changes From Other Threads")
+{
+    auto ctx = jhoyt::asl::context{};
+
+    const auto raw_address = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    auto server = jhoyt::asl::socket{};
+    server.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    server.set_reuse_address_option(true);
+    server.bind(raw_address);
+    server.listen(1);
+
+    auto client = jhoyt::asl::socket{};
+    client.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    client.connect(raw_address);
+
+    auto poller = jhoyt::asl::poller{jhoyt::asl::poller::threading_mode::thread_safe};
+    CHECK(poller.poll(std::chrono::milliseconds{0}).empty());
+
+    // The listener is registered from another thread while this thread is blocked in poll; the change must wake the
+    // poll long before its timeout.
+    auto registrar = std::thread{[&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        poller.add_socket(server.get_id(), jhoyt::asl::poller::poll_type::read);
+    }};
+
+    const auto start_time = std::chrono::steady_clock::now();
+    auto ready = false;
+    while (!ready && std::chrono::steady_clock::now() - start_time < std::chrono::seconds{5})
+    {
+        for (const auto& [id, status] : poller.poll(std::chrono::seconds{10}))
+        {
+            ready = ready || (id == server.get_id() && status == jhoyt::asl::poller::poll_status::ready_to_read);
+        }
+    }
+
+    registrar.join();
+    CHECK(ready);
+    CHECK(std::chrono::steady_clock::now() - start_time < std::chrono::seconds{5});
+
+    poller.remove_socket(server.get_id());
+    CHECK(poller.poll(std::chrono::milliseconds{0}).empty());
+
+    // The polling thread overfills the command queue between two polls (as a handler might); the queued changes are
+    // applied right away rather than waiting for a poll that can never happen.
+    auto small = jhoyt::asl::poller{jhoyt::asl::poller::threading_mode::thread_safe, 2};
+    CHECK(small.poll(std::chrono::milliseconds{0}).empty());
+    for (auto ix = 0; ix < 4; ++ix)
+    {
+        small.add_socket(server.get_id(), jhoyt::asl::poller::poll_type::read);
+        small.remove_socket(server.get_id());
+    }
+
+    small.add_socket(server.get_id(), jhoyt::asl::poller::poll_type::read);
+    const auto results = small.poll(std::chrono::milliseconds{0});
+    REQUIRE(results.size() == 1);
+    CHECK(results[0].id == server.get_id());
+}
+
+TEST_CASE("Rebalancer Moves Heavy Connections Between Workers")
+{
+    auto ctx = jhoyt::asl::context{};
+
+    const auto raw_address = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    auto server = jhoyt::asl::socket{};
+    server.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    server.set_reuse_address_option(true);
+    server.bind(raw_address);
+    server.listen(2);
+
+    struct counting_connection
+    {
+        jhoyt::asl::tracked_connection tracked;
+        jhoyt::asl::socket sock;
+        std::atomic<std::size_t> received{0};
+        std::atomic<const jhoyt::asl::worker*> last_worker{nullptr};
+
+        void on_poll(jhoyt::asl::socket_id, jhoyt::asl::poller::poll_status)
+        {
+            auto buf = std::array<char, 4096>{};
+            const auto [status, count] = sock.recv(buf);
+            if (status == jhoyt::asl::socket::transfer_status::success)
+            {
+                tracked.add_bytes(count);
+                last_worker = jhoyt::asl::worker::get_current();
+                received.fetch_add(count, std::memory_order_release);
+            }
+        }
+    };
+
+    auto clients = std::array<jhoyt::asl::socket, 2>{};
+    auto connections = std::array<counting_connection, 2>{};
+    for (auto ix = size_t{0}; ix < clients.size(); ++ix)
+    {
+        clients[ix].open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+        clients[ix].connect(raw_address);
+
+        auto poller = jhoyt::asl::poller{};
+        poller.add_socket(server.get_id(), jhoyt::asl::poller::poll_type::read);
+        auto incoming_address = jhoyt::asl::raw_address{};
+        const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!server.accept(connections[ix].sock, incoming_address) && std::chrono::steady_clock::now() < end_time)
+        {
+            poller.poll(std::chrono::milliseconds{50});
+        }
+
+        REQUIRE(connections[ix].sock);
+        connections[ix].tracked.id = connections[ix].sock.get_id();
+        connections[ix].tracked.handler = jhoyt::asl::io_handler{
+            &connections[ix], [](void* object, const jhoyt::asl::socket_id id, const jhoyt::asl::poller::poll_status s) {
+                static_cast<counting_connection*>(object)->on_poll(id, s);
+            }};
+    }
+
+    auto rt = jhoyt::asl::runtime{{.worker_count = 2, .pin_threads = false}};
+    auto balancer = jhoyt::asl::rebalancer{rt};
+    rt.start();
+
+    // Place both connections on the first worker.
+    struct attach_task : jhoyt::asl::posted_task
+    {
+        jhoyt::asl::rebalancer* balancer = nullptr;
+        std::array<counting_connection, 2>* connections = nullptr;
+        std::atomic<bool> done{false};
+    };
+
+    auto attach = attach_task{};
+    attach.run = [](jhoyt::asl::posted_task& self) {
+        auto& t = static_cast<attach_task&>(self);
+        for (auto& conn : *t.connections)
+        {
+            t.balancer->attach(conn.tracked);
+        }
+        t.done = true;
+    };
+    attach.balancer = &balancer;
+    attach.connections = &connections;
+    rt.post(0, attach);
+
+    const auto send_and_wait = [&](const size_t ix, const size_t size) {
+        const auto expected = connections[ix].received.load() + size;
+        const auto data = std::string(size, 'x');
+        auto sent = size_t{0};
+        while (sent < size)
+        {
+            sent += clients[ix].send({data.data() + sent, size - sent}).second;
+        }
+
+        const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (connections[ix].received.load(std::memory_order_acquire) < expected &&
+               std::chrono::steady_clock::now() < end_time)
+        {
+            std::this_thread::yield();
+        }
+
+        return connections[ix].received.load(std::memory_order_acquire) == expected;
+    };
+
+    CHECK(send_and_wait(0, 64 * 1024));
+    CHECK(send_and_wait(1, 16));
+    CHECK(attach.done);
+    CHECK(connections[0].last_worker == &rt.get_worker(0));
+    CHECK(connections[1].last_worker == &rt.get_worker(0));
+
+    CHECK(balancer.rebalance() == 1);
+    CHECK(balancer.get_last_loads()[0] > 0);
+    CHECK(balancer.get_last_loads()[1] == 0);
+
+    // The heavy connection keeps receiving on its new worker; the light one stays where it was.
+    CHECK(send_and_wait(0, 1024));
+    CHECK(send_and_wait(1, 16));
+    CHECK(connections[0].last_worker == &rt.get_worker(1));
+    CHECK(connections[1].last_worker == &rt.get_worker(0));
+
+    rt.stop();
+}
+
+TEST_CASE("Resolver Queries The Nameserver And Caches Answers")
+{
+    using namespace std::literals;
+
+    auto ctx = jhoyt::asl::context{};
+
+    // A stub nameserver that answers every query with one record of the queried type, except for names under
+    // "missing", which do not exist.
+    struct stub_nameserver
+    {
+        jhoyt::asl::socket sock;
+        std::size_t queries = 0;
+        std::vector<jhoyt::asl::raw_address> sources;
+        bool answering = true;
+
+        void on_poll(jhoyt::asl::socket_id, jhoyt::asl::poller::poll_status)
+        {
+            auto buf = std::array<char, 512>{};
+            auto from = jhoyt::asl::raw_address{};
+            while (true)
+            {
+                const auto [status, size] = sock.recv_from(buf, from);
+                if (status != jhoyt::asl::socket::transfer_status::success)
+                {
+                    break;
+                }
+
+                ++queries;
+                if (std::ranges::find(sources, from) == sources.end())
+                {
+                    sources.push_back(from);
+                }
+
+                if (!answering)
+                {
+                    continue;
+                }
+
+                auto response = std::string{buf.data(), size};
+                response[2] = '\x81';
+                if (response.substr(12).starts_with("\x07missing"))
+                {
+                    response[3] = '\x83';
+                }
+                else
+                {
+                    const auto is_aaaa = response[size - 3] == '\x1c';
+                    response[3] = '\x80';
+                    response[7] = '\x01';
+                    response += is_aaaa ? "\xc0\x0c\x00\x1c\x00\x01\x00\x00\x00\x3c\x00\x10"sv
+                                        : "\xc0\x0c\x00\x01\x00\x01\x00\x00\x00\x3c\x00\x04"sv;
+                    response += is_aaaa ? "\x20\x01\x0d\xb8\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x10"sv
+                                        : "\xc0\x00\x02\x0a"sv;
+                }
+
+                sock.send_to(response, from);
+            }
+        }
+    };
+
+    struct recorded_request : jhoyt::asl::resolve_request
+    {
+        bool done = false;
+        jhoyt::asl::resolve_status status = jhoyt::asl::resolve_status::failed;
+        std::vector<jhoyt::asl::raw_address> addrs;
+
+        recorded_request()
+        {
+            on_resolved = [](jhoyt::asl::resolve_request& self,
+                             const jhoyt::asl::resolve_status result,
+                             const std::span<const jhoyt::asl::raw_address> result_addrs) {
+                auto& request = static_cast<recorded_request&>(self);
+                request.done = true;
+                request.status = result;
+                request.addrs.assign(result_addrs.begin(), result_addrs.end());
+            };
+        }
+    };
+
+    auto loop = jhoyt::asl::event_loop{};
+    const auto nameserver = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    auto stub = stub_nameserver{};
+    stub.sock.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::datagram);
+    stub.sock.bind(nameserver);
+    loop.add_socket(stub.sock.get_id(), jhoyt::asl::poller::poll_type::read, stub);
+
+    const auto hosts_path = (std::filesystem::temp_directory_path() / "asl_resolver_hosts").string();
+    std::ofstream{hosts_path} << "10.1.2.3 db.internal # database\n";
+
+    auto resolver = jhoyt::asl::resolver{loop,
+                                         jhoyt::asl::resolver_options{.nameserver = nameserver,
+                                                                      .hosts_path = hosts_path,
+                                                                      .timeout = std::chrono::milliseconds{100},
+                                                                      .attempts = 2,
+                                                                      .queries_per_socket = 2}};
+    std::filesystem::remove(hosts_path);
+
+    const auto run_until = [&](const auto& done) {
+        const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!done() && std::chrono::steady_clock::now() < end_time)
+        {
+            loop.run_once(std::chrono::milliseconds{50});
+        }
+    };
+
+    // Concurrent lookups of a name share one query per record type.
+    auto first = recorded_request{};
+    auto second = recorded_request{};
+    resolver.resolve("service.test", 80, first);
+    resolver.resolve("Service.Test.", 443, second);
+    CHECK_FALSE(first.done);
+    CHECK(resolver.get_stats().joined == 1);
+
+    run_until([&] { return first.done && second.done; });
+    REQUIRE(first.status == jhoyt::asl::resolve_status::success);
+    REQUIRE(first.addrs.size() == 2);
+    CHECK(first.addrs[0] == jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "2001:db8::10", .port = 80}});
+    CHECK(first.addrs[1] == jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "192.0.2.10", .port = 80}});
+    REQUIRE(second.addrs.size() == 2);
+    CHECK(std::get<jhoyt::asl::ipv6_address>(second.addrs[0].get_address()).port == 443);
+    CHECK(stub.queries == 2);
+
+    // Cached names, names in the hosts file and numeric hosts complete right away.
+    auto cached = recorded_request{};
+    resolver.resolve("service.test", 8080, cached);
+    CHECK(cached.done);
+    CHECK(cached.addrs.size() == 2);
+    CHECK(resolver.get_stats().cache_hits == 1);
+
+    auto from_hosts = recorded_request{};
+    resolver.resolve("DB.internal", 5432, from_hosts);
+    REQUIRE(from_hosts.done);
+    REQUIRE(from_hosts.addrs.size() == 1);
+    CHECK(from_hosts.addrs[0] == jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "10.1.2.3", .port = 5432}});
+
+    auto numeric = recorded_request{};
+    resolver.resolve("::1", 22, numeric);
+    CHECK(numeric.done);
+    CHECK(numeric.addrs.size() == 1);
+    CHECK(stub.queries == 2);
+
+    // Names that do not exist are cached as well.
+    auto missing = recorded_request{};
+    resolver.resolve("missing.test", 80, missing);
+    run_until([&] { return missing.done; });
+    CHECK(missing.status == jhoyt::asl::resolve_status::not_found);
+    CHECK(missing.addrs.empty());
+
+    auto missing_again = recorded_request{};
+    resolver.resolve("missing.test", 80, missing_again);
+    CHECK(missing_again.status == jhoyt::asl::resolve_status::not_found);
+    CHECK(stub.queries == 4);
+
+    // Unanswered queries are sent again and then time out.
+    stub.answering = false;
+    auto slow = recorded_request{};
+    resolver.resolve("slow.test", 80, slow);
+    run_until([&] { return slow.done; });
+    CHECK(slow.status == jhoyt::asl::resolve_status::timed_out);
+    CHECK(stub.queries == 8);
+    CHECK(resolver.get_stats().timeouts == 1);
+
+    // A cancelled request is never completed, while the coroutine that asked for the same name is.
+    stub.answering = true;
+    auto cancelled = recorded_request{};
+    auto result = std::optional<jhoyt::asl::resolve_result>{};
+    resolver.resolve("coroutine.test", 80, cancelled);
+
+    auto lookup = [&]() -> jhoyt::asl::task<> {
+        result = co_await resolver.async_resolve("coroutine.test", 8080);
+    };
+
+    jhoyt::asl::spawn(lookup());
+    resolver.cancel(cancelled);
+
+    run_until([&] { return result.has_value(); });
+    CHECK_FALSE(cancelled.done);
+    REQUIRE(result);
+    CHECK(result->status == jhoyt::asl::resolve_status::success);
+    CHECK(result->addrs.size() == 2);
+
+    // Every two names were queried from a new source port, and answers to the new socket were still accepted.
+    CHECK(stub.sources.size() == 2);
+
+    loop.remove_socket(stub.sock.get_id());
+}
+
+TEST_CASE("Connect Race Falls Back From Stalled And Refused Addresses")
+{
+    auto ctx = jhoyt::asl::context{};
+
+    // A listener that never accepts: one connection fills its backlog, so the handshakes of later connections are
+    // never completed and their connects stay pending.
+    struct stalled_listener
+    {
+        jhoyt::asl::socket server;
+        jhoyt::asl::socket filler;
+
+        stalled_listener(const jhoyt::asl::raw_address& addr, const jhoyt::asl::socket_domain domain)
+        {
+            server.open(domain, jhoyt::asl::socket_type::stream);
+            server.set_reuse_address_option(true);
+            server.bind(addr);
+            server.listen(0);
+
+            filler.open(domain, jhoyt::asl::socket_type::stream);
+            filler.connect(addr);
+        }
+    };
+
+    struct recorded_race
+    {
+        std::size_t completions = 0;
+
+        void on_race_completed(jhoyt::asl::connect_race&)
+        {
+            ++completions;
+        }
+    };
+
+    const auto good = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    const auto stalled = jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "::1", .port = 5556}};
+    const auto refused = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5557}};
+
+    auto server = jhoyt::asl::socket{};
+    server.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    server.set_reuse_address_option(true);
+    server.bind(good);
+    server.listen(16);
+
+    auto stalled_server = stalled_listener{stalled, jhoyt::asl::socket_domain::ipv6};
+
+    auto loop = jhoyt::asl::event_loop{};
+    const auto run_until = [&](const auto& done) {
+        const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!done() && std::chrono::steady_clock::now() < end_time)
+        {
+            loop.run_once(std::chrono::milliseconds{50});
+        }
+    };
+
+    // The IPv6 address is tried first and stalls, so the IPv4 address is tried after the attempt delay and wins.
+    auto race = jhoyt::asl::connect_race{loop, {.attempt_delay = std::chrono::milliseconds{50}}};
+    auto recorded = recorded_race{};
+    const auto start_time = std::chrono::steady_clock::now();
+    race.start(std::vector{stalled, good}, recorded);
+    CHECK(race.get_status() == jhoyt::asl::connect_race::status::running);
+    CHECK(race.get_attempt_count() == 1);
+
+    run_until([&] { return recorded.completions > 0; });
+    CHECK(recorded.completions == 1);
+    REQUIRE(race.get_status() == jhoyt::asl::connect_race::status::connected);
+    CHECK(std::chrono::steady_clock::now() - start_time >= std::chrono::milliseconds{50});
+    CHECK(race.get_attempt_count() == 2);
+    CHECK(race.get_address() == good);
+
+    auto sock = race.take_socket();
+    CHECK(sock);
+    CHECK_FALSE(race.take_socket());
+    CHECK_FALSE(loop.has_waiters());
+
+    // A refused address moves on to the next one without waiting out the attempt delay.
+    auto patient = jhoyt::asl::connect_race{loop, {.attempt_delay = std::chrono::seconds{5}}};
+    auto recorded_patient = recorded_race{};
+    patient.start(std::vector{refused, good}, recorded_patient);
+    run_until([&] { return recorded_patient.completions > 0; });
+    CHECK(patient.get_status() == jhoyt::asl::connect_race::status::connected);
+    CHECK(patient.get_address() == good);
+
+    // Attempts that never connect time out, and a race without candidates fails right away.
+    auto timed = jhoyt::asl::connect_race{loop, {.timeout = std::chrono::milliseconds{100}}};
+    auto recorded_timed = recorded_race{};
+    timed.start(std::vector{stalled}, recorded_timed);
+    run_until([&] { return recorded_timed.completions > 0; });
+    CHECK(timed.get_status() == jhoyt::asl::connect_race::status::timed_out);
+    CHECK_FALSE(timed.take_socket());
+    CHECK_FALSE(loop.has_waiters());
+
+    timed.start({}, recorded_timed);
+    CHECK(timed.get_status() == jhoyt::asl::connect_race::status::failed);
+    CHECK(recorded_timed.completions == 2);
+
+    // A cancelled race is never completed.
+    timed.start(std::vector{stalled}, recorded_timed);
+    timed.cancel();
+    CHECK(timed.get_status() == jhoyt::asl::connect_race::status::idle);
+    loop.run_once(std::chrono::milliseconds{150});
+    CHECK(recorded_timed.completions == 2);
+
+    // A coroutine awaits the race, which may be destroyed along with the coroutine once it has completed.
+    auto connected = std::optional<bool>{};
+    auto address = jhoyt::asl::raw_address{};
+    auto connect = [&]() -> jhoyt::asl::task<> {
+        const auto candidates = std::vector{stalled, good};
+        auto coroutine_race = jhoyt::asl::connect_race{loop, {.attempt_delay = std::chrono::milliseconds{20}}};
+        connected = co_await coroutine_race.async_connect(candidates);
+        address = coroutine_race.get_address();
+    };
+
+    jhoyt::asl::spawn(connect());
+    run_until([&] { return connected.has_value(); });
+    CHECK(connected == true);
+    CHECK(address == good);
+}
+
+TEST_CASE("Connection Pool Keeps Warm Connections")
+{
+    auto ctx = jhoyt::asl::context{};
+
+    struct accepting_server
+    {
+        jhoyt::asl::socket sock;
+        std::vector<jhoyt::asl::socket> accepted;
+
+        void on_poll(jhoyt::asl::socket_id, jhoyt::asl::poller::poll_status)
+        {
+            auto incoming = jhoyt::asl::socket{};
+            auto addr = jhoyt::asl::raw_address{};
+            while (sock.accept(incoming, addr))
+            {
+                accepted.push_back(std::move(incoming));
+            }
+        }
+    };
+
+    struct recorded_checkout : jhoyt::asl::checkout_request
+    {
+        bool done = false;
+        jhoyt::asl::pooled_connection connection;
+
+        recorded_checkout()
+        {
+            on_checkout = [](jhoyt::asl::checkout_request& self, jhoyt::asl::pooled_connection result) {
+                auto& request = static_cast<recorded_checkout&>(self);
+                request.done = true;
+                request.connection = std::move(result);
+            };
+        }
+    };
+
+    const auto destination = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+    const auto refused = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5557}};
+
+    auto loop = jhoyt::asl::event_loop{};
+    auto server = accepting_server{};
+    server.sock.open(jhoyt::asl::socket_domain::ipv4, jhoyt::asl::socket_type::stream);
+    server.sock.set_reuse_address_option(true);
+    server.sock.bind(destination);
+    server.sock.listen(16);
+    loop.add_socket(server.sock.get_id(), jhoyt::asl::poller::poll_type::read, server);
+
+    const auto run_until = [&](const auto& done) {
+        const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!done() && std::chrono::steady_clock::now() < end_time)
+        {
+            loop.run_once(std::chrono::milliseconds{50});
+        }
+    };
+
+    auto pool = jhoyt::asl::connection_pool{loop,
+                                            {.max_connections = 2,
+                                             .max_idle = 2,
+                                             .spare_connections = 1,
+                                             .idle_timeout = std::chrono::milliseconds{300}}};
+
+    // A cold destination waits for a connection, and a spare one is opened alongside it.
+    auto first = recorded_checkout{};
+    pool.checkout(destination, first);
+    CHECK_FALSE(first.done);
+    CHECK(pool.get_open_count(destination) == 2);
+
+    run_until([&] { return first.done && pool.get_idle_count(destination) == 1; });
+    REQUIRE(first.connection);
+    CHECK(first.connection.get_address() == destination);
+    CHECK(pool.get_stats().connects == 2);
+
+    // The spare connection is checked out right away, after which the limit is reached.
+    auto second = recorded_checkout{};
+    pool.checkout(destination, second);
+    REQUIRE(second.done);
+    CHECK(second.connection);
+    CHECK(pool.get_stats().reused == 1);
+    CHECK(pool.get_open_count(destination) == 2);
+
+    auto third = recorded_checkout{};
+    pool.checkout(destination, third);
+    CHECK_FALSE(third.done);
+
+    // Checking a connection in hands it to the waiting checkout; checking the others in keeps them idle.
+    const auto first_id = first.connection.get_socket().get_id();
+    pool.checkin(first.connection);
+    CHECK_FALSE(first.connection);
+    REQUIRE(third.done);
+    CHECK(third.connection.get_socket().get_id() == first_id);
+
+    pool.checkin(second.connection);
+    pool.checkin(third.connection);
+    CHECK(pool.get_idle_count(destination) == 2);
+    CHECK(pool.get_stats().connects == 2);
+
+    // An idle connection whose peer closes it is dropped without being read from.
+    run_until([&] { return server.accepted.size() == 2; });
+    server.accepted.front().close();
+    run_until([&] { return pool.get_idle_count(destination) == 1; });
+    CHECK(pool.get_idle_count(destination) == 1);
+    CHECK(pool.get_stats().peer_closed == 1);
+
+    // A coroutine checks out the remaining connection, and a discarded connection frees its place under the limit.
+    auto connection = std::optional<jhoyt::asl::pooled_connection>{};
+    auto checkout = [&]() -> jhoyt::asl::task<> {
+        connection = co_await pool.async_checkout(destination);
+    };
+
+    jhoyt::asl::spawn(checkout());
+    REQUIRE(connection);
+    CHECK(*connection);
+    connection->reset();
+    CHECK(pool.get_open_count(destination) == 1);
+
+    // The idle connection times out, and a destination that refuses connections fails its checkouts.
+    run_until([&] { return pool.get_open_count(destination) == 0; });
+    CHECK(pool.get_open_count(destination) == 0);
+    CHECK(pool.get_stats().idle_expired >= 1);
+
+    auto failed = recorded_checkout{};
+    pool.checkout(refused, failed);
+    run_until([&] { return failed.done; });
+    REQUIRE(failed.done);
+    CHECK_FALSE(failed.connection);
+    CHECK(pool.get_stats().connect_failures >= 1);
+
+    loop.remove_socket(server.sock.get_id());
+}
@@ -1,10 +1,263 @@
 // Copyright (c) 2025-present, Jason Hoyt
 // Distributed under the MIT License (http://opensource.org/licenses/MIT)
 
+#include <array>
+#include <format>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <arpa/inet.h>
+
 #include <catch.hpp>
 
 #include <jhoyt/asl/address.hpp>
 
+using namespace jhoyt::asl::literals;
+
+static_assert(std::is_trivially_copyable_v<jhoyt::asl::ipv4_address>);
+static_assert(std::is_trivially_copyable_v<jhoyt::asl::ipv6_address>);
+static_assert(sizeof(jhoyt::asl::ipv4_address) == 6);
+static_assert(sizeof(jhoyt::asl::ipv6_address) == 24);
+
+// Hosts and address literals are parsed at compile time.
+static_assert(jhoyt::asl::ipv4_host{"10.1.2.3"}.get_bytes() == jhoyt::asl::ipv4_host::bytes_type{10, 1, 2, 3});
+static_assert(jhoyt::asl::ipv6_host{"::1"}.get_bytes()[15] == 1);
+static_assert("127.0.0.1:5555"_ipv4 == jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555});
+static_assert("[fe80::1%3]:80"_ipv6 == jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 80, .scope_id = 3});
+static_assert(!jhoyt::asl::parse_ipv4_address("127.0.0.1:65536"));
+
+TEST_CASE("Address Hosts")
+{
+    SECTION("IPv4 host")
+    {
+        const auto host = jhoyt::asl::ipv4_host{"192.168.1.20"};
+        CHECK(host.get_bytes() == jhoyt::asl::ipv4_host::bytes_type{192, 168, 1, 20});
+        CHECK(host == jhoyt::asl::ipv4_host{jhoyt::asl::ipv4_host::bytes_type{192, 168, 1, 20}});
+        CHECK(jhoyt::asl::ipv4_host{} == jhoyt::asl::ipv4_host{"0.0.0.0"});
+        CHECK(std::format("{}", host) == "192.168.1.20");
+
+        CHECK_THROWS(jhoyt::asl::ipv4_host{""});
+        CHECK_THROWS(jhoyt::asl::ipv4_host{"192.168.1"});
+        CHECK_THROWS(jhoyt::asl::ipv4_host{"192.168.1.256"});
+        CHECK_THROWS(jhoyt::asl::ipv4_host{std::string_view{"127.0.0.1 and more text than any host can hold"}});
+        CHECK_THROWS(jhoyt::asl::ipv4_host{"::1"});
+    }
+
+    SECTION("IPv6 host")
+    {
+        const auto host = jhoyt::asl::ipv6_host{"2001:db8::ff00:42:8329"};
+        CHECK(host.get_bytes() == jhoyt::asl::ipv6_host::bytes_type{
+                                      0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0xff, 0x00, 0x00, 0x42, 0x83, 0x29});
+        CHECK(jhoyt::asl::ipv6_host{} == jhoyt::asl::ipv6_host{"::"});
+        CHECK(std::format("{}", host) == "2001:db8::ff00:42:8329");
+        CHECK(std::format("{}", jhoyt::asl::ipv6_host{"0:0:0:0:0:ffff:7f00:1"}) == "::ffff:127.0.0.1");
+
+        CHECK_THROWS(jhoyt::asl::ipv6_host{""});
+        CHECK_THROWS(jhoyt::asl::ipv6_host{"2001:db8::1::1"});
+        CHECK_THROWS(jhoyt::asl::ipv6_host{"127.0.0.1"});
+    }
+}
+
+TEST_CASE("Address Parsing")
+{
+    SECTION("Hosts match inet_pton")
+    {
+        // Each text is parsed with both parsers, which must agree on whether it is valid and on the bytes.
+        const auto ipv4_texts = std::array<std::string_view, 18>{
+            "0.0.0.0",   "255.255.255.255", "1.2.3.4",   "192.168.100.200", "0.0.0.1",    "10.0.0.255",
+            "",          "1.2.3",           "1.2.3.4.5", "1.2.3.256",       "01.2.3.4",   "1.2.3.04",
+            "1..2.3",    ".1.2.3",          "1.2.3.",    "1.2.3.4 ",        "1.2.3.-4",   "1000.2.3.4",
+        };
+        for (const auto text : ipv4_texts)
+        {
+            INFO(text);
+            auto expected = jhoyt::asl::ipv4_host::bytes_type{};
+            auto actual = jhoyt::asl::ipv4_host::bytes_type{};
+            const auto valid = inet_pton(AF_INET, std::string{text}.c_str(), expected.data()) == 1;
+            REQUIRE(jhoyt::asl::detail::parse_ipv4_bytes(text, actual) == valid);
+            CHECK(actual == (valid ? expected : jhoyt::asl::ipv4_host::bytes_type{}));
+        }
+
+        const auto ipv6_texts = std::array<std::string_view, 30>{
+            "::",
+            "::1",
+            "1::",
+            "1:2:3:4:5:6:7:8",
+            "2001:db8::ff00:42:8329",
+            "2001:DB8:0:0:8:800:200C:417A",
+            "fe80::1:2",
+            "1:2:3:4:5:6:7::",
+            "::2:3:4:5:6:7:8",
+            "::ffff:192.0.2.1",
+            "64:ff9b::192.0.2.33",
+            "1:2:3:4:5:6:1.2.3.4",
+            "0000:0000:0000:0000:0000:0000:0000:0001",
+            "",
+            ":",
+            ":::",
+            "1:2:3:4:5:6:7",
+            "1:2:3:4:5:6:7:8:9",
+            "1:2:3:4:5:6:7:8::",
+            "::1:2:3:4:5:6:7:8",
+            "1::2::3",
+            "1:",
+            ":1",
+            "12345::",
+            "g::",
+            "1:2:3:4:5:6:7:1.2.3.4",
+            "::1.2.3",
+            "::1.2.3.4:1",
+            "::01.2.3.4",
+            "fe80::1%1",
+        };
+        for (const auto text : ipv6_texts)
+        {
+            INFO(text);
+            auto expected = jhoyt::asl::ipv6_host::bytes_type{};
+            auto actual = jhoyt::asl::ipv6_host::bytes_type{};
+            const auto valid = inet_pton(AF_INET6, std::string{text}.c_str(), expected.data()) == 1;
+            REQUIRE(jhoyt::asl::detail::parse_ipv6_bytes(text, actual) == valid);
+            CHECK(actual == (valid ? expected : jhoyt::asl::ipv6_host::bytes_type{}));
+        }
+    }
+
+    SECTION("IPv4 addresses")
+    {
+        CHECK(jhoyt::asl::parse_ipv4_address("127.0.0.1:5555") ==
+              jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555});
+        CHECK(jhoyt::asl::parse_ipv4_address("0.0.0.0:0") == jhoyt::asl::ipv4_address{.host = {}, .port = 0});
+        CHECK(jhoyt::asl::parse_ipv4_address("255.255.255.255:65535"));
+
+        CHECK_FALSE(jhoyt::asl::parse_ipv4_address("127.0.0.1"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv4_address("127.0.0.1:"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv4_address("127.0.0.1:65536"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv4_address("127.0.0.1:-1"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv4_address(":5555"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv4_address("[127.0.0.1]:5555"));
+    }
+
+    SECTION("IPv6 addresses")
+    {
+        const auto loopback = jhoyt::asl::ipv6_address{.host = "::1", .port = 5555};
+        CHECK(jhoyt::asl::parse_ipv6_address("::1:5555") == loopback);
+        CHECK(jhoyt::asl::parse_ipv6_address("[::1]:5555") == loopback);
+
+        const auto scoped = jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 5555, .scope_id = 3};
+        CHECK(jhoyt::asl::parse_ipv6_address("fe80::1%3:5555") == scoped);
+        CHECK(jhoyt::asl::parse_ipv6_address("[fe80::1%3]:5555") == scoped);
+
+        CHECK_FALSE(jhoyt::asl::parse_ipv6_address("::1"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv6_address("[::1]"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv6_address("[::1:5555"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv6_address("[::1]:70000"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv6_address("[fe80::1%]:5555"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv6_address("[fe80::1%eth0]:5555"));
+        CHECK_FALSE(jhoyt::asl::parse_ipv6_address("[fe80::1%4294967296]:5555"));
+    }
+
+    SECTION("Round trip through to_string")
+    {
+        const auto ipv4_addr = "192.168.1.20:8080"_ipv4;
+        CHECK(jhoyt::asl::parse_ipv4_address(jhoyt::asl::to_string(ipv4_addr)) == ipv4_addr);
+
+        for (const auto ipv6_addr : {"[2001:db8::ff00:42:8329]:443"_ipv6, "[fe80::1%7]:1"_ipv6, "[::]:0"_ipv6})
+        {
+            CHECK(jhoyt::asl::parse_ipv6_address(jhoyt::asl::to_string(ipv6_addr)) == ipv6_addr);
+        }
+    }
+}
+
+TEST_CASE("Address Bulk Parsing")
+{
+    SECTION("Matches the host constructor")
+    {
+        // Random hosts in every combination of field lengths, plus corrupted copies of them.
+        auto rng = std::mt19937{42};
+        auto texts = std::vector<std::string>{};
+        for (auto ix = 0; ix < 4096; ++ix)
+        {
+            auto text = std::string{};
+            for (auto field = 0; field < 4; ++field)
+            {
+                const auto limit = std::array<unsigned, 3>{9, 99, 255}[rng() % 3];
+                text += (field == 0 ? "" : ".") + std::to_string(rng() % (limit + 1));
+            }
+
+            switch (rng() % 8)
+            {
+            case 0:
+                text[rng() % text.size()] = "0.9/:a "[rng() % 7];
+                break;
+            case 1:
+                text.insert(rng() % (text.size() + 1), 1, "0.19"[rng() % 4]);
+                break;
+            case 2:
+                text.erase(rng() % text.size(), 1);
+                break;
+            default:
+                break;
+            }
+
+            texts.push_back(std::move(text));
+        }
+
+        for (const auto& text : texts)
+        {
+            INFO(text);
+            const auto view = std::string_view{text};
+            auto host = jhoyt::asl::ipv4_host{};
+            const auto count = jhoyt::asl::parse_ipv4_hosts({&view, 1}, {&host, 1});
+
+            auto expected = jhoyt::asl::ipv4_host::bytes_type{};
+            const auto valid = jhoyt::asl::detail::parse_ipv4_bytes(view, expected);
+            REQUIRE(count == (valid ? 1 : 0));
+            if (valid)
+            {
+                CHECK(host.get_bytes() == expected);
+            }
+        }
+    }
+
+    SECTION("Stops at the first malformed host")
+    {
+        const auto texts = std::array<std::string_view, 4>{"10.0.0.1", "10.0.0.2", "10.0.0.256", "10.0.0.4"};
+        auto hosts = std::array<jhoyt::asl::ipv4_host, 4>{};
+        CHECK(jhoyt::asl::parse_ipv4_hosts(std::span{texts}.first(2), hosts) == 2);
+        CHECK(hosts[1] == jhoyt::asl::ipv4_host{"10.0.0.2"});
+        CHECK(jhoyt::asl::parse_ipv4_hosts(texts, hosts) == 2);
+
+        CHECK_THROWS(jhoyt::asl::parse_ipv4_hosts(texts, std::span{hosts}.first(3)));
+    }
+}
+
+TEST_CASE("Address Ordering and Hashing")
+{
+    const auto low = jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 80};
+    const auto high = jhoyt::asl::ipv4_address{.host = "10.0.0.2", .port = 1};
+    CHECK(low < high);
+    CHECK(jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 81} > low);
+    CHECK(jhoyt::asl::ipv4_address{.host = "9.255.255.255", .port = 65535} < low);
+    CHECK(low == jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 80});
+
+    const auto hasher = std::hash<jhoyt::asl::ipv4_address>{};
+    CHECK(hasher(low) == hasher(jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 80}));
+    CHECK(hasher(low) != hasher(high));
+
+    const auto scoped = jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 80, .scope_id = 2};
+    const auto unscoped = jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 80};
+    CHECK(scoped != unscoped);
+    CHECK(unscoped < scoped);
+    CHECK(std::hash<jhoyt::asl::ipv6_address>{}(scoped) != std::hash<jhoyt::asl::ipv6_address>{}(unscoped));
+
+    CHECK(jhoyt::asl::address{low} < jhoyt::asl::address{unscoped});
+    CHECK(std::hash<jhoyt::asl::address>{}(jhoyt::asl::address{low}) ==
+          std::hash<jhoyt::asl::address>{}(jhoyt::asl::address{low}));
+}
+
 TEST_CASE("Address to::string")
 {
     const auto ipv4_addr = jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555};
@@ -13,6 +266,9 @@ TEST_CASE("Address to::string")
     const auto ipv6_addr = jhoyt::asl::ipv6_address{.host = "::1", .port = 5555};
     CHECK(jhoyt::asl::to_string(ipv6_addr) == "::1:5555");
 
+    const auto scoped_ipv6_addr = jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 5555, .scope_id = 3};
+    CHECK(jhoyt::asl::to_string(scoped_ipv6_addr) == "fe80::1%3:5555");
+
     const auto file_addr = jhoyt::asl::file_address{.path = "./test.sock"};
     CHECK(jhoyt::asl::to_string(file_addr) == "./test.sock");
 
@@ -33,4 +289,31 @@ TEST_CASE("Address to::string")
         auto addr = jhoyt::asl::address{file_addr};
         CHECK(jhoyt::asl::to_string(addr) == "file://./test.sock");
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Address std::format")
+{
+    const auto ipv4_addr = jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555};
+    CHECK(std::format("{}", ipv4_addr) == "127.0.0.1:5555");
+
+    const auto ipv6_addr = jhoyt::asl::ipv6_address{.host = "::1", .port = 5555};
+    CHECK(std::format("{}", ipv6_addr) == "::1:5555");
+
+    const auto file_addr = jhoyt::asl::file_address{.path = "./test.sock"};
+    CHECK(std::format("{}", file_addr) == "./test.sock");
+
+    CHECK(std::format("<{}> <{}>", jhoyt::asl::address{ipv4_addr}, jhoyt::asl::address{file_addr}) ==
+          "<ipv4://127.0.0.1:5555> <file://./test.sock>");
+
+    SECTION("Format specification")
+    {
+        CHECK_THROWS_AS(std::vformat("{:>20}", std::make_format_args(ipv4_addr)), std::format_error);
+    }
+
+    SECTION("Fixed buffer")
+    {
+        auto buf = std::array<char, 32>{};
+        const auto result = std::format_to_n(buf.data(), buf.size(), "{}", jhoyt::asl::address{ipv6_addr});
+        CHECK(std::string_view{buf.data(), static_cast<std::size_t>(result.size)} == "ipv6://::1:5555");
+    }
+}
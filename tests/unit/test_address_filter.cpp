@@ -0,0 +1,237 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/address_filter.hpp>
+
+namespace
+{
+
+    jhoyt::asl::cidr_rule make_rule(const std::string_view text,
+                                    const jhoyt::asl::filter_action action = jhoyt::asl::filter_action::deny)
+    {
+        const auto rule = jhoyt::asl::parse_cidr_rule(text, action);
+        REQUIRE(rule);
+        return *rule;
+    }
+
+    jhoyt::asl::raw_address make_ipv4(const std::uint32_t host)
+    {
+        const auto bytes = jhoyt::asl::ipv4_host::bytes_type{static_cast<std::uint8_t>(host >> 24),
+                                                             static_cast<std::uint8_t>(host >> 16),
+                                                             static_cast<std::uint8_t>(host >> 8),
+                                                             static_cast<std::uint8_t>(host)};
+        return jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = jhoyt::asl::ipv4_host{bytes}, .port = 80}};
+    }
+
+    jhoyt::asl::filter_action lookup(const jhoyt::asl::cidr_table& table, const jhoyt::asl::address& addr)
+    {
+        return table.lookup(jhoyt::asl::raw_address{addr});
+    }
+
+} // namespace
+
+TEST_CASE("CIDR Rule Parsing")
+{
+    const auto rule = make_rule("10.1.0.0/16");
+    CHECK(std::get<jhoyt::asl::ipv4_host>(rule.network) == jhoyt::asl::ipv4_host{"10.1.0.0"});
+    CHECK(rule.prefix_length == 16);
+    CHECK(rule.action == jhoyt::asl::filter_action::deny);
+
+    CHECK(make_rule("192.0.2.1").prefix_length == 32);
+    CHECK(make_rule("0.0.0.0/0").prefix_length == 0);
+    CHECK(make_rule("2001:db8::/32").prefix_length == 32);
+    CHECK(make_rule("::1").prefix_length == 128);
+    CHECK(std::holds_alternative<jhoyt::asl::ipv6_host>(make_rule("::ffff:10.0.0.0/104").network));
+
+    CHECK_FALSE(jhoyt::asl::parse_cidr_rule("", jhoyt::asl::filter_action::deny));
+    CHECK_FALSE(jhoyt::asl::parse_cidr_rule("10.0.0.0/", jhoyt::asl::filter_action::deny));
+    CHECK_FALSE(jhoyt::asl::parse_cidr_rule("10.0.0.0/33", jhoyt::asl::filter_action::deny));
+    CHECK_FALSE(jhoyt::asl::parse_cidr_rule("10.0.0/8", jhoyt::asl::filter_action::deny));
+    CHECK_FALSE(jhoyt::asl::parse_cidr_rule("10.0.0.0/8/8", jhoyt::asl::filter_action::deny));
+    CHECK_FALSE(jhoyt::asl::parse_cidr_rule("2001:db8::/129", jhoyt::asl::filter_action::deny));
+    CHECK_FALSE(jhoyt::asl::parse_cidr_rule("localhost/8", jhoyt::asl::filter_action::deny));
+}
+
+TEST_CASE("CIDR Table Lookup")
+{
+    using jhoyt::asl::filter_action;
+
+    SECTION("An empty table allows everything")
+    {
+        const auto table = jhoyt::asl::cidr_table{};
+        CHECK(lookup(table, jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 80}) == filter_action::allow);
+        CHECK(lookup(table, jhoyt::asl::ipv6_address{.host = "::1", .port = 80}) == filter_action::allow);
+        CHECK(table.get_node_count() == 2);
+    }
+
+    SECTION("The longest prefix wins")
+    {
+        const auto rules = std::vector{make_rule("10.0.0.0/8"),
+                                       make_rule("10.1.0.0/16", filter_action::allow),
+                                       make_rule("10.1.2.3"),
+                                       make_rule("2001:db8::/32"),
+                                       make_rule("2001:db8:1::/48", filter_action::allow)};
+        const auto table = jhoyt::asl::cidr_table{rules};
+
+        CHECK(lookup(table, jhoyt::asl::ipv4_address{.host = "10.200.0.1", .port = 80}) == filter_action::deny);
+        CHECK(lookup(table, jhoyt::asl::ipv4_address{.host = "10.1.0.1", .port = 80}) == filter_action::allow);
+        CHECK(lookup(table, jhoyt::asl::ipv4_address{.host = "10.1.2.3", .port = 80}) == filter_action::deny);
+        CHECK(lookup(table, jhoyt::asl::ipv4_address{.host = "10.1.2.4", .port = 80}) == filter_action::allow);
+        CHECK(lookup(table, jhoyt::asl::ipv4_address{.host = "11.0.0.1", .port = 80}) == filter_action::allow);
+
+        CHECK(lookup(table, jhoyt::asl::ipv6_address{.host = "2001:db8:2::1", .port = 80}) == filter_action::deny);
+        CHECK(lookup(table, jhoyt::asl::ipv6_address{.host = "2001:db8:1::1", .port = 80}) == filter_action::allow);
+        CHECK(lookup(table, jhoyt::asl::ipv6_address{.host = "2001:db9::1", .port = 80}) == filter_action::allow);
+    }
+
+    SECTION("Default action, /0 rules and later rules")
+    {
+        const auto rules = std::vector{make_rule("192.168.0.0/16", filter_action::allow),
+                                       make_rule("::/0", filter_action::allow),
+                                       make_rule("192.168.1.0/24", filter_action::allow),
+                                       make_rule("192.168.1.0/24")};
+        const auto table = jhoyt::asl::cidr_table{rules, filter_action::deny};
+        CHECK(table.get_default_action() == filter_action::deny);
+
+        CHECK(lookup(table, jhoyt::asl::ipv4_address{.host = "8.8.8.8", .port = 80}) == filter_action::deny);
+        CHECK(lookup(table, jhoyt::asl::ipv4_address{.host = "192.168.2.1", .port = 80}) == filter_action::allow);
+        CHECK(lookup(table, jhoyt::asl::ipv4_address{.host = "192.168.1.1", .port = 80}) == filter_action::deny);
+        CHECK(lookup(table, jhoyt::asl::ipv6_address{.host = "2001:db8::1", .port = 80}) == filter_action::allow);
+    }
+
+    SECTION("IPv4-mapped addresses use the IPv4 rules")
+    {
+        const auto rules = std::vector{make_rule("203.0.113.0/24")};
+        const auto table = jhoyt::asl::cidr_table{rules};
+        CHECK(lookup(table, jhoyt::asl::ipv6_address{.host = "::ffff:203.0.113.9", .port = 80}) == filter_action::deny);
+        CHECK(lookup(table, jhoyt::asl::ipv6_address{.host = "::ffff:203.0.114.9", .port = 80}) ==
+              filter_action::allow);
+    }
+
+    SECTION("Other addresses get the default action")
+    {
+        const auto rules = std::vector{make_rule("0.0.0.0/0"), make_rule("::/0")};
+        const auto table = jhoyt::asl::cidr_table{rules, filter_action::allow};
+        CHECK(lookup(table, jhoyt::asl::file_address{.path = "./test.sock"}) == filter_action::allow);
+        CHECK(table.lookup(jhoyt::asl::raw_address{}) == filter_action::allow);
+    }
+
+    SECTION("Prefix lengths are checked")
+    {
+        auto rule = make_rule("10.0.0.0/8");
+        rule.prefix_length = 33;
+        CHECK_THROWS(jhoyt::asl::cidr_table{std::span{&rule, 1}});
+    }
+}
+
+TEST_CASE("CIDR Table Matches Linear Search")
+{
+    // Random IPv4 rules that are dense in a small range, so prefixes nest and share trie nodes, checked against a
+    // longest-prefix search over the rule list.
+    auto rng = std::mt19937{11};
+    auto rules = std::vector<jhoyt::asl::cidr_rule>{};
+    for (auto ix = 0; ix < 500; ++ix)
+    {
+        const auto host = static_cast<std::uint32_t>(0x0a000000 | (rng() & 0x00ffffff));
+        const auto length = static_cast<std::uint8_t>(8 + rng() % 25);
+        const auto bytes = jhoyt::asl::ipv4_host::bytes_type{static_cast<std::uint8_t>(host >> 24),
+                                                             static_cast<std::uint8_t>(host >> 16),
+                                                             static_cast<std::uint8_t>(host >> 8),
+                                                             static_cast<std::uint8_t>(host)};
+        rules.push_back({jhoyt::asl::ipv4_host{bytes},
+                         length,
+                         rng() % 2 == 0 ? jhoyt::asl::filter_action::allow : jhoyt::asl::filter_action::deny});
+    }
+
+    const auto table = jhoyt::asl::cidr_table{rules, jhoyt::asl::filter_action::deny};
+
+    const auto expected_action = [&](const std::uint32_t host) {
+        auto action = jhoyt::asl::filter_action::deny;
+        auto best = -1;
+        for (const auto& [network, length, rule_action] : rules)
+        {
+            const auto& bytes = std::get<jhoyt::asl::ipv4_host>(network).get_bytes();
+            const auto value = std::uint32_t{bytes[0]} << 24 | std::uint32_t{bytes[1]} << 16 |
+                               std::uint32_t{bytes[2]} << 8 | std::uint32_t{bytes[3]};
+            const auto mask = length == 0 ? std::uint32_t{0} : ~std::uint32_t{0} << (32 - length);
+            if ((host & mask) == (value & mask) && length >= best)
+            {
+                best = length;
+                action = rule_action;
+            }
+        }
+
+        return action;
+    };
+
+    for (auto ix = 0; ix < 20000; ++ix)
+    {
+        // Half of the hosts are taken from a rule, so the longest prefixes get hit as well.
+        auto host = static_cast<std::uint32_t>(0x0a000000 | (rng() & 0x00ffffff));
+        if (ix % 2 == 0)
+        {
+            const auto& bytes = std::get<jhoyt::asl::ipv4_host>(rules[rng() % rules.size()].network).get_bytes();
+            host = std::uint32_t{bytes[0]} << 24 | std::uint32_t{bytes[1]} << 16 | std::uint32_t{bytes[2]} << 8 |
+                   (std::uint32_t{bytes[3]} ^ (rng() & 0xff));
+        }
+
+        REQUIRE(table.lookup(make_ipv4(host)) == expected_action(host));
+    }
+}
+
+TEST_CASE("Address Filter Update")
+{
+    auto filter = jhoyt::asl::address_filter{};
+    const auto peer = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "198.51.100.7", .port = 80}};
+    CHECK(filter.is_allowed(peer));
+
+    const auto deny_rules = std::vector{make_rule("198.51.100.0/24")};
+    filter.update(jhoyt::asl::cidr_table{deny_rules});
+    CHECK_FALSE(filter.is_allowed(peer));
+
+    SECTION("Lookups carry on while the rules are replaced")
+    {
+        // Readers check that every answer comes from one of the two rule sets while the writer keeps swapping them.
+        auto stop = std::atomic<bool>{false};
+        auto lookups = std::atomic<std::uint64_t>{0};
+        auto mismatches = std::atomic<std::uint64_t>{0};
+        const auto other = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "192.0.2.1", .port = 80}};
+
+        auto readers = std::vector<std::thread>{};
+        for (auto ix = 0; ix < 3; ++ix)
+        {
+            readers.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    mismatches += filter.is_allowed(other) ? 0 : 1;
+                    lookups += filter.is_allowed(peer) ? 1 : 2;
+                }
+            });
+        }
+
+        const auto allow_rules = std::vector{make_rule("198.51.100.0/24", jhoyt::asl::filter_action::allow)};
+        for (auto ix = 0; ix < 2000; ++ix)
+        {
+            filter.update(jhoyt::asl::cidr_table{ix % 2 == 0 ? allow_rules : deny_rules});
+        }
+
+        stop = true;
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+
+        CHECK(mismatches == 0);
+        CHECK(lookups > 0);
+        CHECK_FALSE(filter.is_allowed(peer));
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/address_map.hpp>
+
+namespace
+{
+
+    jhoyt::asl::raw_address make_ipv4(const std::uint32_t host, const std::uint16_t port)
+    {
+        const auto bytes = jhoyt::asl::ipv4_host::bytes_type{static_cast<std::uint8_t>(host >> 24),
+                                                             static_cast<std::uint8_t>(host >> 16),
+                                                             static_cast<std::uint8_t>(host >> 8),
+                                                             static_cast<std::uint8_t>(host)};
+        return jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = jhoyt::asl::ipv4_host{bytes}, .port = port}};
+    }
+
+} // namespace
+
+TEST_CASE("Address Map Basics")
+{
+    auto map = jhoyt::asl::address_map<int>{};
+    CHECK(map.empty());
+    CHECK(map.get_capacity() >= jhoyt::asl::address_map<int>::k_default_capacity);
+
+    const auto ipv4_addr = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 80}};
+    const auto ipv6_addr = jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "::ffff:10.0.0.1", .port = 80}};
+    const auto scoped_addr =
+        jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "::ffff:10.0.0.1", .port = 80, .scope_id = 1}};
+
+    CHECK(map.find(ipv4_addr) == nullptr);
+
+    const auto [value, added] = map.try_emplace(ipv4_addr, 1);
+    CHECK(added);
+    CHECK(value == 1);
+    CHECK(map.get_size() == 1);
+
+    const auto [same_value, added_again] = map.try_emplace(ipv4_addr, 2);
+    CHECK_FALSE(added_again);
+    CHECK(same_value == 1);
+
+    map[ipv6_addr] += 10;
+    map[scoped_addr] += 20;
+    CHECK(map.get_size() == 3);
+    CHECK(*map.find(ipv4_addr) == 1);
+    CHECK(*map.find(ipv6_addr) == 10);
+    CHECK(*map.find(scoped_addr) == 20);
+
+    CHECK(map.erase(ipv6_addr));
+    CHECK_FALSE(map.erase(ipv6_addr));
+    CHECK(map.find(ipv6_addr) == nullptr);
+    CHECK(map.get_size() == 2);
+
+    auto sum = 0;
+    map.for_each([&](const int v) { sum += v; });
+    CHECK(sum == 21);
+
+    CHECK(map.erase_if([](const int v) { return v > 5; }) == 1);
+    CHECK(map.find(scoped_addr) == nullptr);
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.find(ipv4_addr) == nullptr);
+
+    SECTION("File addresses are rejected")
+    {
+        const auto file_addr = jhoyt::asl::raw_address{jhoyt::asl::file_address{.path = "./test.sock"}};
+        CHECK_THROWS(map[file_addr]);
+        CHECK_THROWS(map.find(jhoyt::asl::raw_address{}));
+    }
+
+    SECTION("Move-only values")
+    {
+        auto owners = jhoyt::asl::address_map<std::unique_ptr<std::string>>{};
+        owners.try_emplace(ipv4_addr, std::make_unique<std::string>("peer"));
+        CHECK(**owners.find(ipv4_addr) == "peer");
+    }
+}
+
+TEST_CASE("Address Map Matches std::map")
+{
+    // Random inserts and erases over a small key space, so probe sequences overlap and erasing has to shift entries
+    // back, checked against std::map after every operation.
+    auto rng = std::mt19937{7};
+    auto map = jhoyt::asl::address_map<std::uint32_t>{4};
+    auto expected = std::map<std::uint32_t, std::uint32_t>{};
+
+    for (auto step = std::uint32_t{0}; step < 20000; ++step)
+    {
+        const auto key = static_cast<std::uint32_t>(rng() % 512);
+        const auto addr = make_ipv4(0x0a000000 + key / 4, static_cast<std::uint16_t>(key % 4));
+        if (rng() % 3 == 0)
+        {
+            REQUIRE(map.erase(addr) == (expected.erase(key) == 1));
+        }
+        else
+        {
+            map[addr] = step;
+            expected[key] = step;
+        }
+
+        REQUIRE(map.get_size() == expected.size());
+        if (step % 1000 == 0)
+        {
+            for (const auto& [k, v] : expected)
+            {
+                const auto* found = map.find(make_ipv4(0x0a000000 + k / 4, static_cast<std::uint16_t>(k % 4)));
+                REQUIRE(found != nullptr);
+                REQUIRE(*found == v);
+            }
+        }
+    }
+
+    map.erase_if([](const std::uint32_t v) { return v % 2 == 0; });
+    std::erase_if(expected, [](const auto& entry) { return entry.second % 2 == 0; });
+    REQUIRE(map.get_size() == expected.size());
+    for (const auto& [k, v] : expected)
+    {
+        const auto* found = map.find(make_ipv4(0x0a000000 + k / 4, static_cast<std::uint16_t>(k % 4)));
+        REQUIRE(found != nullptr);
+        CHECK(*found == v);
+    }
+}
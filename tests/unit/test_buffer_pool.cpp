@@ -0,0 +1,43 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/buffer_pool.hpp>
+
+TEST_CASE("Buffer Pool Allocates Slabs On Demand")
+{
+    auto pool = jhoyt::asl::buffer_pool{128, 4};
+    CHECK(pool.get_buffer_size() == 128);
+    CHECK(pool.get_allocated_count() == 0);
+    CHECK(pool.get_available_count() == 0);
+
+    const auto first = pool.acquire();
+    CHECK(first.size() == 128);
+    CHECK(pool.get_allocated_count() == 4);
+    CHECK(pool.get_available_count() == 3);
+
+    const auto second = pool.acquire();
+    CHECK(second.data() == first.data() + 128);
+
+    for (auto ix = 0; ix < 3; ++ix)
+    {
+        (void)pool.acquire();
+    }
+
+    CHECK(pool.get_allocated_count() == 8);
+    CHECK(pool.get_available_count() == 3);
+}
+
+TEST_CASE("Buffer Pool Recycles Released Buffers")
+{
+    auto pool = jhoyt::asl::buffer_pool{64, 2};
+
+    const auto first = pool.acquire();
+    pool.release(first);
+    CHECK(pool.get_available_count() == 2);
+
+    const auto again = pool.acquire();
+    CHECK(again.data() == first.data());
+    CHECK(pool.get_allocated_count() == 2);
+}
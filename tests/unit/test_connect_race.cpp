@@ -0,0 +1,69 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/connect_race.hpp>
+
+namespace
+{
+
+    jhoyt::asl::raw_address v4(const std::uint16_t port)
+    {
+        return jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = port}};
+    }
+
+    jhoyt::asl::raw_address v6(const std::uint16_t port)
+    {
+        return jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "::1", .port = port}};
+    }
+
+    /// Pick candidates by index, in the order the race is expected to try them.
+    std::vector<jhoyt::asl::raw_address> pick(const std::vector<jhoyt::asl::raw_address>& candidates,
+                                              const std::initializer_list<std::size_t> indices)
+    {
+        auto picked = std::vector<jhoyt::asl::raw_address>{};
+        for (const auto ix : indices)
+        {
+            picked.push_back(candidates[ix]);
+        }
+
+        return picked;
+    }
+
+} // namespace
+
+TEST_CASE("Connect Race Candidate Ordering")
+{
+    using jhoyt::asl::detail::order_connect_candidates;
+
+    CHECK(order_connect_candidates({}, 1).empty());
+
+    SECTION("Families alternate, starting with the family of the first candidate")
+    {
+        const auto candidates = std::vector{v6(1), v6(2), v6(3), v4(4), v4(5)};
+        CHECK(order_connect_candidates(candidates, 1) == pick(candidates, {0, 3, 1, 4, 2}));
+
+        const auto reversed = std::vector{v4(4), v6(1), v4(5), v6(2)};
+        CHECK(order_connect_candidates(reversed, 1) == pick(reversed, {0, 1, 2, 3}));
+    }
+
+    SECTION("The first family count delays the other family")
+    {
+        const auto candidates = std::vector{v6(1), v6(2), v6(3), v4(4), v4(5)};
+        CHECK(order_connect_candidates(candidates, 2) == pick(candidates, {0, 1, 3, 2, 4}));
+        CHECK(order_connect_candidates(candidates, 0) == pick(candidates, {0, 3, 1, 4, 2}));
+        CHECK(order_connect_candidates(candidates, 9) == pick(candidates, {0, 1, 2, 3, 4}));
+    }
+
+    SECTION("A single family keeps its order")
+    {
+        const auto candidates = std::vector{v4(3), v4(1), v4(2)};
+        CHECK(order_connect_candidates(candidates, 1) == candidates);
+    }
+}
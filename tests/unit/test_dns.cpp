@@ -0,0 +1,272 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/dns.hpp>
+
+namespace
+{
+    using jhoyt::asl::detail::dns_record_type;
+    using jhoyt::asl::detail::dns_response_code;
+
+    /// Type that builds DNS messages field by field.
+    class message_builder
+    {
+    public:
+        message_builder& u8(const std::uint8_t value)
+        {
+            data_.push_back(static_cast<char>(value));
+            return *this;
+        }
+
+        message_builder& u16(const std::uint16_t value)
+        {
+            return u8(static_cast<std::uint8_t>(value >> 8)).u8(static_cast<std::uint8_t>(value));
+        }
+
+        message_builder& u32(const std::uint32_t value)
+        {
+            return u16(static_cast<std::uint16_t>(value >> 16)).u16(static_cast<std::uint16_t>(value));
+        }
+
+        message_builder& name(std::string_view text)
+        {
+            while (!text.empty())
+            {
+                const auto label = text.substr(0, text.find('.'));
+                u8(static_cast<std::uint8_t>(label.size()));
+                data_.insert(data_.end(), label.begin(), label.end());
+                text.remove_prefix(std::min(label.size() + 1, text.size()));
+            }
+
+            return u8(0);
+        }
+
+        message_builder& pointer(const std::uint16_t offset)
+        {
+            return u16(static_cast<std::uint16_t>(0xc000 | offset));
+        }
+
+        /// Start a response to a query for a name, with the question at offset 12.
+        message_builder& response(const std::uint16_t id,
+                                  const std::string_view question,
+                                  const dns_record_type type,
+                                  const std::uint16_t flags,
+                                  const std::uint16_t answers,
+                                  const std::uint16_t authorities = 0)
+        {
+            u16(id).u16(flags).u16(1).u16(answers).u16(authorities).u16(0);
+            return name(question).u16(static_cast<std::uint16_t>(type)).u16(1);
+        }
+
+        /// Add the fixed fields of a record of the internet class.
+        message_builder& record(const dns_record_type type, const std::uint32_t ttl, const std::uint16_t data_size)
+        {
+            return u16(static_cast<std::uint16_t>(type)).u16(1).u32(ttl).u16(data_size);
+        }
+
+        [[nodiscard]] std::size_t get_size() const
+        {
+            return data_.size();
+        }
+
+        [[nodiscard]] const std::vector<char>& get_data() const
+        {
+            return data_;
+        }
+
+    private:
+        std::vector<char> data_;
+    };
+
+    constexpr auto k_answer = std::uint16_t{0x8180};
+
+    std::optional<jhoyt::asl::detail::dns_response> parse(const message_builder& builder,
+                                                          const std::string_view name = "www.example.com",
+                                                          const dns_record_type type = dns_record_type::a,
+                                                          const std::uint16_t id = 0x4242)
+    {
+        return jhoyt::asl::detail::parse_dns_response(builder.get_data(), id, name, type);
+    }
+
+} // namespace
+
+TEST_CASE("DNS Query Encoding")
+{
+    auto buf = std::array<char, jhoyt::asl::detail::k_max_dns_message_size>{};
+
+    const auto size = jhoyt::asl::detail::write_dns_query("Example.COM.", 0x1234, dns_record_type::aaaa, buf);
+    const auto expected = message_builder{}
+                              .u16(0x1234)
+                              .u16(0x0100)
+                              .u16(1)
+                              .u16(0)
+                              .u16(0)
+                              .u16(0)
+                              .name("Example.COM")
+                              .u16(28)
+                              .u16(1)
+                              .get_data();
+    REQUIRE(size == expected.size());
+    CHECK(std::string_view{buf.data(), size} == std::string_view{expected.data(), expected.size()});
+
+    CHECK(jhoyt::asl::detail::write_dns_query("", 1, dns_record_type::a, buf) == 0);
+    CHECK(jhoyt::asl::detail::write_dns_query(".", 1, dns_record_type::a, buf) == 0);
+    CHECK(jhoyt::asl::detail::write_dns_query("a..b", 1, dns_record_type::a, buf) == 0);
+    CHECK(jhoyt::asl::detail::write_dns_query(std::string(64, 'a') + ".com", 1, dns_record_type::a, buf) == 0);
+    CHECK(jhoyt::asl::detail::write_dns_query(std::string(63, 'a') + ".com", 1, dns_record_type::a, buf) > 0);
+
+    auto long_name = std::string{};
+    for (auto ix = 0; ix < 64; ++ix)
+    {
+        long_name += "abc.";
+    }
+
+    CHECK(jhoyt::asl::detail::is_valid_dns_name(long_name.substr(0, 253)));
+    CHECK_FALSE(jhoyt::asl::detail::is_valid_dns_name(long_name.substr(0, 254) + "x"));
+    CHECK(jhoyt::asl::detail::normalize_dns_name("WWW.Example.com.") == "www.example.com");
+}
+
+TEST_CASE("DNS Response Parsing")
+{
+    SECTION("Addresses and the smallest TTL")
+    {
+        auto builder = message_builder{};
+        builder.response(0x4242, "WWW.example.com", dns_record_type::a, k_answer, 3);
+        builder.pointer(12).record(dns_record_type::a, 300, 4).u32(0xc0000201);
+        builder.pointer(12).record(dns_record_type::a, 60, 4).u32(0xc0000202);
+        builder.pointer(12).record(dns_record_type::aaaa, 10, 16).u32(0).u32(0).u32(0).u32(1);
+
+        const auto response = parse(builder);
+        REQUIRE(response);
+        CHECK(response->code == dns_response_code::no_error);
+        CHECK_FALSE(response->truncated);
+        REQUIRE(response->hosts.size() == 2);
+        CHECK(std::get<jhoyt::asl::ipv4_host>(response->hosts[0]) == jhoyt::asl::ipv4_host{"192.0.2.1"});
+        CHECK(std::get<jhoyt::asl::ipv4_host>(response->hosts[1]) == jhoyt::asl::ipv4_host{"192.0.2.2"});
+        CHECK(response->ttl == 60);
+    }
+
+    SECTION("CNAME chains are followed")
+    {
+        auto builder = message_builder{};
+        builder.response(0x4242, "www.example.com", dns_record_type::aaaa, k_answer, 3);
+        builder.name("other.test").record(dns_record_type::aaaa, 5, 16).u32(0).u32(0).u32(0).u32(2);
+
+        const auto alias_offset = static_cast<std::uint16_t>(builder.get_size() + 12);
+        builder.pointer(12).record(dns_record_type::cname, 100, 7).u8(4).u8('e').u8('d').u8('g').u8('e').pointer(16);
+        builder.pointer(alias_offset).record(dns_record_type::aaaa, 200, 16).u32(0x20010db8).u32(0).u32(0).u32(1);
+
+        const auto response = parse(builder, "www.example.com", dns_record_type::aaaa);
+        REQUIRE(response);
+        REQUIRE(response->hosts.size() == 1);
+        CHECK(std::get<jhoyt::asl::ipv6_host>(response->hosts[0]) == jhoyt::asl::ipv6_host{"2001:db8::1"});
+        CHECK(response->ttl == 100);
+    }
+
+    SECTION("Negative answers take their TTL from the SOA record")
+    {
+        auto builder = message_builder{};
+        builder.response(0x4242, "www.example.com", dns_record_type::a, k_answer | 3, 0, 1);
+        builder.pointer(16).record(dns_record_type::soa, 900, 31).name("ns").name("admin");
+        builder.u32(1).u32(2).u32(3).u32(4).u32(60);
+
+        const auto response = parse(builder);
+        REQUIRE(response);
+        CHECK(response->code == dns_response_code::name_error);
+        CHECK(response->hosts.empty());
+        CHECK(response->ttl == 60);
+    }
+
+    SECTION("Truncated responses keep the records that fit")
+    {
+        auto builder = message_builder{};
+        builder.response(0x4242, "www.example.com", dns_record_type::a, k_answer | 0x0200, 2);
+        builder.pointer(12).record(dns_record_type::a, 30, 4).u32(0xc0000201);
+        builder.pointer(12).record(dns_record_type::a, 30, 4).u8(192);
+
+        const auto response = parse(builder);
+        REQUIRE(response);
+        CHECK(response->truncated);
+        CHECK(response->hosts.size() == 1);
+    }
+
+    SECTION("Anything but the response to the query is rejected")
+    {
+        auto builder = message_builder{};
+        builder.response(0x4242, "www.example.com", dns_record_type::a, k_answer, 1);
+        builder.pointer(12).record(dns_record_type::a, 30, 4).u32(0xc0000201);
+        REQUIRE(parse(builder));
+
+        CHECK_FALSE(parse(builder, "www.example.com", dns_record_type::a, 0x4243));
+        CHECK_FALSE(parse(builder, "mail.example.com"));
+        CHECK_FALSE(parse(builder, "www.example.com", dns_record_type::aaaa));
+
+        auto query = message_builder{};
+        query.response(0x4242, "www.example.com", dns_record_type::a, 0x0100, 0);
+        CHECK_FALSE(parse(query));
+
+        auto cut = message_builder{};
+        cut.response(0x4242, "www.example.com", dns_record_type::a, k_answer, 1);
+        cut.pointer(12).record(dns_record_type::a, 30, 4).u16(0);
+        CHECK_FALSE(parse(cut));
+
+        auto loop = message_builder{};
+        loop.response(0x4242, "www.example.com", dns_record_type::a, k_answer, 1);
+        loop.pointer(static_cast<std::uint16_t>(loop.get_size())).record(dns_record_type::a, 30, 4).u32(0);
+        CHECK_FALSE(parse(loop));
+
+        CHECK_FALSE(jhoyt::asl::detail::parse_dns_response({}, 0, "www.example.com", dns_record_type::a));
+    }
+}
+
+TEST_CASE("Hosts File Parsing")
+{
+    const auto hosts = jhoyt::asl::detail::parse_hosts_file("# The following lines are desirable\n"
+                                                            "127.0.0.1\tlocalhost\n"
+                                                            "::1 localhost ip6-localhost # loopback\n"
+                                                            "10.0.0.5 DB.internal db db\n"
+                                                            "10.0.0.6 db.internal.\n"
+                                                            "fe80::1%eth0 link\n"
+                                                            "not-an-address broken\n"
+                                                            "   \n"
+                                                            "10.0.0.7");
+
+    REQUIRE(hosts.size() == 4);
+    CHECK(hosts.at("localhost").size() == 2);
+    CHECK(std::get<jhoyt::asl::ipv4_host>(hosts.at("localhost")[0]) == jhoyt::asl::ipv4_host{"127.0.0.1"});
+    CHECK(std::get<jhoyt::asl::ipv6_host>(hosts.at("localhost")[1]) == jhoyt::asl::ipv6_host{"::1"});
+    CHECK(hosts.at("ip6-localhost").size() == 1);
+    CHECK(hosts.at("db").size() == 1);
+
+    const auto& db = hosts.at("db.internal");
+    REQUIRE(db.size() == 2);
+    CHECK(std::get<jhoyt::asl::ipv4_host>(db[0]) == jhoyt::asl::ipv4_host{"10.0.0.5"});
+    CHECK(std::get<jhoyt::asl::ipv4_host>(db[1]) == jhoyt::asl::ipv4_host{"10.0.0.6"});
+}
+
+TEST_CASE("Resolv Conf Parsing")
+{
+    const auto ipv4 = jhoyt::asl::detail::parse_resolv_conf("; generated\n"
+                                                            "search example.com\n"
+                                                            "nameserver fe80::1%eth0\n"
+                                                            "nameserver 10.0.0.2 # primary\n"
+                                                            "nameserver 10.0.0.3\n");
+    REQUIRE(ipv4);
+    CHECK(*ipv4 == jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "10.0.0.2", .port = 53}});
+
+    const auto ipv6 = jhoyt::asl::detail::parse_resolv_conf("nameserver ::1");
+    REQUIRE(ipv6);
+    CHECK(*ipv6 == jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "::1", .port = 53}});
+
+    CHECK_FALSE(jhoyt::asl::detail::parse_resolv_conf("search example.com\n#nameserver 10.0.0.1\n"));
+}
@@ -0,0 +1,301 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <chrono>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/event_loop.hpp>
+#include <jhoyt/asl/mocks/poller_mock.hpp>
+
+namespace
+{
+
+    struct recording_handler
+    {
+        std::vector<jhoyt::asl::poller::poll_result> results;
+
+        void on_poll(const jhoyt::asl::socket_id id, const jhoyt::asl::poller::poll_status status)
+        {
+            results.push_back({id, status});
+        }
+    };
+
+    struct recording_timer : jhoyt::asl::timer
+    {
+        std::vector<int>& order;
+        int value;
+
+        recording_timer(std::vector<int>& order, const int value)
+            : timer{&recording_timer::expired}, order(order), value(value)
+        {
+        }
+
+        static void expired(timer& self)
+        {
+            auto& t = static_cast<recording_timer&>(self);
+            t.order.push_back(t.value);
+        }
+    };
+
+    /// Timer that schedules itself again, already due, every time it expires.
+    struct rescheduling_timer : jhoyt::asl::timer
+    {
+        jhoyt::asl::event_loop& loop;
+        int count = 0;
+
+        explicit rescheduling_timer(jhoyt::asl::event_loop& loop) : timer{&rescheduling_timer::expired}, loop(loop)
+        {
+        }
+
+        static void expired(timer& self)
+        {
+            auto& t = static_cast<rescheduling_timer&>(self);
+            ++t.count;
+            t.loop.schedule(t, std::chrono::steady_clock::time_point{});
+        }
+    };
+
+    struct counting_task : jhoyt::asl::posted_task
+    {
+        int count = 0;
+
+        counting_task() : posted_task{&counting_task::increment}
+        {
+        }
+
+        static void increment(posted_task& self)
+        {
+            ++static_cast<counting_task&>(self).count;
+        }
+    };
+
+} // namespace
+
+TEST_CASE("Event Loop Handlers")
+{
+    jhoyt::asl::mock::poller_reset();
+
+    auto loop = jhoyt::asl::event_loop{};
+    auto handler = recording_handler{};
+    loop.add_socket(5, jhoyt::asl::poller::poll_type::read, handler);
+    CHECK(loop.has_work());
+
+    jhoyt::asl::mock::poller_enqueue_poll_result({5, jhoyt::asl::poller::poll_status::ready_to_read});
+    jhoyt::asl::mock::poller_enqueue_poll_result({6, jhoyt::asl::poller::poll_status::ready_to_read});
+    CHECK(loop.run_once(std::chrono::milliseconds{0}) == 1);
+
+    REQUIRE(jhoyt::asl::mock::poller_get_add_socket_calls().size() == 1);
+    CHECK(jhoyt::asl::mock::poller_get_add_socket_calls()[0].arg_id == 5);
+    REQUIRE(handler.results.size() == 1);
+    CHECK(handler.results[0].id == 5);
+    CHECK(handler.results[0].status == jhoyt::asl::poller::poll_status::ready_to_read);
+
+    loop.update_socket(5, jhoyt::asl::poller::poll_type::read_write);
+    loop.run_once(std::chrono::milliseconds{0});
+    REQUIRE(jhoyt::asl::mock::poller_get_update_socket_calls().size() == 1);
+    CHECK(jhoyt::asl::mock::poller_get_update_socket_calls()[0].arg_type ==
+          jhoyt::asl::poller::poll_type::read_write);
+
+    loop.remove_socket(5);
+    CHECK(jhoyt::asl::mock::poller_get_remove_socket_calls().size() == 1);
+    CHECK(!loop.has_work());
+
+    const auto stats = loop.get_stats();
+    CHECK(stats.iterations == 2);
+    CHECK(stats.events == 2);
+    CHECK(stats.max_latency >= stats.last_latency);
+
+    jhoyt::asl::mock::poller_reset();
+}
+
+TEST_CASE("Event Loop Edge Triggered Handlers")
+{
+    jhoyt::asl::mock::poller_reset();
+
+    auto loop = jhoyt::asl::event_loop{};
+    auto handler = recording_handler{};
+    loop.add_socket(5, jhoyt::asl::poller::poll_type::read, handler, jhoyt::asl::poller::trigger_mode::edge);
+
+    // Re-arming before the socket has been added to the poller is not needed.
+    loop.rearm_socket(5);
+    CHECK(jhoyt::asl::mock::poller_get_rearm_socket_calls().empty());
+
+    loop.run_once(std::chrono::milliseconds{0});
+    REQUIRE(jhoyt::asl::mock::poller_get_add_socket_calls().size() == 1);
+    CHECK(jhoyt::asl::mock::poller_get_add_socket_calls()[0].arg_mode == jhoyt::asl::poller::trigger_mode::edge);
+
+    loop.rearm_socket(5);
+    REQUIRE(jhoyt::asl::mock::poller_get_rearm_socket_calls().size() == 1);
+    CHECK(jhoyt::asl::mock::poller_get_rearm_socket_calls()[0].arg_id == 5);
+
+    loop.remove_socket(5);
+    jhoyt::asl::mock::poller_reset();
+}
+
+TEST_CASE("Event Loop Timers")
+{
+    jhoyt::asl::mock::poller_reset();
+
+    auto loop = jhoyt::asl::event_loop{};
+    auto order = std::vector<int>{};
+    auto first = recording_timer{order, 1};
+    auto second = recording_timer{order, 2};
+    auto third = recording_timer{order, 3};
+
+    const auto now = std::chrono::steady_clock::now();
+    loop.schedule(third, now - std::chrono::milliseconds{1});
+    loop.schedule(first, now - std::chrono::milliseconds{3});
+    loop.schedule(second, now - std::chrono::milliseconds{2});
+    CHECK(second.is_scheduled());
+
+    SECTION("Expire in deadline order")
+    {
+        CHECK(loop.run_once(std::chrono::milliseconds{0}) == 3);
+        CHECK(order == std::vector{1, 2, 3});
+        CHECK(!first.is_scheduled());
+        CHECK(!loop.has_work());
+        CHECK(loop.get_stats().timers == 3);
+    }
+
+    SECTION("Cancelled timers do not expire")
+    {
+        loop.cancel(second);
+        CHECK(!second.is_scheduled());
+        loop.schedule_after(first, std::chrono::hours{1});
+
+        CHECK(loop.run_once(std::chrono::milliseconds{0}) == 1);
+        CHECK(order == std::vector{3});
+        CHECK(first.is_scheduled());
+        loop.cancel(first);
+    }
+
+    SECTION("Poll timeout is limited by the next deadline")
+    {
+        loop.cancel(first);
+        loop.cancel(second);
+        loop.cancel(third);
+        loop.schedule_after(first, std::chrono::milliseconds{20});
+
+        loop.run_once(std::chrono::seconds{10});
+        REQUIRE(jhoyt::asl::mock::poller_get_poll_calls().size() == 1);
+        CHECK(jhoyt::asl::mock::poller_get_poll_calls()[0].arg_timeout <= std::chrono::milliseconds{20});
+        loop.cancel(first);
+    }
+
+    jhoyt::asl::mock::poller_reset();
+}
+
+TEST_CASE("Event Loop Leaves Timers Scheduled While Expiring For The Next Iteration")
+{
+    jhoyt::asl::mock::poller_reset();
+
+    auto loop = jhoyt::asl::event_loop{};
+    auto order = std::vector<int>{};
+    auto repeating = rescheduling_timer{loop};
+    auto later = recording_timer{order, 1};
+    loop.schedule(repeating, std::chrono::steady_clock::time_point{});
+    loop.schedule(later, std::chrono::steady_clock::now() - std::chrono::milliseconds{1});
+
+    // The repeating timer expires once per iteration, and rescheduling it does not hold back the other timer.
+    CHECK(loop.run_once(std::chrono::milliseconds{0}) == 2);
+    CHECK(repeating.count == 1);
+    CHECK(order == std::vector{1});
+    CHECK(repeating.is_scheduled());
+
+    CHECK(loop.run_once(std::chrono::milliseconds{0}) == 1);
+    CHECK(repeating.count == 2);
+    loop.cancel(repeating);
+
+    jhoyt::asl::mock::poller_reset();
+}
+
+TEST_CASE("Event Loop Posted Tasks")
+{
+    jhoyt::asl::mock::poller_reset();
+
+    auto loop = jhoyt::asl::event_loop{};
+    auto first = counting_task{};
+    auto second = counting_task{};
+    loop.post(first);
+    loop.post(second);
+    CHECK(loop.has_work());
+
+    loop.run();
+    CHECK(first.count == 1);
+    CHECK(second.count == 1);
+    REQUIRE(jhoyt::asl::mock::poller_get_poll_calls().size() == 1);
+    CHECK(jhoyt::asl::mock::poller_get_poll_calls()[0].arg_timeout == std::chrono::nanoseconds::zero());
+    CHECK(loop.get_stats().tasks == 2);
+
+    jhoyt::asl::mock::poller_reset();
+}
+
+TEST_CASE("Event Loop Spins Before Blocking")
+{
+    jhoyt::asl::mock::poller_reset();
+
+    auto loop = jhoyt::asl::event_loop{};
+    CHECK(loop.get_spin_budget() == std::chrono::nanoseconds::zero());
+    loop.set_spin_options(jhoyt::asl::event_loop::spin_options{.max_budget = std::chrono::milliseconds{1}});
+    CHECK(loop.get_spin_budget() == std::chrono::milliseconds{1});
+
+    // Nothing becomes ready while spinning, so the loop ends up blocking for the rest of the timeout.
+    loop.run_once(std::chrono::milliseconds{5});
+    auto calls = jhoyt::asl::mock::poller_get_poll_calls();
+    REQUIRE(calls.size() >= 2);
+    CHECK(calls.front().arg_timeout == std::chrono::nanoseconds::zero());
+    CHECK(calls.back().arg_timeout > std::chrono::nanoseconds::zero());
+    CHECK(calls.back().arg_timeout <= std::chrono::milliseconds{4});
+    CHECK(loop.get_stats().spin_time >= std::chrono::milliseconds{1});
+    CHECK(loop.get_stats().spin_hits == 0);
+
+    loop.set_spin_options(jhoyt::asl::event_loop::spin_options{.max_budget = std::chrono::milliseconds{1}});
+    loop.reset_stats();
+    jhoyt::asl::mock::poller_reset();
+
+    jhoyt::asl::mock::poller_enqueue_poll_result({5, jhoyt::asl::poller::poll_status::ready_to_read});
+    loop.run_once(std::chrono::milliseconds{5});
+    calls = jhoyt::asl::mock::poller_get_poll_calls();
+    REQUIRE(calls.size() == 1);
+    CHECK(calls[0].arg_timeout == std::chrono::nanoseconds::zero());
+    CHECK(loop.get_stats().spin_hits == 1);
+    CHECK(loop.get_stats().blocked_time == std::chrono::nanoseconds::zero());
+
+    // An event found straight away shrinks the budget towards twice the (short) average wait.
+    CHECK(loop.get_spin_budget() < std::chrono::milliseconds{1});
+
+    loop.set_spin_options(std::nullopt);
+    CHECK(loop.get_spin_budget() == std::chrono::nanoseconds::zero());
+
+    jhoyt::asl::mock::poller_reset();
+}
+
+TEST_CASE("Event Loop Stop")
+{
+    jhoyt::asl::mock::poller_reset();
+
+    struct stopping_task : jhoyt::asl::posted_task
+    {
+        jhoyt::asl::event_loop* loop;
+        int count = 0;
+
+        static void run_task(posted_task& self)
+        {
+            auto& task = static_cast<stopping_task&>(self);
+            ++task.count;
+            task.loop->post(task);
+            task.loop->stop();
+        }
+    };
+
+    auto loop = jhoyt::asl::event_loop{};
+    auto task = stopping_task{{&stopping_task::run_task}, &loop};
+    loop.post(task);
+    loop.run();
+    CHECK(task.count == 1);
+    CHECK(loop.has_work());
+
+    jhoyt::asl::mock::poller_reset();
+}
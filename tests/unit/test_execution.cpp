@@ -0,0 +1,138 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/execution.hpp>
+#include <jhoyt/asl/mocks/poller_mock.hpp>
+#include <jhoyt/asl/mocks/socket_mock.hpp>
+
+namespace
+{
+
+    void reset_mocks()
+    {
+        jhoyt::asl::mock::poller_reset();
+        jhoyt::asl::mock::socket_reset();
+    }
+
+} // namespace
+
+TEST_CASE("Execution Schedule Sender")
+{
+    reset_mocks();
+
+    auto loop = jhoyt::asl::event_loop{};
+    const auto sched = jhoyt::asl::loop_scheduler{loop};
+    CHECK(&sched.get_loop() == &loop);
+    CHECK(sched == jhoyt::asl::loop_scheduler{loop});
+
+    auto result = std::optional<int>{};
+    stdexec::start_detached(sched.schedule() | stdexec::then([] { return 1; }) |
+                            stdexec::then([&](const int value) { result = value + 1; }));
+
+    // Scheduling completes on the loop, not inline.
+    CHECK(!result);
+    CHECK(loop.has_work());
+
+    loop.run();
+    CHECK(result == 2);
+    CHECK(stdexec::get_completion_scheduler<stdexec::set_value_t>(stdexec::get_env(sched.schedule())) == sched);
+
+    reset_mocks();
+}
+
+TEST_CASE("Execution IO Senders")
+{
+    reset_mocks();
+
+    auto loop = jhoyt::asl::event_loop{};
+    const auto sched = jhoyt::asl::loop_scheduler{loop};
+    auto sock = jhoyt::asl::socket{5};
+    auto buffer = std::array<char, 16>{};
+
+    SECTION("Receiving waits on the loop when it would block")
+    {
+        jhoyt::asl::mock::socket_add_recv_result({jhoyt::asl::socket::transfer_status::blocked, 0});
+        jhoyt::asl::mock::socket_add_recv_result({jhoyt::asl::socket::transfer_status::success, 3});
+
+        auto received = std::optional<size_t>{};
+        stdexec::start_detached(sched.recv(sock, buffer) |
+                                stdexec::then([&](const jhoyt::asl::socket::transfer_status status, const size_t size) {
+                                    CHECK(status == jhoyt::asl::socket::transfer_status::success);
+                                    received = size;
+                                }));
+
+        CHECK(jhoyt::asl::mock::socket_get_recv_calls().size() == 1);
+        CHECK(!received);
+        CHECK(loop.has_work());
+
+        jhoyt::asl::mock::poller_enqueue_poll_result({5, jhoyt::asl::poller::poll_status::ready_to_read});
+        loop.run_once(std::chrono::milliseconds{0});
+        CHECK(jhoyt::asl::mock::socket_get_recv_calls().size() == 2);
+        CHECK(received == 3);
+        CHECK(!loop.has_work());
+    }
+
+    SECTION("A throwing socket function completes with the error")
+    {
+        jhoyt::asl::mock::socket_set_recv_throws(true);
+
+        auto failed = false;
+        stdexec::start_detached(sched.recv(sock, buffer) | stdexec::then([](auto, auto) { FAIL(); }) |
+                                stdexec::upon_error([&](const std::exception_ptr&) { failed = true; }));
+        CHECK(failed);
+        CHECK(!loop.has_work());
+    }
+
+    SECTION("Accepting composes with let_value")
+    {
+        auto incoming = jhoyt::asl::socket{};
+        auto addr = jhoyt::asl::raw_address{};
+        jhoyt::asl::mock::socket_add_accept_result(false);
+        jhoyt::asl::mock::socket_add_accept_result(true);
+        jhoyt::asl::mock::socket_add_send_result({jhoyt::asl::socket::transfer_status::success, 4});
+
+        auto sent = std::optional<size_t>{};
+        stdexec::start_detached(
+            sched.accept(sock, incoming, addr) |
+            stdexec::let_value([&] { return sched.send(incoming, std::span<const char>{"ping", 4}); }) |
+            stdexec::then([&](jhoyt::asl::socket::transfer_status, const size_t size) { sent = size; }));
+        CHECK(!sent);
+
+        jhoyt::asl::mock::poller_enqueue_poll_result({5, jhoyt::asl::poller::poll_status::ready_to_read});
+        loop.run_once(std::chrono::milliseconds{0});
+        CHECK(jhoyt::asl::mock::socket_get_accept_calls().size() == 2);
+        CHECK(jhoyt::asl::mock::socket_get_send_calls().size() == 1);
+        CHECK(sent == 4);
+    }
+
+    SECTION("Connecting composes with when_all")
+    {
+        const auto addr = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
+
+        auto result = std::optional<bool>{};
+        stdexec::start_detached(stdexec::when_all(sched.connect(sock, addr), sched.schedule()) |
+                                stdexec::then([&](const bool connected) { result = connected; }));
+        REQUIRE(jhoyt::asl::mock::socket_get_connect_calls().size() == 1);
+        CHECK(jhoyt::asl::mock::socket_get_connect_calls()[0].arg_addr == addr);
+
+        // The schedule sender completes on this iteration; the connection is still pending.
+        loop.run_once(std::chrono::milliseconds{0});
+        CHECK(!result);
+
+        jhoyt::asl::mock::poller_enqueue_poll_result({5, jhoyt::asl::poller::poll_status::connection_succeeded});
+        loop.run_once(std::chrono::milliseconds{0});
+        CHECK(result == true);
+        CHECK(!loop.has_work());
+    }
+
+    reset_mocks();
+}
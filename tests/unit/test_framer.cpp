@@ -0,0 +1,158 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <cstring>
+#include <string_view>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/framer.hpp>
+#include <jhoyt/asl/recv_buffer.hpp>
+
+namespace
+{
+
+    constexpr auto k_too_large_payload =
+        "This payload is longer than the maximum payload size configured for the framer under test, so it must be "
+        "rejected rather than waited for.";
+
+    template <typename Header>
+    auto append_frame(jhoyt::asl::recv_buffer& buf, const std::string_view payload)
+    {
+        auto out = buf.get_writable(Header::k_max_size + payload.size());
+        const auto header_size = jhoyt::asl::framer<Header>::encode_header(payload.size(), out);
+        memcpy(out.data() + header_size, payload.data(), payload.size());
+        buf.commit(header_size + payload.size());
+    }
+
+    auto to_string_view(const std::span<const char> data)
+    {
+        return std::string_view{data.data(), data.size()};
+    }
+
+} // namespace
+
+TEST_CASE("Varint Header")
+{
+    using jhoyt::asl::frame_status;
+    using jhoyt::asl::varint_header;
+
+    auto buf = std::array<char, varint_header::k_max_size>{};
+
+    CHECK(varint_header::encode(0, buf) == 1);
+    CHECK(varint_header::decode({buf.data(), 1}).payload_size == 0);
+
+    CHECK(varint_header::encode(300, buf) == 2);
+    CHECK(static_cast<unsigned char>(buf[0]) == 0xac);
+    CHECK(static_cast<unsigned char>(buf[1]) == 0x02);
+    const auto result = varint_header::decode({buf.data(), 2});
+    CHECK(result.status == frame_status::complete);
+    CHECK(result.header_size == 2);
+    CHECK(result.payload_size == 300);
+
+    CHECK(varint_header::decode({buf.data(), 1}).status == frame_status::incomplete);
+
+    buf.fill(static_cast<char>(0xff));
+    CHECK(varint_header::decode(buf).status == frame_status::malformed);
+}
+
+TEST_CASE("Fixed Headers")
+{
+    using jhoyt::asl::frame_status;
+
+    auto buf = std::array<char, 4>{};
+
+    CHECK(jhoyt::asl::u16_be_header::encode(0x0102, buf) == 2);
+    CHECK(buf[0] == 0x01);
+    CHECK(buf[1] == 0x02);
+    CHECK(jhoyt::asl::u16_be_header::decode(buf).payload_size == 0x0102);
+
+    CHECK(jhoyt::asl::u16_le_header::encode(0x0102, buf) == 2);
+    CHECK(buf[0] == 0x02);
+    CHECK(buf[1] == 0x01);
+    CHECK(jhoyt::asl::u16_le_header::decode(buf).payload_size == 0x0102);
+
+    CHECK(jhoyt::asl::u32_be_header::encode(0x01020304, buf) == 4);
+    CHECK(buf[0] == 0x01);
+    CHECK(buf[3] == 0x04);
+    CHECK(jhoyt::asl::u32_be_header::decode(buf).payload_size == 0x01020304);
+
+    CHECK(jhoyt::asl::u32_le_header::encode(0x01020304, buf) == 4);
+    CHECK(buf[0] == 0x04);
+    CHECK(buf[3] == 0x01);
+    CHECK(jhoyt::asl::u32_le_header::decode(buf).payload_size == 0x01020304);
+
+    CHECK(jhoyt::asl::u32_be_header::decode({buf.data(), 3}).status == frame_status::incomplete);
+}
+
+TEST_CASE("Framer")
+{
+    using jhoyt::asl::frame_status;
+
+    auto buf = jhoyt::asl::recv_buffer{16};
+    const auto framer = jhoyt::asl::framer<jhoyt::asl::u16_be_header>{64};
+
+    CHECK(framer.next(buf.get_readable()).status == frame_status::incomplete);
+
+    append_frame<jhoyt::asl::u16_be_header>(buf, "Hello");
+    append_frame<jhoyt::asl::u16_be_header>(buf, "world");
+
+    SECTION("Frames are views into the buffer")
+    {
+        const auto readable = buf.get_readable();
+
+        const auto first = framer.next(readable);
+        REQUIRE(first.status == frame_status::complete);
+        CHECK(to_string_view(first.payload) == "Hello");
+        CHECK(first.payload.data() == readable.data() + 2);
+        CHECK(first.size == 7);
+        buf.consume(first.size);
+
+        const auto second = framer.next(buf.get_readable());
+        REQUIRE(second.status == frame_status::complete);
+        CHECK(to_string_view(second.payload) == "world");
+        buf.consume(second.size);
+
+        CHECK(buf.get_readable().empty());
+    }
+
+    SECTION("Partial frame")
+    {
+        const auto readable = buf.get_readable();
+        CHECK(framer.next(readable.first(4)).status == frame_status::incomplete);
+        CHECK(framer.next(readable.first(1)).status == frame_status::incomplete);
+    }
+
+    SECTION("Oversized frame")
+    {
+        buf.clear();
+        append_frame<jhoyt::asl::u16_be_header>(buf, std::string_view{k_too_large_payload});
+        CHECK(framer.next(buf.get_readable()).status == frame_status::too_large);
+    }
+}
+
+TEST_CASE("Receive Buffer")
+{
+    auto buf = jhoyt::asl::recv_buffer{8};
+    CHECK(buf.get_readable().empty());
+
+    auto out = buf.get_writable(4);
+    CHECK(out.size() >= 4);
+    memcpy(out.data(), "abcd", 4);
+    buf.commit(4);
+    CHECK(to_string_view(buf.get_readable()) == "abcd");
+
+    buf.consume(2);
+    CHECK(to_string_view(buf.get_readable()) == "cd");
+
+    out = buf.get_writable(7);
+    CHECK(out.size() >= 7);
+    CHECK(to_string_view(buf.get_readable()) == "cd");
+    memcpy(out.data(), "efghijk", 7);
+    buf.commit(7);
+    CHECK(to_string_view(buf.get_readable()) == "cdefghijk");
+
+    buf.consume(9);
+    CHECK(buf.get_readable().empty());
+}
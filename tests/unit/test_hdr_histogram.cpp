@@ -0,0 +1,145 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <cstdint>
+#include <stdexcept>
+
+#include <catch.hpp>
+
+#include "hdr_histogram.hpp"
+
+namespace
+{
+
+    /// A minute in nanoseconds, the range asl_loadgen records latencies in.
+    constexpr auto k_highest_value = std::int64_t{60'000'000'000};
+
+} // namespace
+
+TEST_CASE("HDR Histogram Construction")
+{
+    CHECK_THROWS_AS(jhoyt::asl::loadgen::hdr_histogram(k_highest_value, 0), std::invalid_argument);
+    CHECK_THROWS_AS(jhoyt::asl::loadgen::hdr_histogram(k_highest_value, 6), std::invalid_argument);
+    CHECK_THROWS_AS(jhoyt::asl::loadgen::hdr_histogram(1, 3), std::invalid_argument);
+
+    const auto histogram = jhoyt::asl::loadgen::hdr_histogram{k_highest_value, 3};
+    CHECK(histogram.get_total_count() == 0);
+    CHECK(histogram.get_max() == 0);
+    CHECK(histogram.get_value_at_percentile(50.0) == 0);
+}
+
+TEST_CASE("HDR Histogram Buckets")
+{
+    SECTION("Values within the first bucket are exact")
+    {
+        // Three significant digits need 2048 sub-buckets, so every value below 2048 has its own counter.
+        auto histogram = jhoyt::asl::loadgen::hdr_histogram{k_highest_value, 3};
+        for (auto value = std::int64_t{1}; value <= 2047; ++value)
+        {
+            histogram.record(value);
+        }
+
+        CHECK(histogram.get_total_count() == 2047);
+        CHECK(histogram.get_value_at_percentile(0.0) == 1);
+        CHECK(histogram.get_value_at_percentile(50.0) == 1024);
+        CHECK(histogram.get_value_at_percentile(100.0) == 2047);
+    }
+
+    SECTION("Larger values keep the requested precision")
+    {
+        for (const auto value : {std::int64_t{2048},
+                                 std::int64_t{4095},
+                                 std::int64_t{10000},
+                                 std::int64_t{123456},
+                                 std::int64_t{98765432},
+                                 k_highest_value - 1})
+        {
+            // Recording a larger value as well keeps the result from being capped at the exact maximum.
+            auto histogram = jhoyt::asl::loadgen::hdr_histogram{k_highest_value, 3};
+            histogram.record(value);
+            histogram.record(value);
+            histogram.record(k_highest_value);
+
+            const auto equivalent = histogram.get_value_at_percentile(50.0);
+            CHECK(equivalent >= value);
+            CHECK((equivalent - value) * 1000 <= value);
+        }
+    }
+
+    SECTION("Values share a counter only within a sub-bucket")
+    {
+        // 10000 lies in the bucket of 8192..16383, whose sub-buckets are 8 wide: 10000..10007 share one.
+        auto histogram = jhoyt::asl::loadgen::hdr_histogram{k_highest_value, 3};
+        histogram.record(10000);
+        histogram.record(10007);
+        histogram.record(10008);
+        histogram.record(20000);
+
+        CHECK(histogram.get_value_at_percentile(25.0) == 10007);
+        CHECK(histogram.get_value_at_percentile(50.0) == 10007);
+        CHECK(histogram.get_value_at_percentile(75.0) == 10015);
+        CHECK(histogram.get_value_at_percentile(100.0) == 20000);
+    }
+
+    SECTION("Values outside the range are clamped")
+    {
+        auto histogram = jhoyt::asl::loadgen::hdr_histogram{k_highest_value, 3};
+        histogram.record(-5);
+        CHECK(histogram.get_max() == 0);
+        CHECK(histogram.get_value_at_percentile(100.0) == 0);
+
+        histogram.record(k_highest_value * 2);
+        CHECK(histogram.get_total_count() == 2);
+        CHECK(histogram.get_max() == k_highest_value);
+        CHECK(histogram.get_value_at_percentile(100.0) == k_highest_value);
+    }
+}
+
+TEST_CASE("HDR Histogram Percentiles")
+{
+    auto histogram = jhoyt::asl::loadgen::hdr_histogram{k_highest_value, 3};
+    for (auto value = std::int64_t{1}; value <= 1000; ++value)
+    {
+        histogram.record(value);
+    }
+
+    CHECK(histogram.get_value_at_percentile(50.0) == 500);
+    CHECK(histogram.get_value_at_percentile(90.0) == 900);
+    CHECK(histogram.get_value_at_percentile(99.0) == 990);
+
+    // Percentiles outside 0 to 100 are clamped.
+    CHECK(histogram.get_value_at_percentile(-1.0) == 1);
+    CHECK(histogram.get_value_at_percentile(101.0) == 1000);
+
+    histogram.reset();
+    CHECK(histogram.get_total_count() == 0);
+    CHECK(histogram.get_max() == 0);
+    CHECK(histogram.get_value_at_percentile(50.0) == 0);
+}
+
+TEST_CASE("HDR Histogram Merge")
+{
+    auto low = jhoyt::asl::loadgen::hdr_histogram{k_highest_value, 3};
+    auto high = jhoyt::asl::loadgen::hdr_histogram{k_highest_value, 3};
+    for (auto value = std::int64_t{1}; value <= 500; ++value)
+    {
+        low.record(value);
+        high.record(value + 500);
+    }
+
+    low.merge(high);
+    CHECK(low.get_total_count() == 1000);
+    CHECK(low.get_max() == 1000);
+    CHECK(low.get_value_at_percentile(50.0) == 500);
+    CHECK(low.get_value_at_percentile(75.0) == 750);
+
+    // The merged histogram is unchanged.
+    CHECK(high.get_total_count() == 500);
+    CHECK(high.get_value_at_percentile(0.0) == 501);
+
+    const auto coarser = jhoyt::asl::loadgen::hdr_histogram{k_highest_value, 2};
+    CHECK_THROWS_AS(low.merge(coarser), std::invalid_argument);
+
+    const auto shorter = jhoyt::asl::loadgen::hdr_histogram{1000, 3};
+    CHECK_THROWS_AS(low.merge(shorter), std::invalid_argument);
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/mpsc_queue.hpp>
+
+TEST_CASE("MPSC Queue Is FIFO And Bounded")
+{
+    auto queue = jhoyt::asl::mpsc_queue<int>{3};
+    CHECK(queue.get_capacity() == 4);
+    CHECK(queue.empty());
+
+    for (auto ix = 0; ix < 4; ++ix)
+    {
+        auto value = ix;
+        CHECK(queue.try_push(value));
+    }
+
+    auto extra = 4;
+    CHECK(!queue.try_push(extra));
+    CHECK(extra == 4);
+
+    auto value = -1;
+    for (auto ix = 0; ix < 4; ++ix)
+    {
+        REQUIRE(queue.try_pop(value));
+        CHECK(value == ix);
+    }
+
+    CHECK(!queue.try_pop(value));
+    CHECK(queue.empty());
+
+    CHECK(queue.try_push(extra));
+    REQUIRE(queue.try_pop(value));
+    CHECK(value == 4);
+}
+
+TEST_CASE("MPSC Queue Accepts Concurrent Producers")
+{
+    constexpr auto k_producers = 4;
+    constexpr auto k_count = 20000;
+    auto queue = jhoyt::asl::mpsc_queue<int>{64};
+
+    auto producers = std::vector<std::thread>{};
+    for (auto producer = 0; producer < k_producers; ++producer)
+    {
+        producers.emplace_back([&queue, producer] {
+            for (auto ix = 0; ix < k_count; ++ix)
+            {
+                auto value = producer * k_count + ix;
+                while (!queue.try_push(value))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Values from each producer must arrive in the order that producer pushed them.
+    auto next = std::array<int, k_producers>{};
+    auto in_order = true;
+    auto value = 0;
+    for (auto received = 0; received < k_producers * k_count;)
+    {
+        if (queue.try_pop(value))
+        {
+            const auto producer = value / k_count;
+            in_order = in_order && value % k_count == next[producer];
+            ++next[producer];
+            ++received;
+        }
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    CHECK(in_order);
+    CHECK(queue.empty());
+}
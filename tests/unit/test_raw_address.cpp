@@ -7,6 +7,12 @@
 #include <sys/un.h>
 #endif
 
+#include <array>
+#include <format>
+#include <functional>
+#include <string_view>
+#include <utility>
+
 #include <catch.hpp>
 
 #include <jhoyt/asl/address.hpp>
@@ -52,14 +58,6 @@ namespace
     }
 } // namespace
 
-namespace jhoyt::asl
-{
-    std::string to_string(const jhoyt::asl::address&)
-    {
-        return "address string";
-    }
-} // namespace jhoyt::asl
-
 TEST_CASE("Empty Raw Address")
 {
     const auto addr = jhoyt::asl::raw_address{};
@@ -69,12 +67,12 @@ TEST_CASE("Empty Raw Address")
 
 TEST_CASE("Raw Address from Address")
 {
-    CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = {}, .port = 0}});
+    CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "", .port = 0}});
     CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "malformed", .port = 0}});
     CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = ".127.0.1.1", .port = 0}});
     CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "::1", .port = 0}});
 
-    CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = {}, .port = 0}});
+    CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "", .port = 0}});
     CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "malformed", .port = 0}});
     CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = ".127.0.1.1", .port = 0}});
     CHECK_THROWS(jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "127.0.0.1", .port = 0}});
@@ -106,9 +104,22 @@ TEST_CASE("Raw Address from Bytes")
         jhoyt::asl::raw_address{std::span{reinterpret_cast<const char*>(&addr_storage), sizeof(addr_storage)}});
 
     addr_storage.ss_family = AF_INET;
-    addr_storage.ss_len = 10;
+    CHECK_THROWS(jhoyt::asl::raw_address{std::span{reinterpret_cast<const char*>(&addr_storage), 10}});
+    CHECK_THROWS(jhoyt::asl::raw_address{std::span{reinterpret_cast<const char*>(&addr_storage), 1}});
     CHECK_THROWS(
-        jhoyt::asl::raw_address{std::span{reinterpret_cast<const char*>(&addr_storage), sizeof(addr_storage)}});
+        jhoyt::asl::raw_address{std::span{reinterpret_cast<const char*>(&addr_storage), sizeof(addr_storage) + 1}});
+
+    // A span longer than the OS-level address of its family, like a whole sockaddr_storage, is cut down to it.
+    const auto storage_addr =
+        jhoyt::asl::raw_address{std::span{reinterpret_cast<const char*>(&addr_storage), sizeof(addr_storage)}};
+    CHECK(storage_addr.get_data().size() == sizeof(sockaddr_in));
+
+    // The unnamed address of a UNIX domain peer holds only the family.
+    addr_storage.ss_family = AF_UNIX;
+    const auto unnamed_addr =
+        jhoyt::asl::raw_address{std::span{reinterpret_cast<const char*>(&addr_storage), sizeof(sa_family_t)}};
+    CHECK(unnamed_addr.get_data().size() == sizeof(sa_family_t));
+    CHECK(jhoyt::asl::to_string(unnamed_addr) == "file://");
 
     auto good_raw_addr = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
     const auto good_raw_addr_data = good_raw_addr.get_data();
@@ -133,9 +144,8 @@ TEST_CASE("Raw Address Data")
         const auto addr_data = addr.get_data();
         CHECK(!is_zero(addr_data));
 
-        const auto& storage = *reinterpret_cast<const sockaddr_storage*>(addr_data.data());
-        CHECK(storage.ss_family == AF_INET);
-        CHECK(storage.ss_len == sizeof(sockaddr_in));
+        CHECK(addr_data.size() == sizeof(sockaddr_in));
+        CHECK(reinterpret_cast<const sockaddr*>(addr_data.data())->sa_family == AF_INET);
     }
 
     SECTION("IPv6 Raw Address Data")
@@ -144,9 +154,8 @@ TEST_CASE("Raw Address Data")
         const auto addr_data = addr.get_data();
         CHECK(!is_zero(addr_data));
 
-        const auto& storage = *reinterpret_cast<const sockaddr_storage*>(addr_data.data());
-        CHECK(storage.ss_family == AF_INET6);
-        CHECK(storage.ss_len == sizeof(sockaddr_in6));
+        CHECK(addr_data.size() == sizeof(sockaddr_in6));
+        CHECK(reinterpret_cast<const sockaddr*>(addr_data.data())->sa_family == AF_INET6);
     }
 
     SECTION("File Raw Address Data")
@@ -155,9 +164,8 @@ TEST_CASE("Raw Address Data")
         const auto addr_data = addr.get_data();
         CHECK(!is_zero(addr_data));
 
-        const auto& storage = *reinterpret_cast<const sockaddr_storage*>(addr_data.data());
-        CHECK(storage.ss_family == AF_UNIX);
-        CHECK(storage.ss_len == sizeof(sockaddr_un));
+        CHECK(addr_data.size() == sizeof(sockaddr_un));
+        CHECK(reinterpret_cast<const sockaddr*>(addr_data.data())->sa_family == AF_UNIX);
     }
 }
 
@@ -185,6 +193,16 @@ TEST_CASE("Raw Address to Address")
         CHECK(new_addr == ipv6_addr);
     }
 
+    SECTION("Scoped IPv6 Raw Address")
+    {
+        const auto ipv6_addr =
+            jhoyt::asl::address{jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 5555, .scope_id = 3}};
+        const auto raw_addr = jhoyt::asl::raw_address{ipv6_addr};
+        const auto new_addr = raw_addr.get_address();
+        CHECK(new_addr == ipv6_addr);
+        CHECK(jhoyt::asl::to_string(raw_addr) == "ipv6://fe80::1%3:5555");
+    }
+
     SECTION("File Raw Address")
     {
         const auto file_addr = jhoyt::asl::address{jhoyt::asl::file_address{.path = "./test.sock"}};
@@ -200,11 +218,118 @@ TEST_CASE("Raw Address to String")
     CHECK_THROWS(jhoyt::asl::to_string(addr_zero));
 
     const auto addr_ipv4 = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "127.0.0.1", .port = 5555}};
-    CHECK(jhoyt::asl::to_string(addr_ipv4) == "address string");
+    CHECK(jhoyt::asl::to_string(addr_ipv4) == "ipv4://127.0.0.1:5555");
 
     const auto addr_ipv6 = jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "::1", .port = 5555}};
-    CHECK(jhoyt::asl::to_string(addr_ipv6) == "address string");
+    CHECK(jhoyt::asl::to_string(addr_ipv6) == "ipv6://::1:5555");
 
     const auto addr_file = jhoyt::asl::raw_address{jhoyt::asl::file_address{.path = "./test.sock"}};
-    CHECK(jhoyt::asl::to_string(addr_file) == "address string");
-}
\ No newline at end of file
+    CHECK(jhoyt::asl::to_string(addr_file) == "file://./test.sock");
+}
+
+TEST_CASE("Raw Address std::format")
+{
+    const auto addr_zero = jhoyt::asl::raw_address{};
+    CHECK_THROWS(std::format("{}", addr_zero));
+
+    const auto addr_ipv4 = jhoyt::asl::raw_address{jhoyt::asl::ipv4_address{.host = "192.168.100.200", .port = 65535}};
+    CHECK(std::format("{}", addr_ipv4) == "ipv4://192.168.100.200:65535");
+
+    const auto addr_ipv6 = jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "2001:db8::1", .port = 0}};
+    CHECK(std::format("[{}]", addr_ipv6) == "[ipv6://2001:db8::1:0]");
+
+    const auto addr_file = jhoyt::asl::raw_address{jhoyt::asl::file_address{.path = "./test.sock"}};
+    CHECK(std::format("{}", addr_file) == "file://./test.sock");
+
+    SECTION("Fixed Buffer")
+    {
+        auto buf = std::array<char, 16>{};
+        const auto result = std::format_to_n(buf.data(), buf.size(), "{}", addr_ipv4);
+        CHECK(result.size == 28);
+        CHECK(std::string_view{buf.data(), buf.size()} == "ipv4://192.168.1");
+    }
+}
+
+TEST_CASE("Raw Address Ordering and Hashing")
+{
+    const auto make = [](const jhoyt::asl::address& addr) { return jhoyt::asl::raw_address{addr}; };
+    const auto hash = std::hash<jhoyt::asl::raw_address>{};
+
+    SECTION("Equality uses only the meaningful bytes")
+    {
+        // The padding (sin_zero) of the OS-level address differs between these two.
+        auto data = std::array<char, sizeof(sockaddr_in)>{};
+        const auto source = make(jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 80});
+        std::ranges::copy(source.get_data(), data.begin());
+        data.back() = 1;
+        const auto copy = jhoyt::asl::raw_address{data};
+
+        CHECK(copy == source);
+        CHECK(hash(copy) == hash(source));
+        CHECK(jhoyt::asl::raw_address{} == jhoyt::asl::raw_address{});
+    }
+
+    SECTION("Ordering")
+    {
+        CHECK(make(jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 80}) <
+              make(jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 81}));
+        CHECK(make(jhoyt::asl::ipv4_address{.host = "9.0.0.255", .port = 80}) <
+              make(jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 80}));
+        CHECK(make(jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 80}) <
+              make(jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 80, .scope_id = 2}));
+        CHECK(make(jhoyt::asl::file_address{.path = "a.sock"}) < make(jhoyt::asl::file_address{.path = "b.sock"}));
+        CHECK(make(jhoyt::asl::ipv4_address{.host = "10.0.0.1", .port = 80}) !=
+              make(jhoyt::asl::ipv6_address{.host = "::ffff:10.0.0.1", .port = 80}));
+    }
+
+    SECTION("Hash matches the generic address")
+    {
+        const auto ipv4_addr = jhoyt::asl::ipv4_address{.host = "192.168.1.20", .port = 5555};
+        CHECK(hash(make(ipv4_addr)) == std::hash<jhoyt::asl::ipv4_address>{}(ipv4_addr));
+
+        const auto ipv6_addr = jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 5555, .scope_id = 3};
+        CHECK(hash(make(ipv6_addr)) == std::hash<jhoyt::asl::ipv6_address>{}(ipv6_addr));
+
+        const auto file_addr = jhoyt::asl::file_address{.path = "./test.sock"};
+        CHECK(hash(make(file_addr)) == std::hash<jhoyt::asl::file_address>{}(file_addr));
+    }
+}
+
+TEST_CASE("Raw Address Copy and Move")
+{
+    // An IP address is stored without the unused rest of a sockaddr_storage.
+    static_assert(sizeof(jhoyt::asl::raw_address) < sizeof(sockaddr_storage) / 2);
+
+    const auto addr_ipv6 = jhoyt::asl::raw_address{jhoyt::asl::ipv6_address{.host = "fe80::1", .port = 80}};
+    const auto addr_file = jhoyt::asl::raw_address{jhoyt::asl::file_address{.path = "./test.sock"}};
+
+    SECTION("Copies are independent")
+    {
+        auto copy = addr_file;
+        CHECK(copy == addr_file);
+        CHECK(copy.get_data().data() != addr_file.get_data().data());
+        CHECK(is_equal(copy.get_data(), addr_file.get_data()));
+
+        copy = addr_ipv6;
+        CHECK(copy == addr_ipv6);
+        CHECK(jhoyt::asl::to_string(copy) == "ipv6://fe80::1:80");
+
+        copy = addr_file;
+        CHECK(jhoyt::asl::to_string(copy) == "file://./test.sock");
+    }
+
+    SECTION("Moved-from values are empty")
+    {
+        auto source = addr_file;
+        const auto moved = std::move(source);
+        CHECK(moved == addr_file);
+        CHECK(source.get_data().empty());
+        CHECK(source == jhoyt::asl::raw_address{});
+
+        source = addr_ipv6;
+        auto target = jhoyt::asl::raw_address{};
+        target = std::move(source);
+        CHECK(target == addr_ipv6);
+        CHECK(source.get_data().empty());
+    }
+}
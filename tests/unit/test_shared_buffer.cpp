@@ -0,0 +1,57 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <string_view>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/shared_buffer.hpp>
+
+namespace
+{
+
+    constexpr auto k_payload = std::string_view{"Hello, world"};
+
+    auto to_string_view(const std::span<const char> data)
+    {
+        return std::string_view{data.data(), data.size()};
+    }
+
+} // namespace
+
+TEST_CASE("Empty Shared Buffer")
+{
+    const auto buf = jhoyt::asl::shared_buffer{};
+    CHECK(!buf);
+    CHECK(buf.get_data().empty());
+    CHECK(buf.get_use_count() == 0);
+
+    const auto empty_data = jhoyt::asl::shared_buffer{std::span<const char>{}};
+    CHECK(!empty_data);
+}
+
+TEST_CASE("Shared Buffer Copies Share Data")
+{
+    auto buf = jhoyt::asl::shared_buffer{k_payload};
+    REQUIRE(buf);
+    CHECK(to_string_view(buf.get_data()) == k_payload);
+    CHECK(buf.get_data().data() != k_payload.data());
+    CHECK(buf.get_use_count() == 1);
+
+    {
+        const auto copy = buf;
+        CHECK(copy.get_data().data() == buf.get_data().data());
+        CHECK(buf.get_use_count() == 2);
+
+        auto assigned = jhoyt::asl::shared_buffer{};
+        assigned = copy;
+        CHECK(buf.get_use_count() == 3);
+    }
+
+    CHECK(buf.get_use_count() == 1);
+
+    auto moved = std::move(buf);
+    CHECK(!buf);
+    CHECK(moved.get_use_count() == 1);
+    CHECK(to_string_view(moved.get_data()) == k_payload);
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <thread>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/spsc_queue.hpp>
+
+TEST_CASE("SPSC Queue Capacity Is Rounded Up")
+{
+    const auto queue = jhoyt::asl::spsc_queue<int>{5};
+    CHECK(queue.get_capacity() == 8);
+    CHECK(queue.empty());
+}
+
+TEST_CASE("SPSC Queue Is FIFO And Bounded")
+{
+    auto queue = jhoyt::asl::spsc_queue<int>{4};
+    for (auto ix = 0; ix < 4; ++ix)
+    {
+        auto value = ix;
+        CHECK(queue.try_push(value));
+    }
+
+    auto extra = 4;
+    CHECK(!queue.try_push(extra));
+    CHECK(!queue.empty());
+
+    auto value = -1;
+    for (auto ix = 0; ix < 4; ++ix)
+    {
+        REQUIRE(queue.try_pop(value));
+        CHECK(value == ix);
+    }
+
+    CHECK(!queue.try_pop(value));
+    CHECK(queue.empty());
+
+    // Wrap around the end of the slots.
+    CHECK(queue.try_push(extra));
+    REQUIRE(queue.try_pop(value));
+    CHECK(value == 4);
+}
+
+TEST_CASE("SPSC Queue Transfers Between Threads")
+{
+    constexpr auto k_count = 100000;
+    auto queue = jhoyt::asl::spsc_queue<int>{64};
+
+    auto producer = std::thread{[&] {
+        for (auto ix = 0; ix < k_count; ++ix)
+        {
+            auto value = ix;
+            while (!queue.try_push(value))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    auto in_order = true;
+    auto value = 0;
+    for (auto expected = 0; expected < k_count;)
+    {
+        if (queue.try_pop(value))
+        {
+            in_order = in_order && value == expected;
+            ++expected;
+        }
+    }
+
+    producer.join();
+    CHECK(in_order);
+    CHECK(queue.empty());
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <coroutine>
+#include <stdexcept>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/task.hpp>
+
+namespace
+{
+
+    jhoyt::asl::task<int> add(const int a, const int b)
+    {
+        co_return a + b;
+    }
+
+    jhoyt::asl::task<int> add_twice(const int a, const int b)
+    {
+        const auto first = co_await add(a, b);
+        const auto second = co_await add(first, b);
+        co_return second;
+    }
+
+    jhoyt::asl::task<int> fail()
+    {
+        throw std::runtime_error{"task failed"};
+        co_return 0;
+    }
+
+    struct manual_event
+    {
+        std::coroutine_handle<> waiter;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(const std::coroutine_handle<> handle) noexcept
+        {
+            waiter = handle;
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+} // namespace
+
+TEST_CASE("Frame Pool Reuses Frames")
+{
+    auto* first = jhoyt::asl::allocate_frame(100);
+    jhoyt::asl::deallocate_frame(first, 100);
+
+    // Any size in the same size class reuses the released frame.
+    auto* second = jhoyt::asl::allocate_frame(120);
+    CHECK(second == first);
+    jhoyt::asl::deallocate_frame(second, 120);
+
+    auto* large = jhoyt::asl::allocate_frame(64 * 1024);
+    CHECK(large != nullptr);
+    jhoyt::asl::deallocate_frame(large, 64 * 1024);
+}
+
+TEST_CASE("Spawned Task")
+{
+    auto event = manual_event{};
+    auto result = 0;
+
+    jhoyt::asl::spawn([](manual_event& event, int& result) -> jhoyt::asl::task<> {
+        co_await event;
+        result = co_await add_twice(1, 2);
+    }(event, result));
+
+    REQUIRE(event.waiter);
+    CHECK(result == 0);
+
+    event.waiter.resume();
+    CHECK(result == 5);
+}
+
+TEST_CASE("Task Exception")
+{
+    auto event = manual_event{};
+    auto caught = false;
+
+    jhoyt::asl::spawn([](manual_event& event, bool& caught) -> jhoyt::asl::task<> {
+        co_await event;
+        try
+        {
+            co_await fail();
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+    }(event, caught));
+
+    event.waiter.resume();
+    CHECK(caught);
+}
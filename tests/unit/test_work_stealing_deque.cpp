@@ -0,0 +1,109 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <jhoyt/asl/work_stealing_deque.hpp>
+
+TEST_CASE("Work Stealing Deque Pops LIFO And Steals FIFO")
+{
+    auto deque = jhoyt::asl::work_stealing_deque<int>{4};
+    CHECK(deque.empty());
+    CHECK(!deque.pop());
+    CHECK(!deque.steal());
+
+    for (auto ix = 0; ix < 4; ++ix)
+    {
+        deque.push(ix);
+    }
+
+    CHECK(deque.get_size() == 4);
+    CHECK(deque.pop() == 3);
+    CHECK(deque.steal() == 0);
+    CHECK(deque.pop() == 2);
+    CHECK(deque.steal() == 1);
+    CHECK(!deque.pop());
+    CHECK(!deque.steal());
+    CHECK(deque.empty());
+}
+
+TEST_CASE("Work Stealing Deque Grows When Full")
+{
+    auto deque = jhoyt::asl::work_stealing_deque<int>{2};
+    for (auto ix = 0; ix < 100; ++ix)
+    {
+        deque.push(ix);
+    }
+
+    CHECK(deque.get_size() == 100);
+    for (auto ix = 0; ix < 50; ++ix)
+    {
+        CHECK(deque.steal() == ix);
+    }
+
+    for (auto ix = 99; ix >= 50; --ix)
+    {
+        CHECK(deque.pop() == ix);
+    }
+
+    CHECK(deque.empty());
+}
+
+TEST_CASE("Work Stealing Deque Hands Each Element To Exactly One Thread")
+{
+    constexpr auto k_thieves = 3;
+    constexpr auto k_count = 20000;
+    auto deque = jhoyt::asl::work_stealing_deque<int>{16};
+    auto seen = std::vector<std::atomic<int>>(k_count);
+    auto done = std::atomic<bool>{false};
+
+    auto thieves = std::vector<std::thread>{};
+    for (auto thief = 0; thief < k_thieves; ++thief)
+    {
+        thieves.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire) || !deque.empty())
+            {
+                if (const auto value = deque.steal())
+                {
+                    seen[*value].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // The owner interleaves pushes and pops so that it races the thieves for the last element.
+    for (auto ix = 0; ix < k_count; ++ix)
+    {
+        deque.push(ix);
+        if (ix % 3 == 0)
+        {
+            if (const auto value = deque.pop())
+            {
+                seen[*value].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves)
+    {
+        thief.join();
+    }
+
+    while (const auto value = deque.pop())
+    {
+        seen[*value].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto exactly_once = true;
+    for (const auto& count : seen)
+    {
+        exactly_once = exactly_once && count.load() == 1;
+    }
+
+    CHECK(exactly_once);
+}
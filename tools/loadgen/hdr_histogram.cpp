@@ -0,0 +1,137 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "hdr_histogram.hpp"
+
+namespace jhoyt::asl::loadgen
+{
+
+    hdr_histogram::hdr_histogram(const std::int64_t highest_trackable_value, const int significant_digits)
+        : highest_trackable_value_(highest_trackable_value)
+    {
+        if (significant_digits < 1 || significant_digits > 5)
+        {
+            throw std::invalid_argument{"histogram significant digits must be between 1 and 5"};
+        }
+
+        if (highest_trackable_value < 2)
+        {
+            throw std::invalid_argument{"histogram highest trackable value must be at least 2"};
+        }
+
+        // A value must be distinguishable from its neighbours to the requested precision within every bucket, which
+        // needs 2 * 10^digits linear sub-buckets (rounded up to a power of two).
+        const auto largest_single_unit = 2 * static_cast<std::int64_t>(std::pow(10, significant_digits));
+        const auto sub_bucket_count_magnitude = std::bit_width(static_cast<std::uint64_t>(largest_single_unit - 1));
+        sub_bucket_half_count_magnitude_ = sub_bucket_count_magnitude - 1;
+        sub_bucket_half_count_ = std::int64_t{1} << sub_bucket_half_count_magnitude_;
+        sub_bucket_mask_ = (std::int64_t{1} << sub_bucket_count_magnitude) - 1;
+
+        // The first bucket covers [0, sub_bucket_count); every further bucket doubles the range but only needs the
+        // upper half of its sub-buckets, as the lower half overlaps the previous bucket.
+        auto bucket_count = std::size_t{1};
+        auto smallest_untrackable_value = std::int64_t{1} << sub_bucket_count_magnitude;
+        while (smallest_untrackable_value <= highest_trackable_value)
+        {
+            if (smallest_untrackable_value > std::numeric_limits<std::int64_t>::max() / 2)
+            {
+                ++bucket_count;
+                break;
+            }
+
+            smallest_untrackable_value <<= 1;
+            ++bucket_count;
+        }
+
+        counts_.resize((bucket_count + 1) * static_cast<std::size_t>(sub_bucket_half_count_));
+    }
+
+    void hdr_histogram::record(std::int64_t value)
+    {
+        value = std::clamp(value, std::int64_t{0}, highest_trackable_value_);
+
+        ++counts_[get_index(value)];
+        ++total_count_;
+        max_ = std::max(max_, value);
+    }
+
+    void hdr_histogram::merge(const hdr_histogram& other)
+    {
+        if (other.counts_.size() != counts_.size() || other.sub_bucket_half_count_ != sub_bucket_half_count_)
+        {
+            throw std::invalid_argument{"cannot merge histograms with different ranges or precision"};
+        }
+
+        std::ranges::transform(counts_, other.counts_, counts_.begin(), std::plus<>{});
+        total_count_ += other.total_count_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    void hdr_histogram::reset()
+    {
+        std::ranges::fill(counts_, 0);
+        total_count_ = 0;
+        max_ = 0;
+    }
+
+    std::int64_t hdr_histogram::get_value_at_percentile(const double percentile) const
+    {
+        if (total_count_ == 0)
+        {
+            return 0;
+        }
+
+        const auto fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+        const auto target = std::max(std::int64_t{1}, static_cast<std::int64_t>(std::ceil(fraction * total_count_)));
+
+        auto running_count = std::int64_t{0};
+        for (auto ix = std::size_t{0}; ix < counts_.size(); ++ix)
+        {
+            running_count += counts_[ix];
+            if (running_count >= target)
+            {
+                return std::min(get_highest_value_at_index(ix), max_);
+            }
+        }
+
+        return max_;
+    }
+
+    std::size_t hdr_histogram::get_index(const std::int64_t value) const
+    {
+        // The bucket is given by the position of the highest set bit above the sub-bucket range, and the sub-bucket by
+        // the value shifted down into that range.
+        const auto bucket = static_cast<int>(std::bit_width(static_cast<std::uint64_t>(value | sub_bucket_mask_))) -
+                            (sub_bucket_half_count_magnitude_ + 1);
+        const auto sub_bucket = value >> bucket;
+        const auto index = (static_cast<std::int64_t>(bucket + 1) << sub_bucket_half_count_magnitude_) +
+                           (sub_bucket - sub_bucket_half_count_);
+
+        assert(index >= 0 && static_cast<std::size_t>(index) < counts_.size());
+        return static_cast<std::size_t>(index);
+    }
+
+    std::int64_t hdr_histogram::get_highest_value_at_index(const std::size_t index) const
+    {
+        auto bucket = static_cast<int>(index >> sub_bucket_half_count_magnitude_) - 1;
+        auto sub_bucket = static_cast<std::int64_t>(index & static_cast<std::size_t>(sub_bucket_half_count_ - 1)) +
+                          sub_bucket_half_count_;
+        if (bucket < 0)
+        {
+            sub_bucket -= sub_bucket_half_count_;
+            bucket = 0;
+        }
+
+        // Every value in [sub_bucket << bucket, (sub_bucket + 1) << bucket) is counted at this index.
+        return ((sub_bucket + 1) << bucket) - 1;
+    }
+
+} // namespace jhoyt::asl::loadgen
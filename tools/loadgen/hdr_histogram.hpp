@@ -0,0 +1,68 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jhoyt::asl::loadgen
+{
+
+    /// @brief Type that records a distribution of values with a fixed relative precision (an HDR histogram).
+    ///
+    /// Values are grouped into buckets covering successive powers of two, each split into the same number of linear
+    /// sub-buckets, so every recorded value is kept to the requested number of significant decimal digits while the
+    /// memory used only grows with the logarithm of the value range. Recording is a handful of integer operations and
+    /// never allocates, which makes it cheap enough to call for every request.
+    class hdr_histogram final
+    {
+    public:
+        /// @brief Construct a new histogram.
+        /// @param highest_trackable_value The largest value that can be recorded; larger values are clamped to it.
+        /// @param significant_digits The number of significant decimal digits to keep (1 to 5).
+        hdr_histogram(std::int64_t highest_trackable_value, int significant_digits);
+
+        /// @brief Record a single value; negative values are recorded as zero.
+        void record(std::int64_t value);
+
+        /// @brief Add every value recorded by another histogram to this one.
+        /// @param other A histogram constructed with the same highest trackable value and significant digits.
+        void merge(const hdr_histogram& other);
+
+        /// @brief Remove every recorded value.
+        void reset();
+
+        /// @brief Retrieve the number of recorded values.
+        [[nodiscard]] auto get_total_count() const
+        {
+            return total_count_;
+        }
+
+        /// @brief Retrieve the largest recorded value (exact rather than rounded to the histogram precision).
+        [[nodiscard]] auto get_max() const
+        {
+            return max_;
+        }
+
+        /// @brief Retrieve the value at or below which a percentage of the recorded values fall.
+        /// @param percentile The percentage, from 0 to 100.
+        /// @returns The highest value equivalent (within the histogram precision) to the value at the percentile, or
+        /// zero if nothing has been recorded.
+        [[nodiscard]] std::int64_t get_value_at_percentile(double percentile) const;
+
+    private:
+        int sub_bucket_half_count_magnitude_;
+        std::int64_t sub_bucket_half_count_;
+        std::int64_t sub_bucket_mask_;
+        std::int64_t highest_trackable_value_;
+        std::vector<std::int64_t> counts_;
+        std::int64_t total_count_ = 0;
+        std::int64_t max_ = 0;
+
+        [[nodiscard]] std::size_t get_index(std::int64_t value) const;
+        [[nodiscard]] std::int64_t get_highest_value_at_index(std::size_t index) const;
+    };
+
+} // namespace jhoyt::asl::loadgen
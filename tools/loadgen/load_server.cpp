@@ -0,0 +1,156 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <chrono>
+#include <stdexcept>
+
+#include "load_server.hpp"
+
+namespace
+{
+
+    /// Longest time the server blocks in the poller, which bounds how long it takes to notice the stop flag.
+    constexpr auto k_max_poll_timeout = std::chrono::milliseconds{100};
+
+    constexpr auto k_listen_backlog = 1024;
+
+    /// Initial receive buffer size of a connection; it grows when a larger frame arrives.
+    constexpr auto k_recv_buffer_size = std::size_t{16 * 1024};
+
+} // namespace
+
+namespace jhoyt::asl::loadgen
+{
+
+    load_server::load_server(const raw_address& address, const socket_domain domain, const protocol proto)
+        : proto_(proto)
+    {
+        listener_.open(domain, socket_type::stream);
+        listener_.set_reuse_address_option(true);
+        listener_.bind(address);
+        listener_.listen(k_listen_backlog);
+
+        poller_.add_socket(listener_.get_id(), poller::poll_type::read);
+    }
+
+    void load_server::run(const std::atomic<bool>& stopping)
+    {
+        while (!stopping.load(std::memory_order_relaxed))
+        {
+            for (const auto& result : poller_.poll(k_max_poll_timeout))
+            {
+                if (result.id == listener_.get_id())
+                {
+                    accept_all();
+                    continue;
+                }
+
+                // A connection can be reported as both readable and writable, and may be closed by the first.
+                const auto it = connections_.find(result.id);
+                if (it == connections_.end())
+                {
+                    continue;
+                }
+
+                auto& conn = it->second;
+                const auto open =
+                    result.status == poller::poll_status::ready_to_write ? flush(conn) : on_readable(conn);
+                if (!open)
+                {
+                    close(result.id);
+                }
+            }
+        }
+    }
+
+    void load_server::accept_all()
+    {
+        auto sock = socket{};
+        auto address = raw_address{};
+        while (listener_.accept(sock, address))
+        {
+            const auto id = sock.get_id();
+            connections_.emplace(id, connection{std::move(sock), recv_buffer{k_recv_buffer_size}, {}});
+            poller_.add_socket(id, poller::poll_type::read);
+        }
+    }
+
+    bool load_server::on_readable(connection& conn)
+    {
+        while (true)
+        {
+            const auto [status, count] = conn.sock.recv(conn.in.get_writable(k_recv_buffer_size));
+            if (status == socket::transfer_status::blocked)
+            {
+                break;
+            }
+
+            if (status == socket::transfer_status::disconnected)
+            {
+                return false;
+            }
+
+            conn.in.commit(count);
+        }
+
+        if (proto_ == protocol::echo)
+        {
+            if (const auto data = conn.in.get_readable(); !data.empty())
+            {
+                conn.out.push(shared_buffer{data});
+                conn.in.consume(data.size());
+            }
+
+            return flush(conn);
+        }
+
+        // The reply frame has the same header and payload as the request, so the whole frame is sent back.
+        const auto rpc = rpc_framer{};
+        while (true)
+        {
+            const auto data = conn.in.get_readable();
+            const auto frame = rpc.next(data);
+            if (frame.status == frame_status::incomplete)
+            {
+                break;
+            }
+
+            if (frame.status != frame_status::complete)
+            {
+                return false;
+            }
+
+            conn.out.push(shared_buffer{data.first(frame.size)});
+            conn.in.consume(frame.size);
+        }
+
+        return flush(conn);
+    }
+
+    bool load_server::flush(connection& conn)
+    {
+        const auto status = conn.out.flush(conn.sock);
+        if (status == socket::transfer_status::disconnected)
+        {
+            return false;
+        }
+
+        // Only ask the poller about write space while replies are still queued.
+        const auto blocked = status == socket::transfer_status::blocked;
+        if (blocked != conn.polling_write)
+        {
+            poller_.update_socket(conn.sock.get_id(),
+                                  blocked ? poller::poll_type::read_write : poller::poll_type::read);
+            conn.polling_write = blocked;
+        }
+
+        return true;
+    }
+
+    void load_server::close(const socket_id id)
+    {
+        poller_.remove_socket(id);
+        connections_.erase(id);
+    }
+
+} // namespace jhoyt::asl::loadgen
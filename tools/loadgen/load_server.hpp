@@ -0,0 +1,62 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <atomic>
+#include <unordered_map>
+
+#include <jhoyt/asl/poller.hpp>
+#include <jhoyt/asl/raw_address.hpp>
+#include <jhoyt/asl/recv_buffer.hpp>
+#include <jhoyt/asl/send_queue.hpp>
+#include <jhoyt/asl/socket.hpp>
+#include <jhoyt/asl/socket_domain.hpp>
+
+#include "protocol.hpp"
+
+namespace jhoyt::asl::loadgen
+{
+
+    /// @brief Type that implements a single-threaded echo or framed-RPC server to generate load against.
+    ///
+    /// For protocol::echo every received byte is sent straight back. For protocol::framed each complete frame is
+    /// answered with a frame carrying the same payload, so the server has to decode the stream as a real RPC server
+    /// would.
+    class load_server final
+    {
+    public:
+        /// @brief Construct a new server and start listening.
+        /// @param address The address to listen on.
+        /// @param domain The socket domain of the address.
+        /// @param proto The protocol to serve.
+        load_server(const raw_address& address, socket_domain domain, protocol proto);
+
+        load_server(const load_server&) = delete;
+        load_server& operator=(const load_server&) = delete;
+
+        /// @brief Serve connections on the calling thread until the stop flag is set.
+        /// @param stopping Flag that is set once the server should stop.
+        void run(const std::atomic<bool>& stopping);
+
+    private:
+        struct connection
+        {
+            socket sock;
+            recv_buffer in;
+            send_queue out;
+            bool polling_write = false;
+        };
+
+        protocol proto_;
+        socket listener_;
+        poller poller_;
+        std::unordered_map<socket_id, connection> connections_;
+
+        void accept_all();
+        bool on_readable(connection& conn);
+        bool flush(connection& conn);
+        void close(socket_id id);
+    };
+
+} // namespace jhoyt::asl::loadgen
@@ -0,0 +1,250 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "load_worker.hpp"
+
+namespace
+{
+
+    /// Longest time a worker blocks in the poller, which bounds how long it takes to notice the stop flag.
+    constexpr auto k_max_poll_timeout = std::chrono::milliseconds{10};
+
+} // namespace
+
+namespace jhoyt::asl::loadgen
+{
+
+    load_worker::load_worker(const load_worker_options& options, const std::atomic<bool>& stopping)
+        : options_(options), stopping_(stopping), request_(make_request(options.proto, options.payload_size)),
+          histogram_(k_max_latency.count(), 3)
+    {
+        if (options_.connections == 0)
+        {
+            throw std::invalid_argument{"a load worker needs at least one connection"};
+        }
+
+        if (options_.mode == load_mode::open_loop && options_.rate <= 0)
+        {
+            throw std::invalid_argument{"an open loop load worker needs a positive request rate"};
+        }
+    }
+
+    load_worker::~load_worker()
+    {
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+    void load_worker::connect(const std::chrono::milliseconds timeout)
+    {
+        const auto request_size = request_.get_data().size();
+
+        connections_.reserve(options_.connections);
+        for (auto ix = std::size_t{0}; ix < options_.connections; ++ix)
+        {
+            auto& conn = connections_.emplace_back(connection{{}, recv_buffer{request_size}, {}, {}});
+            conn.sock.open(options_.domain, socket_type::stream);
+            index_.emplace(conn.sock.get_id(), ix);
+
+            if (conn.sock.connect(options_.address) == socket::connect_status::connected)
+            {
+                poller_.add_socket(conn.sock.get_id(), poller::poll_type::read);
+                idle_.push_back(ix);
+            }
+            else
+            {
+                poller_.add_socket(conn.sock.get_id(), poller::poll_type::connect);
+            }
+        }
+
+        const auto end_time = clock::now() + timeout;
+        while (idle_.size() < connections_.size())
+        {
+            if (clock::now() > end_time)
+            {
+                throw std::runtime_error{"timed out connecting to the server"};
+            }
+
+            for (const auto& result : poller_.poll(k_max_poll_timeout))
+            {
+                if (result.status != poller::poll_status::connection_succeeded)
+                {
+                    throw std::runtime_error{"failed to connect to the server"};
+                }
+
+                poller_.update_socket(result.id, poller::poll_type::read);
+                idle_.push_back(index_.at(result.id));
+            }
+        }
+    }
+
+    void load_worker::start(const clock::time_point start_time)
+    {
+        start_time_ = start_time;
+        thread_ = std::thread{[this] {
+            try
+            {
+                run();
+            }
+            catch (...)
+            {
+                error_ = std::current_exception();
+            }
+        }};
+    }
+
+    void load_worker::join()
+    {
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+
+        if (error_)
+        {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    void load_worker::run()
+    {
+        const auto open_loop = options_.mode == load_mode::open_loop;
+        auto next_due = start_time_ + options_.start_offset;
+
+        while (!stopping_.load(std::memory_order_relaxed))
+        {
+            const auto now = clock::now();
+            send_requests(now, next_due);
+
+            // An open loop worker wakes up for the next request that is due. The poller has millisecond resolution and
+            // rounds down, so shorter gaps turn into a busy poll, which keeps the send times accurate.
+            auto timeout = std::chrono::nanoseconds{k_max_poll_timeout};
+            if (open_loop)
+            {
+                const auto until_due = std::chrono::nanoseconds{next_due - now};
+                timeout = std::clamp(until_due, std::chrono::nanoseconds::zero(), timeout);
+            }
+
+            for (const auto& result : poller_.poll(timeout))
+            {
+                auto& conn = connections_[index_.at(result.id)];
+                if (result.status == poller::poll_status::ready_to_write)
+                {
+                    on_writable(conn);
+                }
+                else
+                {
+                    on_readable(conn);
+                }
+            }
+        }
+    }
+
+    void load_worker::send_requests(const clock::time_point now, clock::time_point& next_due)
+    {
+        if (options_.mode == load_mode::closed_loop)
+        {
+            while (!idle_.empty())
+            {
+                const auto ix = idle_.back();
+                idle_.pop_back();
+                begin_request(connections_[ix], now);
+            }
+
+            return;
+        }
+
+        const auto interval =
+            std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>{1.0 / options_.rate});
+        for (; next_due <= now; next_due += interval)
+        {
+            due_.push_back(next_due);
+        }
+
+        while (!idle_.empty() && !due_.empty())
+        {
+            const auto ix = idle_.back();
+            idle_.pop_back();
+            begin_request(connections_[ix], due_.front());
+            due_.pop_front();
+        }
+    }
+
+    void load_worker::begin_request(connection& conn, const clock::time_point start_time)
+    {
+        conn.busy = true;
+        conn.start_time = start_time;
+        conn.out.push(request_);
+        flush(conn);
+    }
+
+    void load_worker::on_writable(connection& conn)
+    {
+        flush(conn);
+    }
+
+    void load_worker::on_readable(connection& conn)
+    {
+        const auto request_size = request_.get_data().size();
+        while (true)
+        {
+            const auto [status, count] = conn.sock.recv(conn.in.get_writable(request_size));
+            if (status == socket::transfer_status::blocked)
+            {
+                return;
+            }
+
+            if (status == socket::transfer_status::disconnected)
+            {
+                throw std::runtime_error{"server closed a connection"};
+            }
+
+            conn.in.commit(count);
+
+            const auto reply_size = find_reply(options_.proto, conn.in.get_readable(), request_size);
+            if (reply_size == 0)
+            {
+                continue;
+            }
+
+            if (!conn.busy || conn.in.get_readable().size() != reply_size)
+            {
+                throw std::runtime_error{"server sent more than one reply per request"};
+            }
+
+            const auto latency = clock::now() - conn.start_time;
+            histogram_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+            completed_.fetch_add(1, std::memory_order_relaxed);
+
+            conn.in.consume(reply_size);
+            conn.busy = false;
+            idle_.push_back(index_.at(conn.sock.get_id()));
+            return;
+        }
+    }
+
+    void load_worker::flush(connection& conn)
+    {
+        const auto status = conn.out.flush(conn.sock);
+        if (status == socket::transfer_status::disconnected)
+        {
+            throw std::runtime_error{"server closed a connection"};
+        }
+
+        // Only ask the poller about write space while part of a request is still queued.
+        const auto blocked = status == socket::transfer_status::blocked;
+        if (blocked != conn.polling_write)
+        {
+            poller_.update_socket(conn.sock.get_id(),
+                                  blocked ? poller::poll_type::read_write : poller::poll_type::read);
+            conn.polling_write = blocked;
+        }
+    }
+
+} // namespace jhoyt::asl::loadgen
@@ -0,0 +1,145 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <jhoyt/asl/poller.hpp>
+#include <jhoyt/asl/raw_address.hpp>
+#include <jhoyt/asl/recv_buffer.hpp>
+#include <jhoyt/asl/send_queue.hpp>
+#include <jhoyt/asl/shared_buffer.hpp>
+#include <jhoyt/asl/socket.hpp>
+#include <jhoyt/asl/socket_domain.hpp>
+
+#include "hdr_histogram.hpp"
+#include "protocol.hpp"
+
+namespace jhoyt::asl::loadgen
+{
+
+    using clock = std::chrono::steady_clock;
+
+    /// @brief Enumeration that defines when a load worker sends its requests.
+    enum class load_mode
+    {
+        /// @brief Every connection sends its next request as soon as the reply to the previous one has arrived, so the
+        /// concurrency is fixed and the request rate follows the server.
+        closed_loop,
+
+        /// @brief Requests are due at a fixed rate whatever the server does. A request that is due while every
+        /// connection is busy waits for one to become free, and its latency is measured from when it was due, so a
+        /// slow server is not hidden by the generator holding back requests (coordinated omission).
+        open_loop
+    };
+
+    /// @brief Type that holds the settings of a single load worker.
+    struct load_worker_options
+    {
+        raw_address address;
+        socket_domain domain = socket_domain::ipv4;
+        protocol proto = protocol::echo;
+        load_mode mode = load_mode::closed_loop;
+        std::size_t connections = 1;
+        std::size_t payload_size = 64;
+
+        /// @brief Requests per second sent by this worker (open loop only).
+        double rate = 0;
+
+        /// @brief Delay before the first request of this worker (open loop only), so that workers sharing a rate do not
+        /// all send at the same instant.
+        std::chrono::nanoseconds start_offset{0};
+    };
+
+    /// @brief Type that runs a set of connections on its own thread and records the latency of every request.
+    ///
+    /// A worker owns its connections, poller and histogram; nothing is shared with other workers apart from the stop
+    /// flag and the completed request counter, which is read while the worker runs to report progress.
+    class load_worker final
+    {
+    public:
+        /// @brief The largest latency that can be recorded; longer requests are recorded as this value.
+        static constexpr auto k_max_latency = std::chrono::nanoseconds{std::chrono::minutes{1}};
+
+        /// @brief Construct a new worker.
+        /// @param options The worker settings.
+        /// @param stopping Flag that is set once the worker should stop sending requests.
+        load_worker(const load_worker_options& options, const std::atomic<bool>& stopping);
+        ~load_worker();
+
+        load_worker(const load_worker&) = delete;
+        load_worker& operator=(const load_worker&) = delete;
+
+        /// @brief Open and connect every connection of the worker, waiting until they have all been established.
+        /// @param timeout The longest time to wait for the connections.
+        void connect(std::chrono::milliseconds timeout);
+
+        /// @brief Start sending requests on the worker's thread.
+        /// @param start_time The time the first open loop request is due.
+        void start(clock::time_point start_time);
+
+        /// @brief Wait for the worker's thread to finish, rethrowing any exception that ended it early.
+        void join();
+
+        /// @brief Retrieve the number of requests that have completed so far; safe to call while the worker runs.
+        [[nodiscard]] std::uint64_t get_completed() const
+        {
+            return completed_.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Retrieve the latency histogram (in nanoseconds); only valid after join.
+        [[nodiscard]] const hdr_histogram& get_histogram() const
+        {
+            return histogram_;
+        }
+
+        /// @brief Retrieve the number of open loop requests that were due but still waiting for a free connection when
+        /// the worker stopped; only valid after join.
+        [[nodiscard]] std::size_t get_backlog() const
+        {
+            return due_.size();
+        }
+
+    private:
+        struct connection
+        {
+            socket sock;
+            recv_buffer in;
+            send_queue out;
+            clock::time_point start_time;
+            bool busy = false;
+            bool polling_write = false;
+        };
+
+        load_worker_options options_;
+        const std::atomic<bool>& stopping_;
+        shared_buffer request_;
+        poller poller_;
+        std::vector<connection> connections_;
+        std::unordered_map<socket_id, std::size_t> index_;
+        std::vector<std::size_t> idle_;
+        std::deque<clock::time_point> due_;
+        hdr_histogram histogram_;
+        std::atomic<std::uint64_t> completed_ = 0;
+        std::thread thread_;
+        std::exception_ptr error_;
+        clock::time_point start_time_;
+
+        void run();
+        void send_requests(clock::time_point now, clock::time_point& next_due);
+        void begin_request(connection& conn, clock::time_point start_time);
+        void on_writable(connection& conn);
+        void on_readable(connection& conn);
+        void flush(connection& conn);
+    };
+
+} // namespace jhoyt::asl::loadgen
@@ -0,0 +1,296 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <jhoyt/asl/address.hpp>
+
+#include "hdr_histogram.hpp"
+#include "load_server.hpp"
+#include "load_worker.hpp"
+
+namespace
+{
+    using namespace jhoyt::asl;
+    using namespace jhoyt::asl::loadgen;
+
+    constexpr auto k_connect_timeout = std::chrono::seconds{5};
+
+    /// Delay between connecting the workers and the first request, so every worker thread is running when load starts.
+    constexpr auto k_start_delay = std::chrono::milliseconds{10};
+
+    std::atomic<bool> stopping = false;
+
+    extern "C" void on_stop_signal(int)
+    {
+        stopping.store(true, std::memory_order_relaxed);
+    }
+
+    struct options
+    {
+        bool serve = false;
+        std::string host = "127.0.0.1";
+        std::uint16_t port = 5555;
+        protocol proto = protocol::echo;
+        load_mode mode = load_mode::closed_loop;
+        std::size_t connections = 16;
+        std::size_t threads = 1;
+        double rate = 0;
+        std::chrono::seconds duration{10};
+        std::size_t payload_size = 64;
+    };
+
+    void print_usage(const char* name)
+    {
+        std::cerr << "usage: " << name << " [options]\n"
+                  << "\n"
+                  << "  --serve                 run an echo or framed-RPC server until interrupted\n"
+                  << "  --host <address>        server address (default 127.0.0.1)\n"
+                  << "  --port <port>           server port (default 5555)\n"
+                  << "  --protocol echo|framed  request protocol (default echo)\n"
+                  << "  --mode closed|open      closed loop (fixed concurrency) or open loop (fixed rate)\n"
+                  << "  --connections <count>   total number of connections (default 16)\n"
+                  << "  --threads <count>       number of worker threads (default 1)\n"
+                  << "  --rate <requests/s>     total request rate for open loop mode\n"
+                  << "  --duration <seconds>    length of the run (default 10)\n"
+                  << "  --size <bytes>          request payload size (default 64)\n";
+    }
+
+    options parse_options(const int argc, char** argv)
+    {
+        auto result = options{};
+        for (auto ix = 1; ix < argc; ++ix)
+        {
+            const auto arg = std::string{argv[ix]};
+            if (arg == "--serve")
+            {
+                result.serve = true;
+                continue;
+            }
+
+            if (ix + 1 == argc)
+            {
+                throw std::invalid_argument{"missing value for " + arg};
+            }
+
+            const auto value = std::string{argv[++ix]};
+            if (arg == "--host")
+            {
+                result.host = value;
+            }
+            else if (arg == "--port")
+            {
+                result.port = static_cast<std::uint16_t>(std::stoul(value));
+            }
+            else if (arg == "--protocol" && (value == "echo" || value == "framed"))
+            {
+                result.proto = value == "echo" ? protocol::echo : protocol::framed;
+            }
+            else if (arg == "--mode" && (value == "closed" || value == "open"))
+            {
+                result.mode = value == "closed" ? load_mode::closed_loop : load_mode::open_loop;
+            }
+            else if (arg == "--connections")
+            {
+                result.connections = std::stoul(value);
+            }
+            else if (arg == "--threads")
+            {
+                result.threads = std::stoul(value);
+            }
+            else if (arg == "--rate")
+            {
+                result.rate = std::stod(value);
+            }
+            else if (arg == "--duration")
+            {
+                result.duration = std::chrono::seconds{std::stoul(value)};
+            }
+            else if (arg == "--size")
+            {
+                result.payload_size = std::stoul(value);
+            }
+            else
+            {
+                throw std::invalid_argument{"unknown option " + arg + " " + value};
+            }
+        }
+
+        if (result.threads == 0 || result.connections < result.threads)
+        {
+            throw std::invalid_argument{"there must be at least one thread and one connection per thread"};
+        }
+
+        if (result.mode == load_mode::open_loop && result.rate <= 0)
+        {
+            throw std::invalid_argument{"open loop mode needs a positive --rate"};
+        }
+
+        return result;
+    }
+
+    raw_address make_address(const options& opts)
+    {
+        if (opts.host.find(':') != std::string::npos)
+        {
+            return raw_address{ipv6_address{.host = ipv6_host{opts.host}, .port = opts.port}};
+        }
+
+        return raw_address{ipv4_address{.host = ipv4_host{opts.host}, .port = opts.port}};
+    }
+
+    socket_domain get_domain(const options& opts)
+    {
+        return opts.host.find(':') != std::string::npos ? socket_domain::ipv6 : socket_domain::ipv4;
+    }
+
+    int serve(const options& opts)
+    {
+        auto server = load_server{make_address(opts), get_domain(opts), opts.proto};
+
+        std::cout << "serving " << (opts.proto == protocol::echo ? "echo" : "framed") << " on " << opts.host << ":"
+                  << opts.port << std::endl;
+        server.run(stopping);
+        return 0;
+    }
+
+    void print_latency(const char* label, const std::int64_t nanoseconds)
+    {
+        std::cout << "  " << std::left << std::setw(8) << label << std::right << std::setw(12) << std::fixed
+                  << std::setprecision(1) << static_cast<double>(nanoseconds) / 1000.0 << " us\n";
+    }
+
+    int generate_load(const options& opts)
+    {
+        // Connections and the request rate are split evenly across the workers, and the open loop workers are
+        // staggered so that together they send at evenly spaced times.
+        auto workers = std::vector<std::unique_ptr<load_worker>>{};
+        for (auto ix = std::size_t{0}; ix < opts.threads; ++ix)
+        {
+            auto worker_options = load_worker_options{};
+            worker_options.address = make_address(opts);
+            worker_options.domain = get_domain(opts);
+            worker_options.proto = opts.proto;
+            worker_options.mode = opts.mode;
+            worker_options.connections = opts.connections / opts.threads + (ix < opts.connections % opts.threads);
+            worker_options.payload_size = opts.payload_size;
+            worker_options.rate = opts.rate / static_cast<double>(opts.threads);
+            if (opts.mode == load_mode::open_loop)
+            {
+                worker_options.start_offset = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::duration<double>{static_cast<double>(ix) / opts.rate});
+            }
+
+            workers.push_back(std::make_unique<load_worker>(worker_options, stopping));
+            workers.back()->connect(k_connect_timeout);
+        }
+
+        std::cout << (opts.mode == load_mode::closed_loop ? "closed" : "open") << " loop, "
+                  << (opts.proto == protocol::echo ? "echo" : "framed") << " to " << opts.host << ":" << opts.port
+                  << ", " << opts.connections << " connections on " << opts.threads << " threads, "
+                  << opts.payload_size << " byte payload";
+        if (opts.mode == load_mode::open_loop)
+        {
+            std::cout << ", " << opts.rate << " requests/s";
+        }
+        std::cout << "\n\n  second  requests/s\n";
+
+        const auto start_time = clock::now() + k_start_delay;
+        for (const auto& w : workers)
+        {
+            w->start(start_time);
+        }
+
+        // Report the throughput of every second while the workers run.
+        auto last_completed = std::uint64_t{0};
+        for (auto second = 1; second <= opts.duration.count() && !stopping.load(std::memory_order_relaxed); ++second)
+        {
+            std::this_thread::sleep_until(start_time + std::chrono::seconds{second});
+
+            auto completed = std::uint64_t{0};
+            for (const auto& w : workers)
+            {
+                completed += w->get_completed();
+            }
+
+            std::cout << "  " << std::setw(6) << second << "  " << std::setw(10) << completed - last_completed << "\n";
+            last_completed = completed;
+        }
+
+        stopping.store(true, std::memory_order_relaxed);
+        const auto elapsed = std::chrono::duration<double>{clock::now() - start_time};
+
+        auto histogram = hdr_histogram{load_worker::k_max_latency.count(), 3};
+        auto backlog = std::size_t{0};
+        for (const auto& w : workers)
+        {
+            w->join();
+            histogram.merge(w->get_histogram());
+            backlog += w->get_backlog();
+        }
+
+        std::cout << "\n  requests " << std::setw(12) << histogram.get_total_count() << "\n"
+                  << "  rate     " << std::setw(12) << std::fixed << std::setprecision(1)
+                  << static_cast<double>(histogram.get_total_count()) / elapsed.count() << " requests/s\n";
+        print_latency("p50", histogram.get_value_at_percentile(50.0));
+        print_latency("p99", histogram.get_value_at_percentile(99.0));
+        print_latency("p99.9", histogram.get_value_at_percentile(99.9));
+        print_latency("max", histogram.get_max());
+
+        // Requests that never got a connection mean the server could not keep up with the rate.
+        if (opts.mode == load_mode::open_loop)
+        {
+            std::cout << "  backlog  " << std::setw(12) << backlog << " requests due but not sent\n";
+        }
+
+        return 0;
+    }
+
+} // namespace
+
+/// Generates closed or open loop load against an echo or framed-RPC server (see print_usage for the options), or with
+/// --serve runs such a server. Latencies are recorded in HDR histograms; open loop latencies are measured from when
+/// each request was due, so they include any time spent waiting for a free connection.
+int main(const int argc, char** argv)
+{
+    auto opts = options{};
+    try
+    {
+        opts = parse_options(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << argv[0] << ": " << e.what() << "\n";
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, on_stop_signal);
+    std::signal(SIGTERM, on_stop_signal);
+#if !defined(_WIN32)
+    // A peer that closes its connection mid-run must fail the send rather than kill the process.
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+    try
+    {
+        return opts.serve ? serve(opts) : generate_load(opts);
+    }
+    catch (const std::exception& e)
+    {
+        stopping.store(true, std::memory_order_relaxed);
+        std::cerr << argv[0] << ": " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2025-present, Jason Hoyt
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <jhoyt/asl/framer.hpp>
+#include <jhoyt/asl/shared_buffer.hpp>
+
+namespace jhoyt::asl::loadgen
+{
+
+    /// @brief Enumeration that defines what the load generator sends and how the server replies.
+    enum class protocol
+    {
+        /// @brief Requests are raw bytes and the server sends every received byte straight back.
+        echo,
+
+        /// @brief Requests are length-prefixed frames (a big-endian u32 length) and the server replies to each
+        /// complete frame with a frame carrying the same payload.
+        framed
+    };
+
+    using rpc_framer = framer<u32_be_header>;
+
+    /// @brief Build the bytes of a single request.
+    /// @param proto The protocol to build the request for.
+    /// @param payload_size The number of payload bytes (not counting the frame header).
+    /// @returns Buffer holding the request; it is queued by reference for every request, so it is built only once.
+    inline shared_buffer make_request(const protocol proto, const std::size_t payload_size)
+    {
+        auto header = std::array<char, u32_be_header::k_max_size>{};
+        const auto header_size = proto == protocol::framed ? rpc_framer::encode_header(payload_size, header) : 0;
+
+        auto data = std::vector<char>(header.begin(), header.begin() + header_size);
+        data.resize(header_size + payload_size, 'x');
+        return shared_buffer{data};
+    }
+
+    /// @brief Find a complete reply at the front of the received bytes.
+    /// @param proto The protocol used by the connection.
+    /// @param data The bytes received since the request was sent.
+    /// @param request_size The total size of the request, which is also the size of its reply.
+    /// @returns The size of the reply, or zero if it has not been received completely yet.
+    inline std::size_t find_reply(const protocol proto,
+                                  const std::span<const char> data,
+                                  const std::size_t request_size)
+    {
+        if (proto == protocol::echo)
+        {
+            return data.size() >= request_size ? request_size : 0;
+        }
+
+        const auto frame = rpc_framer{}.next(data);
+        if (frame.status == frame_status::too_large || frame.status == frame_status::malformed)
+        {
+            throw std::runtime_error{"server replied with an invalid frame"};
+        }
+
+        return frame.status == frame_status::complete ? frame.size : 0;
+    }
+
+} // namespace jhoyt::asl::loadgen